@@ -89,7 +89,7 @@ public:
 			    size_t        &rank,
 			    Element       &det,
 			    bool           compute_L = true) const
-		{ return echelonize (A, P, rank, det, typename DefaultPivotStrategy<Ring, Modules, typename Matrix::Row>::Strategy (ctx), compute_L); }
+		{ return echelonize (A, P, rank, det, typename DefaultIndexedPivotStrategy<Ring, Modules, typename Matrix::Row>::Strategy (ctx), compute_L); }
 
 	/** Compute the non-reduced row-echelon form of a matrix using
 	 * the pivot-strategy provided
@@ -144,7 +144,7 @@ public:
 				     size_t        &rank,
 				     Element       &det,
 				     bool           compute_L = false) const
-		{ return echelonize_reduced (A, L, P, rank, det, typename DefaultPivotStrategy<Ring, Modules, typename Matrix1::Row>::Strategy (ctx), compute_L); }
+		{ return echelonize_reduced (A, L, P, rank, det, typename DefaultIndexedPivotStrategy<Ring, Modules, typename Matrix1::Row>::Strategy (ctx), compute_L); }
 
 	/** Compute the reduced row-echelon form of a matrix using the
 	 * pivot-strategy provided
@@ -198,7 +198,7 @@ public:
 		      Permutation   &Q,
 		      size_t        &rank,
 		      Element       &det) const
-		{ return pluq (A, P, Q, rank, det, typename DefaultPivotStrategy<Ring, Modules, typename Matrix::Row>::Strategy (ctx)); }
+		{ return pluq (A, P, Q, rank, det, typename DefaultIndexedPivotStrategy<Ring, Modules, typename Matrix::Row>::Strategy (ctx)); }
 
 	template <class Matrix, class PivotStrategy>
 	Matrix &pluq (Matrix        &A,
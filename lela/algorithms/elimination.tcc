@@ -22,6 +22,7 @@
 #include "lela/blas/level1.h"
 #include "lela/blas/level3.h"
 #include "lela/vector/stream.h"
+#include "lela/util/profile.h"
 
 #ifdef DETAILED_PROFILE
 #  define TIMER_DECLARE(part) LELA::UserTimer part##_timer; double part##_time = 0.0;
@@ -53,6 +54,8 @@ Matrix &Elimination<Ring, Modules>::echelonize (Matrix        &A,
 						PivotStrategy  PS,
 						bool           compute_L) const
 {
+	LELA_PROFILE ("Elimination::echelonize");
+
 	commentator.start ("Echelonize (elimination)", __FUNCTION__, A.rowdim () / PROGRESS_STEP);
 
 	// std::ostream &report = commentator.report (Commentator::LEVEL_UNIMPORTANT, INTERNAL_DESCRIPTION);
@@ -94,6 +97,7 @@ Matrix &Elimination<Ring, Modules>::echelonize (Matrix        &A,
 			Transposition t (i, pivot_row);
 			P.push_back (t);
 			BLAS3::permute_rows (ctx, &t, &t + 1, A);
+			PS.swapRows (A, i, pivot_row);
 		}
 		TIMER_STOP(Permute);
 
@@ -119,6 +123,8 @@ Matrix &Elimination<Ring, Modules>::echelonize (Matrix        &A,
 
 				if (compute_L)
 					A.setEntry (j, i, negaxinv);
+
+				PS.rowChanged (A, j);
 			}
 		}
 		TIMER_STOP(ElimBelow);
@@ -151,6 +157,8 @@ Matrix1 &Elimination<Ring, Modules>::echelonize_reduced (Matrix1       &A,
 	lela_check (!compute_L || L.rowdim () == A.rowdim ());
 	lela_check (!compute_L || L.coldim () == A.rowdim ());
 
+	LELA_PROFILE ("Elimination::echelonize_reduced");
+
 	commentator.start ("Echelonize (elimination)", __FUNCTION__, A.rowdim () / PROGRESS_STEP);
 
 	// std::ostream &report = commentator.report (Commentator::LEVEL_UNIMPORTANT, INTERNAL_DESCRIPTION);
@@ -203,6 +211,7 @@ Matrix1 &Elimination<Ring, Modules>::echelonize_reduced (Matrix1       &A,
 			Transposition t (i, pivot_row);
 			P.push_back (t);
 			BLAS3::permute_rows (ctx, &t, &t + 1, A);
+			PS.swapRows (A, i, pivot_row);
 
 			if (compute_L) {
 				BLAS3::permute_rows (ctx, &t, &t + 1, L);
@@ -234,6 +243,7 @@ Matrix1 &Elimination<Ring, Modules>::echelonize_reduced (Matrix1       &A,
 
 				ctx.F.neg (nega, a);
 				BLAS1::axpy (ctx, nega, *i_A, *j_A);
+				PS.rowChanged (A, j);
 				
 				if (compute_L)
 					BLAS1::axpy (ctx, nega, *i_L, *j_L);
@@ -272,6 +282,8 @@ Matrix &Elimination<Ring, Modules>::pluq (Matrix        &A,
 					  Element       &det,
 					  PivotStrategy  PS) const
 {
+	LELA_PROFILE ("Elimination::pluq");
+
 	commentator.start ("PLUQ-decomposition (elimination)", __FUNCTION__, A.rowdim () / PROGRESS_STEP);
 
 	// std::ostream &report = commentator.report (Commentator::LEVEL_UNIMPORTANT, INTERNAL_DESCRIPTION);
@@ -309,12 +321,14 @@ Matrix &Elimination<Ring, Modules>::pluq (Matrix        &A,
 			Transposition t (i, pivot_row);
 			P.push_back (t);
 			BLAS3::permute_rows (ctx, &t, &t + 1, A);
+			PS.swapRows (A, i, pivot_row);
 		}
 
 		if (i != pivot_col) {
 			Transposition t (i, pivot_col);
 			Q.push_back (t);
 			BLAS3::permute_cols (ctx, &t, &t + 1, A);
+			PS.swapColumns (A, i, pivot_col);
 		}
 		TIMER_STOP(Permute);
 
@@ -347,6 +361,8 @@ Matrix &Elimination<Ring, Modules>::pluq (Matrix        &A,
 				// Set entry in L
 				ctx.F.negin (negaxinv);
 				A.setEntry (j, i, negaxinv);
+
+				PS.rowChanged (A, j);
 			}
 		}
 		TIMER_STOP(ElimBelow);
@@ -18,14 +18,18 @@
 #include "lela/blas/context.h"
 #include "lela/algorithms/gauss-jordan.h"
 #include "lela/util/splicer.h"
+#include "lela/util/thread.h"
 
 namespace LELA
 {
 
-// Forward-declaration
+// Forward-declarations
 template <class Ring, class Modules>
 class EchelonForm;
 
+template <class Element>
+class FaugereLachartreDiagonalBlocks;
+
 /**
  * \brief Implementation of algorithm for computing reduced row-echelon form
  * of a matrix coming from the F4-algorithm
@@ -41,17 +45,51 @@ template <class Ring, class Modules = AllModules<Ring> >
 class FaugereLachartre {
 	Context<Ring, Modules> &ctx;
 	EchelonForm<Ring, Modules> EF;
+	ThreadGroup threads;
+	size_t min_slab_width;
+	size_t diag_block_size;
 
 	template <class Matrix>
 	void setup_splicer (Splicer &splicer, Splicer &reconst_splicer, const Matrix &A, size_t &num_pivot_rows, typename Ring::Element &det) const;
 
+	void find_diagonal_blocks (std::vector<size_t> &bounds, const Splicer &splicer, size_t n) const;
+
+	size_t num_slabs (size_t cols) const;
+
+	template <class Matrix1, class Matrix2, class Matrix3, class Source>
+	void reduce_slabs (const Matrix1 &A, Matrix3 &B, const Matrix2 &C, Matrix3 &D, const Splicer *splicer, const Source *X,
+			   const FaugereLachartreDiagonalBlocks<typename Ring::Element> &diag_blocks);
+
 public:
+	static const size_t default_min_slab_width = 256;
+	static const size_t default_diag_block_size = 256;
+
 	/**
 	 * \brief Construct a new FaugereLachartre
 	 *
+	 * If more than one thread is requested, the non-pivot
+	 * columns of the matrix are cut into slabs. Each slab of
+	 * the blocks B and D is spliced out of the input, reduced by
+	 * trsm and gemm on its own thread, and so the splicing of one
+	 * slab overlaps with the arithmetic on the others. Each
+	 * thread works on its own copy of the modules of the
+	 * context.
+	 *
+	 * The sparse pivot-block A is inverted on B block by block,
+	 * from the bottom up. The diagonal blocks end at the
+	 * boundaries between runs of consecutive pivot-columns found
+	 * by the splicer, once they have at least _diag_block_size
+	 * rows. Diagonal blocks which are at least a quarter full are
+	 * copied into a dense matrix and solved with dense trsm and
+	 * gemm; the rest stay sparse.
+	 *
 	 * @param _ctx Context-object for matrix-calculations
+	 * @param num_threads Number of threads on which to run; 0 for one per available processor
+	 * @param _min_slab_width Smallest number of columns in a slab
+	 * @param _diag_block_size Smallest number of rows in a diagonal block of A
 	 */
-	FaugereLachartre (Context<Ring, Modules> &_ctx);
+	FaugereLachartre (Context<Ring, Modules> &_ctx, size_t num_threads = 1, size_t _min_slab_width = default_min_slab_width,
+			  size_t _diag_block_size = default_diag_block_size);
 
 	/** 
 	 * \brief Convert the matrix A into reduced
@@ -15,11 +15,16 @@
 #ifndef __LELA_ALGORITHMS_FAUGERE_LACHARTRE_TCC
 #define __LELA_ALGORITHMS_FAUGERE_LACHARTRE_TCC
 
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
 #include "lela/algorithms/faugere-lachartre.h"
 #include "lela/blas/level1.h"
 #include "lela/blas/level3.h"
 #include "lela/solutions/echelon-form.h"
 #include "lela/solutions/echelon-form-gf2.h"
+#include "lela/util/profile.h"
 
 #ifndef PROGRESS_STEP
 #  define PROGRESS_STEP 1024
@@ -29,13 +34,15 @@ namespace LELA
 {
 
 template <class Ring, class Modules>
-FaugereLachartre<Ring, Modules>::FaugereLachartre (Context<Ring, Modules> &_ctx)
-	: ctx (_ctx), EF (_ctx) {}
+FaugereLachartre<Ring, Modules>::FaugereLachartre (Context<Ring, Modules> &_ctx, size_t num_threads, size_t _min_slab_width, size_t _diag_block_size)
+	: ctx (_ctx), EF (_ctx), threads (num_threads), min_slab_width (_min_slab_width), diag_block_size (std::max (_diag_block_size, (size_t) 1)) {}
 
 template <class Ring, class Modules>
 template <class Matrix>
 void FaugereLachartre<Ring, Modules>::setup_splicer (Splicer &splicer, Splicer &reconst_splicer, const Matrix &A, size_t &num_pivot_rows, typename Ring::Element &det) const
 {
+	LELA_PROFILE ("FaugereLachartre::setup_splicer");
+
 	commentator.start ("Finding pivot-rows", __FUNCTION__);
 
 	typename Matrix::ConstRowIterator i_A;
@@ -160,6 +167,207 @@ public:
 	}
 };
 
+// Copy only the pivot-columns, i.e. the blocks A and C
+
+template <class Ring, class Matrix1, class Matrix2, class Matrix3>
+class MatrixGridPivots
+{
+	const Ring &R;
+	Matrix1 &X;
+	Matrix2 &A;
+	Matrix3 &C;
+
+public:
+	MatrixGridPivots (const Ring &__R, Matrix1 &__X, Matrix2 &__A, Matrix3 &__C)
+		: R (__R), X (__X), A (__A), C (__C)
+		{}
+
+	void operator () (const Block &horiz_block, const Block &vert_block)
+	{
+		if (vert_block.dest () == 0) {
+			if (horiz_block.dest () == 0)
+				Splicer::copyBlock (R, X, A, horiz_block, vert_block);
+			else
+				Splicer::copyBlock (R, X, C, horiz_block, vert_block);
+		}
+	}
+};
+
+// Copy only the columns start, ..., end - 1 of the blocks B and D
+
+template <class Ring, class Matrix1, class Matrix2>
+class MatrixGridSlab
+{
+	const Ring &R;
+	const Matrix1 &X;
+	Matrix2 &B, &D;
+	size_t start, end;
+
+public:
+	MatrixGridSlab (const Ring &__R, const Matrix1 &__X, Matrix2 &__B, Matrix2 &__D, size_t __start, size_t __end)
+		: R (__R), X (__X), B (__B), D (__D), start (__start), end (__end)
+		{}
+
+	void operator () (const Block &horiz_block, const Block &vert_block)
+	{
+		if (vert_block.dest () != 1 || vert_block.destIndexNextBlock () <= start || vert_block.destIndex () >= end)
+			return;
+
+		size_t first = std::max (vert_block.destIndex (), start), last = std::min (vert_block.destIndexNextBlock (), end);
+		Block slab_block (vert_block.source (), vert_block.dest (), vert_block.destToSourceIndex (first), first, last - first);
+
+		if (horiz_block.dest () == 0)
+			Splicer::copyBlock (R, X, B, horiz_block, slab_block);
+		else
+			Splicer::copyBlock (R, X, D, horiz_block, slab_block);
+	}
+};
+
+// Diagonal blocks of the pivot-block A with the given bounds. A
+// diagonal block which is at least a quarter full is copied into a
+// dense matrix, which all slabs then share; the others are solved in
+// place. If there are no bounds, A is solved as a whole.
+
+template <class Element>
+class FaugereLachartreDiagonalBlocks
+{
+	// Not copyable, since it owns the dense blocks
+	FaugereLachartreDiagonalBlocks (const FaugereLachartreDiagonalBlocks &);
+	FaugereLachartreDiagonalBlocks &operator = (const FaugereLachartreDiagonalBlocks &);
+
+public:
+	/// Bounds of the diagonal blocks; empty if A is not cut into blocks
+	std::vector<size_t> bounds;
+
+	/// Dense copy of the k-th diagonal block, or NULL if it stays sparse
+	std::vector<DenseMatrix<Element> *> dense;
+
+	FaugereLachartreDiagonalBlocks () {}
+
+	~FaugereLachartreDiagonalBlocks ()
+	{
+		for (typename std::vector<DenseMatrix<Element> *>::iterator i = dense.begin (); i != dense.end (); ++i)
+			delete *i;
+	}
+
+	/// Count the entries of each diagonal block of A and copy the dense ones
+	template <class Ring, class Modules, class Matrix>
+	void prepare (const Ring &F, Modules &M, const Matrix &A)
+	{
+		LELA_PROFILE ("FaugereLachartre::prepare_diagonal_blocks");
+
+		lela_check (bounds.empty () || (bounds.front () == 0 && bounds.back () == A.rowdim ()));
+
+		size_t k, start, end, nnz;
+		typename Matrix::ConstSubmatrixType::ConstRowIterator i_A;
+
+		dense.assign (bounds.empty () ? 0 : bounds.size () - 1, (DenseMatrix<Element> *) NULL);
+
+		for (k = 0; k < dense.size (); ++k) {
+			start = bounds[k];
+			end = bounds[k + 1];
+
+			const typename Matrix::ConstSubmatrixType A_kk (A, start, start, end - start, end - start);
+
+			for (i_A = A_kk.rowBegin (), nnz = 0; i_A != A_kk.rowEnd (); ++i_A)
+				nnz += std::distance (i_A->begin (), i_A->end ());
+
+			if (4 * nnz >= (end - start) * (end - start)) {
+				dense[k] = new DenseMatrix<Element> (end - start, end - start);
+				BLAS3::_copy<Ring, typename Modules::Tag>::op (F, M, A_kk, *dense[k]);
+			}
+		}
+	}
+};
+
+// Replace B by A^-1 B for the upper triangular matrix A, working
+// upwards over the given diagonal blocks of A, which must have been
+// prepared. The part of a block-row of A to the right of its diagonal
+// block is applied with gemm
+
+template <class Ring, class Modules, class Matrix1, class Matrix2>
+Matrix2 &trsm_diagonal_blocks (const Ring &F, Modules &M, const Matrix1 &A, Matrix2 &B,
+			       const FaugereLachartreDiagonalBlocks<typename Ring::Element> &blocks)
+{
+	LELA_PROFILE ("FaugereLachartre::trsm_diagonal_blocks");
+
+	lela_check (A.rowdim () == A.coldim ());
+	lela_check (A.coldim () == B.rowdim ());
+
+	if (blocks.bounds.empty ())
+		return BLAS3::_trsm<Ring, typename Modules::Tag>::op (F, M, F.one (), A, B, UpperTriangular, false);
+
+	lela_check (blocks.dense.size () == blocks.bounds.size () - 1);
+
+	size_t k, start, end;
+
+	for (k = blocks.dense.size (); k > 0; --k) {
+		start = blocks.bounds[k - 1];
+		end = blocks.bounds[k];
+
+		typename Matrix2::AlignedSubmatrixType B_k (B, start, 0, end - start, B.coldim ());
+
+		if (end < A.coldim ()) {
+			typename Matrix1::ConstSubmatrixType A_right (A, start, end, end - start, A.coldim () - end);
+			typename Matrix2::AlignedSubmatrixType B_below (B, end, 0, B.rowdim () - end, B.coldim ());
+
+			BLAS3::_gemm<Ring, typename Modules::Tag>::op (F, M, F.minusOne (), A_right, B_below, F.one (), B_k);
+		}
+
+		if (blocks.dense[k - 1] != NULL)
+			BLAS3::_trsm<Ring, typename Modules::Tag>::op (F, M, F.one (), *blocks.dense[k - 1], B_k, UpperTriangular, false);
+		else {
+			const typename Matrix1::ConstSubmatrixType A_kk (A, start, start, end - start, end - start);
+
+			BLAS3::_trsm<Ring, typename Modules::Tag>::op (F, M, F.one (), A_kk, B_k, UpperTriangular, false);
+		}
+	}
+
+	return B;
+}
+
+// Construct A^-1 B and D - C A^-1 B on the columns start, ..., end
+// - 1 of B and D, splicing these columns out of X first if a splicer
+// is given, and solving by the diagonal blocks of A
+
+template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3, class Source>
+class FaugereLachartreSlabJob : public ThreadGroup::Job
+{
+	const Ring &F;
+	const Modules &_M;
+	const Matrix1 &A;
+	const Matrix2 &C;
+	Matrix3 &B, &D;
+	const Splicer *splicer;
+	const Source *X;
+	const FaugereLachartreDiagonalBlocks<typename Ring::Element> &diag_blocks;
+	size_t start, end;
+
+public:
+	FaugereLachartreSlabJob (const Ring &__F, const Modules &__M, const Matrix1 &__A, Matrix3 &__B, const Matrix2 &__C, Matrix3 &__D,
+				 const Splicer *__splicer, const Source *__X, const FaugereLachartreDiagonalBlocks<typename Ring::Element> &__diag_blocks,
+				 size_t __start, size_t __end)
+		: F (__F), _M (__M), A (__A), C (__C), B (__B), D (__D), splicer (__splicer), X (__X), diag_blocks (__diag_blocks), start (__start), end (__end)
+		{}
+
+	void run ()
+	{
+		LELA_PROFILE ("FaugereLachartre::reduce_slab");
+
+		Modules M (_M);
+
+		if (splicer != NULL)
+			splicer->splice (MatrixGridSlab<Ring, Source, Matrix3> (F, *X, B, D, start, end));
+
+		typename Matrix3::AlignedSubmatrixType B_slab (B, 0, start, B.rowdim (), end - start);
+		typename Matrix3::AlignedSubmatrixType D_slab (D, 0, start, D.rowdim (), end - start);
+
+		trsm_diagonal_blocks (F, M, A, B_slab, diag_blocks);
+
+		BLAS3::_gemm<Ring, typename Modules::Tag>::op (F, M, F.minusOne (), C, B_slab, F.one (), D_slab);
+	}
+};
+
 template <class Ring, class Matrix>
 class MatrixGrid2
 {
@@ -223,14 +431,97 @@ struct DefaultSparseMatrix<GF2>
 	typedef SparseMatrix<bool, Vector<GF2>::Sparse> Type;
 };
 
+// Cut the n x n pivot-block into diagonal blocks of at least
+// diag_block_size rows, ending each block where a run of consecutive
+// pivot-columns in the splicer ends; runs longer than diag_block_size
+// are cut every diag_block_size rows
+
+template <class Ring, class Modules>
+void FaugereLachartre<Ring, Modules>::find_diagonal_blocks (std::vector<size_t> &bounds, const Splicer &splicer, size_t n) const
+{
+	std::vector<Block>::const_iterator i;
+	size_t next;
+
+	bounds.clear ();
+	bounds.push_back (0);
+
+	for (i = splicer.verticalBlocks ().begin (); i != splicer.verticalBlocks ().end (); ++i) {
+		if (i->dest () != 0)
+			continue;
+
+		for (next = i->destIndex () + diag_block_size; next < i->destIndexNextBlock (); next += diag_block_size)
+			if (next - bounds.back () >= diag_block_size)
+				bounds.push_back (next);
+
+		if (i->destIndexNextBlock () - bounds.back () >= diag_block_size)
+			bounds.push_back (i->destIndexNextBlock ());
+	}
+
+	if (bounds.back () < n)
+		bounds.push_back (n);
+}
+
+template <class Ring, class Modules>
+size_t FaugereLachartre<Ring, Modules>::num_slabs (size_t cols) const
+{
+	if (threads.size () <= 1)
+		return 1;
+
+	// Twice as many slabs as threads, so that the work balances
+	// out when the slabs differ in density
+	size_t width = std::max (min_slab_width, (size_t) DenseMatrix<typename Ring::Element>::colAlign);
+
+	return std::max ((size_t) 1, std::min (2 * threads.size (), cols / width));
+}
+
+template <class Ring, class Modules>
+template <class Matrix1, class Matrix2, class Matrix3, class Source>
+void FaugereLachartre<Ring, Modules>::reduce_slabs (const Matrix1 &A, Matrix3 &B, const Matrix2 &C, Matrix3 &D, const Splicer *splicer, const Source *X,
+						    const FaugereLachartreDiagonalBlocks<typename Ring::Element> &diag_blocks)
+{
+	typedef FaugereLachartreSlabJob<Ring, Modules, Matrix1, Matrix2, Matrix3, Source> Job;
+
+	const size_t align = Matrix3::colAlign;
+	size_t n = num_slabs (B.coldim ()), i;
+
+	std::vector<size_t> bounds (n + 1);
+
+	for (i = 0; i < n; ++i)
+		bounds[i] = align * ((i * B.coldim () / n) / align);
+
+	bounds[n] = B.coldim ();
+
+	std::vector<Job> slabs;
+	std::vector<ThreadGroup::Job *> jobs;
+
+	slabs.reserve (n);
+
+	for (i = 0; i < n; ++i)
+		if (bounds[i + 1] > bounds[i])
+			slabs.push_back (Job (ctx.F, ctx.M, A, B, C, D, splicer, X, diag_blocks, bounds[i], bounds[i + 1]));
+
+	for (typename std::vector<Job>::iterator j = slabs.begin (); j != slabs.end (); ++j)
+		jobs.push_back (&*j);
+
+	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+		<< "Working on " << slabs.size () << " column-slabs with " << threads.size () << " threads" << std::endl;
+
+	threads.run (jobs);
+}
+
 template <class Ring, class Modules>
 template <class Matrix>
 void FaugereLachartre<Ring, Modules>::echelonize (Matrix &R, const Matrix &X, size_t &rank, typename Ring::Element &det)
 {
+	LELA_PROFILE ("FaugereLachartre::echelonize");
+
 	commentator.start ("Reduction of F4-matrix to reduced row-echelon form", __FUNCTION__);
 
 	std::ostream &reportUI = commentator.report (Commentator::LEVEL_UNIMPORTANT, INTERNAL_DESCRIPTION);
 
+	// Writing out the intermediate matrices is costly, so only do so if they are shown
+	bool dump = !commentator.isNullStream (reportUI);
+
 	Splicer X_splicer, X_reconst_splicer;
 
 	size_t num_pivot_rows;
@@ -249,16 +540,59 @@ void FaugereLachartre<Ring, Modules>::echelonize (Matrix &R, const Matrix &X, si
 	DenseMatrix<typename Ring::Element> C (X.rowdim () - num_pivot_rows, num_pivot_rows);
 	DenseMatrix<typename Ring::Element> D (X.rowdim () - num_pivot_rows, X.coldim () - num_pivot_rows);
 
-	X_splicer.splice (MatrixGrid1<Ring, const Matrix, typename DefaultSparseMatrix<Ring>::Type, DenseMatrix<typename Ring::Element> > (ctx.F, X, A, B, C, D));
+	FaugereLachartreDiagonalBlocks<typename Ring::Element> diag_blocks;
+
+	find_diagonal_blocks (diag_blocks.bounds, X_splicer, num_pivot_rows);
+
+	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+		<< "Solving with " << diag_blocks.bounds.size () - 1 << " diagonal blocks of A" << std::endl;
+
+	if (num_slabs (B.coldim ()) > 1) {
+		// B and D are spliced by the slabs themselves
+		X_splicer.splice (MatrixGridPivots<Ring, const Matrix, typename DefaultSparseMatrix<Ring>::Type, DenseMatrix<typename Ring::Element> > (ctx.F, X, A, C));
+
+		if (dump) {
+			reportUI << "Matrix A:" << std::endl;
+			BLAS3::write (ctx, reportUI, A);
+			reportUI << "Matrix C:" << std::endl;
+			BLAS3::write (ctx, reportUI, C);
+		}
+
+		diag_blocks.prepare (ctx.F, ctx.M, A);
+
+		commentator.start ("Constructing A^-1 B and D - C A^-1 B on column-slabs");
+
+		reduce_slabs (A, B, C, D, &X_splicer, &X, diag_blocks);
+
+		commentator.stop (MSG_DONE);
+	} else {
+		X_splicer.splice (MatrixGrid1<Ring, const Matrix, typename DefaultSparseMatrix<Ring>::Type, DenseMatrix<typename Ring::Element> > (ctx.F, X, A, B, C, D));
+
+		if (dump) {
+			reportUI << "Matrix A:" << std::endl;
+			BLAS3::write (ctx, reportUI, A);
+			reportUI << "Matrix B:" << std::endl;
+			BLAS3::write (ctx, reportUI, B);
+			reportUI << "Matrix C:" << std::endl;
+			BLAS3::write (ctx, reportUI, C);
+			reportUI << "Matrix D:" << std::endl;
+			BLAS3::write (ctx, reportUI, D);
+		}
+
+		diag_blocks.prepare (ctx.F, ctx.M, A);
 
-	reportUI << "Matrix A:" << std::endl;
-	BLAS3::write (ctx, reportUI, A);
-	reportUI << "Matrix B:" << std::endl;
-	BLAS3::write (ctx, reportUI, B);
-	reportUI << "Matrix C:" << std::endl;
-	BLAS3::write (ctx, reportUI, C);
-	reportUI << "Matrix D:" << std::endl;
-	BLAS3::write (ctx, reportUI, D);
+		commentator.start ("Constructing A^-1 B");
+
+		trsm_diagonal_blocks (ctx.F, ctx.M, A, B, diag_blocks);
+
+		commentator.stop (MSG_DONE);
+
+		commentator.start ("Constructing D - C A^-1 B");
+
+		BLAS3::gemm (ctx, ctx.F.minusOne (), C, B, ctx.F.one (), D);
+
+		commentator.stop (MSG_DONE);
+	}
 
 	// std::ofstream Aout ("A.png");
 	// BLAS3::write (ctx, Aout, A, FORMAT_PNG);
@@ -269,35 +603,27 @@ void FaugereLachartre<Ring, Modules>::echelonize (Matrix &R, const Matrix &X, si
 	// std::ofstream Dout ("D.png");
 	// BLAS3::write (ctx, Dout, D, FORMAT_PNG);
 
-	commentator.start ("Constructing A^-1 B");
-
-	BLAS3::trsm (ctx, ctx.F.one (), A, B, UpperTriangular, false);
-
-	commentator.stop (MSG_DONE);
-
-	commentator.start ("Constructing D - C A^-1 B");
-
-	BLAS3::gemm (ctx, ctx.F.minusOne (), C, B, ctx.F.one (), D);
-
-	commentator.stop (MSG_DONE);
-
 	// std::ofstream ABout ("AB.png");
 	// BLAS3::write (ctx, ABout, B, FORMAT_PNG);
 	// std::ofstream DCABout ("D-CAB.png");
 	// BLAS3::write (ctx, DCABout, D, FORMAT_PNG);
 
-	reportUI << "A^-1 B:" << std::endl;
-	BLAS3::write (ctx, reportUI, B);
+	if (dump) {
+		reportUI << "A^-1 B:" << std::endl;
+		BLAS3::write (ctx, reportUI, B);
 
-	reportUI << "D - C A^-1 B:" << std::endl;
-	BLAS3::write (ctx, reportUI, D);
+		reportUI << "D - C A^-1 B:" << std::endl;
+		BLAS3::write (ctx, reportUI, D);
+	}
 
 	// size_t r_D;
 
 	EF.echelonize (D);
 
-	reportUI << "Row-echelon form of D - C A^-1 B:" << std::endl;
-	BLAS3::write (ctx, reportUI, D);
+	if (dump) {
+		reportUI << "Row-echelon form of D - C A^-1 B:" << std::endl;
+		BLAS3::write (ctx, reportUI, D);
+	}
 
 	// commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
 	// 	<< "Rank of dense part is " << r_D << std::endl;
@@ -323,29 +649,44 @@ void FaugereLachartre<Ring, Modules>::echelonize (Matrix &R, const Matrix &X, si
 	B_splicer.splice (MatrixGrid2<Ring, DenseMatrix<typename Ring::Element> > (ctx.F, B, B1, B2));
 	D_splicer.splice (MatrixGrid2<Ring, DenseMatrix<typename Ring::Element> > (ctx.F, D, D1, D2));
 
-	reportUI << "Matrix B1:" << std::endl;
-	BLAS3::write (ctx, reportUI, B1);
-	reportUI << "Matrix B2:" << std::endl;
-	BLAS3::write (ctx, reportUI, B2);
-	reportUI << "Matrix D1:" << std::endl;
-	BLAS3::write (ctx, reportUI, D1);
-	reportUI << "Matrix D2:" << std::endl;
-	BLAS3::write (ctx, reportUI, D2);
+	if (dump) {
+		reportUI << "Matrix B1:" << std::endl;
+		BLAS3::write (ctx, reportUI, B1);
+		reportUI << "Matrix B2:" << std::endl;
+		BLAS3::write (ctx, reportUI, B2);
+		reportUI << "Matrix D1:" << std::endl;
+		BLAS3::write (ctx, reportUI, D1);
+		reportUI << "Matrix D2:" << std::endl;
+		BLAS3::write (ctx, reportUI, D2);
+	}
+
+	if (num_slabs (D2.coldim ()) > 1) {
+		// D1 is solved as a whole
+		FaugereLachartreDiagonalBlocks<typename Ring::Element> D1_blocks;
+
+		commentator.start ("Constructing D1^-1 D2 and B2 - B1 D1^-1 D2 on column-slabs");
 
-	commentator.start ("Constructing D1^-1 D2");
+		reduce_slabs (D1, D2, B1, B2, (const Splicer *) NULL, (const Matrix *) NULL, D1_blocks);
 
-	BLAS3::trsm (ctx, ctx.F.one (), D1, D2, UpperTriangular, false);
+		commentator.stop (MSG_DONE);
+	} else {
+		commentator.start ("Constructing D1^-1 D2");
 
-	commentator.stop (MSG_DONE);
+		BLAS3::trsm (ctx, ctx.F.one (), D1, D2, UpperTriangular, false);
 
-	commentator.start ("Constructing B2 - B1 D1^-1 D2");
+		commentator.stop (MSG_DONE);
 
-	BLAS3::gemm (ctx, ctx.F.minusOne (), B1, D2, ctx.F.one (), B2);
+		commentator.start ("Constructing B2 - B1 D1^-1 D2");
 
-	commentator.stop (MSG_DONE);
+		BLAS3::gemm (ctx, ctx.F.minusOne (), B1, D2, ctx.F.one (), B2);
 
-	reportUI << "B2 - B1 D1^-1 D2:" << std::endl;
-	BLAS3::write (ctx, reportUI, B2);
+		commentator.stop (MSG_DONE);
+	}
+
+	if (dump) {
+		reportUI << "B2 - B1 D1^-1 D2:" << std::endl;
+		BLAS3::write (ctx, reportUI, B2);
+	}
 
 	Splicer composed_splicer, subst_splicer, D_splicer_rev;
 
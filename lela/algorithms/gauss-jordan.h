@@ -78,6 +78,20 @@ private:
 			     Element     &d,
 			     PivotStrategy PS) const;
 
+	// Internal recursive procedure for the PLUQ-decomposition. Splits
+	// A into left and right halves, decomposes the left half,
+	// eliminates the right half against it with trsm and gemm, and
+	// decomposes the resulting Schur-complement. Transpositions are
+	// appended to P and Q in the order in which they were applied
+	// to A.
+	template <class Matrix, class PivotStrategy>
+	void PLUQTransform (Matrix      &A,
+			    Permutation &P,
+			    Permutation &Q,
+			    size_t      &r,
+			    Element     &d,
+			    PivotStrategy PS) const;
+
 public:
 	/**
 	 * \brief Constructor
@@ -180,6 +194,66 @@ public:
 				     size_t        &rank,
 				     Element       &det,
 				     PivotStrategy  PS);
+
+	/**
+	 * \brief Compute the PLUQ-decomposition of a matrix
+	 *
+	 * At conclusion, the parameters will have the property that
+	 * A=PLUQ, where L is unit lower triangular, U is upper
+	 * triangular, and P and Q are permutations. The output is in
+	 * the same form as that of @ref Elimination::pluq, but is
+	 * computed recursively so that most of the work is done in
+	 * BLAS3::trsm and BLAS3::gemm.
+	 *
+	 * The decomposition reveals the column rank profile of A: the
+	 * first rank columns of UQ are the leftmost linearly
+	 * independent columns of A, in order. Thus the first rank rows
+	 * of UQ are a row-echelon form of A.
+	 *
+	 * The matrices L and U are stored in place in A, with L
+	 * occupying the part below the main diagonal and U occupying
+	 * the part above. The entries on the diagonal of L are
+	 * omitted and are taken to be one.
+	 *
+	 * @param A Matrix A. Will be replaced by the matrices L and U
+	 *
+	 * @param P Permutation in which to store the
+	 * row-permutation P as defined above.
+	 *
+	 * @param Q Permutation in which to store the
+	 * column-permutation Q as defined above.
+	 *
+	 * @param rank Integer into which to store the
+	 * computed rank
+	 *
+	 * @param det Ring-element into which to store the
+	 * computed determinant of the submatrix of A formed by
+	 * taking pivot-rows and -columns
+	 *
+	 * @returns Reference to A
+	 */
+	template <class Matrix>
+	Matrix &pluq (Matrix      &A,
+		      Permutation &P,
+		      Permutation &Q,
+		      size_t      &rank,
+		      Element     &det)
+		{ return pluq (A, P, Q, rank, det, typename DefaultPivotStrategy<Ring, Modules, typename Matrix::Row>::Strategy (ctx)); }
+
+	/** Compute the PLUQ-decomposition of a matrix using the
+	 * pivot-strategy provided
+	 *
+	 * Identical to pluq above, but uses the given
+	 * pivot-strategy. The pivot-strategy is only ever asked for a
+	 * pivot in a single column.
+	 */
+	template <class Matrix, class PivotStrategy>
+	Matrix &pluq (Matrix        &A,
+		      Permutation   &P,
+		      Permutation   &Q,
+		      size_t        &rank,
+		      Element       &det,
+		      PivotStrategy  PS);
 };
 
 } // namespace LELA
@@ -14,10 +14,13 @@
 #ifndef __LELA_ALGORITHMS_GAUSS_JORDAN_TCC
 #define __LELA_ALGORITHMS_GAUSS_JORDAN_TCC
 
+#include <algorithm>
+
 #include "lela/algorithms/gauss-jordan.h"
 
 #include "lela/blas/level1.h"
 #include "lela/blas/level3.h"
+#include "lela/util/profile.h"
 
 namespace LELA
 {
@@ -410,6 +413,117 @@ void GaussJordan<Ring, Modules>::GaussTransform (Matrix1     &A,
 	// report << "r = " << r << ", d_0 = " << d_0 << ", d = " << d << std::endl;
 }
 
+template <class Ring, class Modules>
+template <class Matrix, class PivotStrategy>
+void GaussJordan<Ring, Modules>::PLUQTransform (Matrix      &A,
+						Permutation &P,
+						Permutation &Q,
+						size_t      &r,
+						Element     &d,
+						PivotStrategy PS) const
+{
+	if (BLAS3::is_zero (ctx, A))
+		r = 0;
+	else if (A.coldim () == 1) {
+		size_t j, row = 0, col = 0;
+
+		typename Ring::Element aii, aiiinv, aij;
+
+		// Find the pivot
+		if (!PS.getPivot (A, aii, row, col))
+			throw LELAError ("Could not find pivot even though matrix is reported as nonzero");
+
+		lela_check (col == 0);
+
+		ctx.F.mulin (d, aii);
+
+		if (!ctx.F.inv (aiiinv, aii))
+			throw LELAError ("Pivot not invertible in the ring");
+
+		if (row != 0) {
+			P.push_back (Transposition (0, row));
+
+			// Swap the pivot-entry and the entry at (0,0)
+			if (A.getEntry (aij, 0, 0)) {
+				A.setEntry (row, 0, aij);
+			} else {
+				A.setEntry (row, 0, ctx.F.zero ());
+				A.eraseEntry (row, 0);
+			}
+
+			A.setEntry (0, 0, aii);
+		}
+
+		// The rest of the column becomes the first column of L
+		for (j = 1; j < A.rowdim (); ++j) {
+			if (A.getEntry (aij, j, 0)) {
+				ctx.F.mulin (aij, aiiinv);
+				A.setEntry (j, 0, aij);
+			}
+		}
+
+		r = 1;
+	}
+	else {
+		size_t n_1 = A.coldim () / 2, n_2 = A.coldim () - n_1;
+		size_t P_len = P.size (), r_1, r_2;
+
+		typename Matrix::SubmatrixType A_1 (A, 0, 0,   A.rowdim (), n_1);
+		typename Matrix::SubmatrixType A_2 (A, 0, n_1, A.rowdim (), n_2);
+
+		PLUQTransform (A_1, P, Q, r_1, d, PS);
+
+		typename Matrix::SubmatrixType L_11 (A, 0,   0,   r_1,               r_1);
+		typename Matrix::SubmatrixType L_21 (A, r_1, 0,   A.rowdim () - r_1, r_1);
+		typename Matrix::SubmatrixType L_2  (A, r_1, 0,   A.rowdim () - r_1, n_1);
+		typename Matrix::SubmatrixType U_12 (A, 0,   n_1, r_1,               n_2);
+		typename Matrix::SubmatrixType A_22 (A, r_1, n_1, A.rowdim () - r_1, n_2);
+
+		// Eliminate the right half against the pivots in the left half
+		BLAS3::permute_rows (ctx, P.begin () + P_len, P.end (), A_2);
+		BLAS3::trsm (ctx, ctx.F.one (), L_11, U_12, LowerTriangular, true);
+		BLAS3::gemm (ctx, ctx.F.minusOne (), L_21, U_12, ctx.F.one (), A_22);
+
+		Permutation P_2, Q_2;
+
+		PLUQTransform (A_22, P_2, Q_2, r_2, d, PS);
+
+		BLAS3::permute_rows (ctx, P_2.begin (), P_2.end (), L_2);
+		BLAS3::permute_cols (ctx, Q_2.begin (), Q_2.end (), U_12);
+
+		typename Permutation::iterator i;
+
+		// Update indices in permutations to refer to whole matrix
+		for (i = P_2.begin (); i != P_2.end (); ++i) {
+			i->first += r_1;
+			i->second += r_1;
+		}
+
+		for (i = Q_2.begin (); i != Q_2.end (); ++i) {
+			i->first += n_1;
+			i->second += n_1;
+		}
+
+		P.insert (P.end (), P_2.begin (), P_2.end ());
+		Q.insert (Q.end (), Q_2.begin (), Q_2.end ());
+
+		// Move the pivot-columns of the right half next to those
+		// of the left half. The columns of the left half without
+		// pivots are zero below row r_1, so this leaves L and U in
+		// place.
+		if (r_1 < n_1) {
+			size_t Q_len = Q.size ();
+
+			for (size_t k = 0; k < r_2; ++k)
+				Q.push_back (Transposition (r_1 + k, n_1 + k));
+
+			BLAS3::permute_cols (ctx, Q.begin () + Q_len, Q.end (), A);
+		}
+
+		r = r_1 + r_2;
+	}
+}
+
 template <class Ring, class Modules>
 template <class Matrix, class PivotStrategy>
 Matrix &GaussJordan<Ring, Modules>::echelonize (Matrix      &A,
@@ -418,6 +532,8 @@ Matrix &GaussJordan<Ring, Modules>::echelonize (Matrix      &A,
 						Element     &det,
 						PivotStrategy PS)
 {
+	LELA_PROFILE ("GaussJordan::echelonize");
+
 	commentator.start ("Asymptotically fast row-echelon form", __FUNCTION__);
 
 	int h;
@@ -443,6 +559,8 @@ Matrix1 &GaussJordan<Ring, Modules>::echelonize_reduced (Matrix1       &A,
 	lela_check (L.rowdim () == A.rowdim ());
 	lela_check (L.coldim () == A.rowdim ());
 
+	LELA_PROFILE ("GaussJordan::echelonize_reduced");
+
 	commentator.start ("Asymptotically fast reduced row-echelon form", __FUNCTION__);
 
 	int h;
@@ -465,6 +583,35 @@ Matrix1 &GaussJordan<Ring, Modules>::echelonize_reduced (Matrix1       &A,
 	return A;
 }
 
+template <class Ring, class Modules>
+template <class Matrix, class PivotStrategy>
+Matrix &GaussJordan<Ring, Modules>::pluq (Matrix        &A,
+					  Permutation   &P,
+					  Permutation   &Q,
+					  size_t        &rank,
+					  Element       &det,
+					  PivotStrategy  PS)
+{
+	LELA_PROFILE ("GaussJordan::pluq");
+
+	commentator.start ("Asymptotically fast PLUQ-decomposition", __FUNCTION__);
+
+	P.clear ();
+	Q.clear ();
+	ctx.F.copy (det, ctx.F.one ());
+
+	PLUQTransform (A, P, Q, rank, det, PS);
+
+	// PLUQTransform records the transpositions in the order in
+	// which they were applied to A; reverse them to obtain P and Q
+	std::reverse (P.begin (), P.end ());
+	std::reverse (Q.begin (), Q.end ());
+
+	commentator.stop (MSG_DONE);
+
+	return A;
+}
+
 } // namespace LELA
 
 #endif // __LELA_ALGORITHMS_GAUSS_JORDAN_TCC
@@ -0,0 +1,135 @@
+/* lela/algorithms/m4ri-elimination.h
+ * Copyright 2011 Bradford Hovinen
+ *
+ * Written by Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Gaussian elimination over GF(2) by the Method of the Four Russians
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_ALGORITHMS_M4RI_ELIMINATION_H
+#define __LELA_ALGORITHMS_M4RI_ELIMINATION_H
+
+#ifdef __LELA_HAVE_M4RI
+#  error "This header file is only used if LELA is configured without libm4ri."
+#endif
+
+#include <vector>
+
+#include "lela/blas/context.h"
+#include "lela/blas/level1-simd.h"
+#include "lela/blas/level3-m4rm.h"
+#include "lela/ring/gf2.h"
+
+namespace LELA
+{
+
+/** Gaussian elimination over GF(2) by the Method of the Four Russians
+ *
+ * This works directly on the words of a DenseMatrix<bool>, or of a
+ * submatrix of one whose columns begin on a word-boundary, so that no
+ * conversion to another format is needed.
+ *
+ * The columns are processed in blocks of at most table_bits, which
+ * never cross a word-boundary. For each block, up to table_bits pivots
+ * are found and reduced against each other. Then a table of all sums
+ * of the pivot-rows is constructed in Gray-code order, so that each of
+ * the remaining rows is reduced with a single lookup and addition
+ * rather than one addition per pivot.
+ *
+ * \ingroup algorithms
+ */
+template <class Modules = AllModules<GF2> >
+class M4RIElimination
+{
+public:
+	typedef std::pair<uint32, uint32> Transposition;
+	typedef std::vector<Transposition> Permutation;
+
+	/// Maximal number of columns in each block
+	static const unsigned int table_bits = 8;
+
+private:
+	Context<GF2, Modules> &ctx;
+
+	SIMDKernels<bool> _kernels;
+
+	// Sums of the pivot-rows of the current block
+	std::vector<uint64> _table;
+
+	// Entries at the positions of the current block of the given row
+	template <class Endianness>
+	static unsigned window (const PackedRows<uint64, Endianness> &W, size_t row, size_t col, unsigned k)
+		{ return PackedWindow<Endianness>::extract (W.row (row)[col >> WordTraits<uint64>::logof_size], col & WordTraits<uint64>::pos_mask, k); }
+
+	// Add row src to row dest, starting at the given word
+	template <class Endianness>
+	static void addRow (PackedRows<uint64, Endianness> &W, size_t dest, size_t src, size_t start);
+
+	// Swap the given rows, starting at the given word
+	template <class Endianness>
+	static void swapRows (PackedRows<uint64, Endianness> &W, size_t i, size_t j, size_t start);
+
+	// Fill in the table of all sums of the rows first, ..., first +
+	// num_pivots - 1, starting at the given word
+	template <class Endianness>
+	void makeTable (const PackedRows<uint64, Endianness> &W, size_t first, unsigned num_pivots, size_t start);
+
+	// Reduce the rows begin, ..., end - 1 by the table, where
+	// combination maps the entries in the current block to the index
+	// in the table
+	template <class Endianness>
+	void applyTable (PackedRows<uint64, Endianness> &W, size_t begin, size_t end, size_t col, unsigned k, const unsigned *combination);
+
+public:
+	/**
+	 * \brief Constructor
+	 *
+	 * @param _ctx Context-object for computations
+	 */
+	M4RIElimination (Context<GF2, Modules> &_ctx)
+		: ctx (_ctx) {}
+
+	/** Compute the (possibly reduced) row-echelon form of a matrix
+	 *
+	 * At conclusion, A_out is the row-echelon form of PA_in, where
+	 * A_out is the matrix A at output and A_in is the matrix A at
+	 * input. The transform is not computed.
+	 *
+	 * @param A Matrix whose row-echelon form is to be computed. Must
+	 * be a DenseMatrix<bool> or a submatrix of one whose columns
+	 * begin on a word-boundary; otherwise LELAError is thrown.
+	 *
+	 * @param P The permutation into which to store P as defined
+	 * above
+	 *
+	 * @param rank An integer into which to store the computed rank
+	 * of A
+	 *
+	 * @param reduced true if the reduced row-echelon form should be
+	 * computed, false if not
+	 *
+	 * @returns Reference to A
+	 */
+	template <class Matrix>
+	Matrix &echelonize (Matrix &A, Permutation &P, size_t &rank, bool reduced = false);
+};
+
+} // namespace LELA
+
+#include "lela/algorithms/m4ri-elimination.tcc"
+
+#endif // __LELA_ALGORITHMS_M4RI_ELIMINATION_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,222 @@
+/* lela/algorithms/m4ri-elimination.tcc
+ * Copyright 2011 Bradford Hovinen
+ *
+ * Written by Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Gaussian elimination over GF(2) by the Method of the Four Russians
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_ALGORITHMS_M4RI_ELIMINATION_TCC
+#define __LELA_ALGORITHMS_M4RI_ELIMINATION_TCC
+
+#include <algorithm>
+
+#include "lela/algorithms/m4ri-elimination.h"
+#include "lela/util/commentator.h"
+#include "lela/util/error.h"
+#include "lela/util/profile.h"
+
+namespace LELA
+{
+
+template <class Modules>
+template <class Endianness>
+void M4RIElimination<Modules>::addRow (PackedRows<uint64, Endianness> &W, size_t dest, size_t src, size_t start)
+{
+	uint64 *y = W.row (dest);
+	const uint64 *x = W.row (src);
+	size_t last = W.words () - 1;
+
+	for (size_t j = start; j < last; ++j)
+		y[j] ^= x[j];
+
+	y[last] ^= x[last] & W.lastMask ();
+}
+
+template <class Modules>
+template <class Endianness>
+void M4RIElimination<Modules>::swapRows (PackedRows<uint64, Endianness> &W, size_t i, size_t j, size_t start)
+{
+	uint64 *x = W.row (i), *y = W.row (j);
+	size_t last = W.words () - 1;
+
+	for (size_t l = start; l < last; ++l)
+		std::swap (x[l], y[l]);
+
+	uint64 t = (x[last] ^ y[last]) & W.lastMask ();
+	x[last] ^= t;
+	y[last] ^= t;
+}
+
+template <class Modules>
+template <class Endianness>
+void M4RIElimination<Modules>::makeTable (const PackedRows<uint64, Endianness> &W, size_t first, unsigned num_pivots, size_t start)
+{
+	size_t words = W.words () - start;
+	size_t entries = 1UL << num_pivots;
+	uint64 mask = W.lastMask ();
+
+	_table.resize (entries * words);
+	std::fill (_table.begin (), _table.begin () + words, 0ULL);
+
+	// Each entry differs from the one before it in Gray-code order
+	// by exactly one pivot-row
+	for (size_t i = 1; i < entries; ++i) {
+		size_t g = i ^ (i >> 1), g_prev = (i - 1) ^ ((i - 1) >> 1);
+		unsigned bit = 0;
+
+		while ((g ^ g_prev) != (1UL << bit))
+			++bit;
+
+		uint64 *dest = &_table[g * words];
+		const uint64 *src = &_table[g_prev * words];
+		const uint64 *row = W.row (first + bit) + start;
+
+		for (size_t j = 0; j < words - 1; ++j)
+			dest[j] = src[j] ^ row[j];
+
+		dest[words - 1] = src[words - 1] ^ (row[words - 1] & mask);
+	}
+}
+
+template <class Modules>
+template <class Endianness>
+void M4RIElimination<Modules>::applyTable (PackedRows<uint64, Endianness> &W, size_t begin, size_t end, size_t col, unsigned k, const unsigned *combination)
+{
+	size_t start = col >> WordTraits<uint64>::logof_size;
+	size_t words = W.words () - start;
+	const uint64 *source;
+
+	for (size_t r = begin; r < end; ++r) {
+		unsigned idx = combination[window (W, r, col, k)];
+
+		if (idx != 0) {
+			source = &_table[idx * words];
+			_kernels.add_rows (W.row (r) + start, &source, 1, words);
+		}
+	}
+}
+
+template <class Modules>
+template <class Matrix>
+Matrix &M4RIElimination<Modules>::echelonize (Matrix &A, Permutation &P, size_t &rank, bool reduced)
+{
+	LELA_PROFILE ("M4RIElimination::echelonize");
+
+	typedef typename Matrix::ContainerType::Rep::Endianness Endianness;
+
+	PackedRows<uint64, Endianness> W;
+
+	if (!getPackedRows (A, W))
+		throw LELAError ("M4RIElimination requires a matrix whose columns begin on a word-boundary");
+
+	commentator.start ("Echelonize (M4RI)", __FUNCTION__);
+
+	// Masks of the pivot-columns in the current block and the
+	// entries of the pivot-rows in that block
+	unsigned pivot_bits[table_bits], pivot_windows[table_bits];
+	unsigned combination[1U << table_bits];
+
+	P.clear ();
+	rank = 0;
+
+	for (size_t col = 0; col < W.cols && rank < W.rows;) {
+		unsigned k = std::min (std::min ((size_t) table_bits, W.cols - col),
+				       (size_t) (WordTraits<uint64>::bits - (col & WordTraits<uint64>::pos_mask)));
+		size_t start = col >> WordTraits<uint64>::logof_size;
+		unsigned c, i, p = 0;
+
+		// Find the pivots of the block, looking only at the
+		// entries in the block to decide whether a row is
+		// reduced to zero by the pivots already found
+		for (c = 0; c < k && rank + p < W.rows; ++c) {
+			unsigned bit = 1U << PackedWindow<Endianness>::index (c, k);
+			size_t r;
+
+			for (r = rank + p; r < W.rows; ++r) {
+				unsigned x = window (W, r, col, k);
+
+				for (i = 0; i < p; ++i)
+					if (x & pivot_bits[i])
+						x ^= pivot_windows[i];
+
+				if (x & bit)
+					break;
+			}
+
+			if (r == W.rows)
+				continue;
+
+			if (r != rank + p) {
+				swapRows (W, rank + p, r, start);
+				P.push_back (Transposition (rank + p, r));
+			}
+
+			unsigned x = window (W, rank + p, col, k);
+
+			for (i = 0; i < p; ++i) {
+				if (x & pivot_bits[i]) {
+					addRow (W, rank + p, rank + i, start);
+					x ^= pivot_windows[i];
+				}
+			}
+
+			// Keep the pivots of the block reduced against
+			// each other, so that the entries of a row in
+			// the pivot-columns say which pivots to add
+			for (i = 0; i < p; ++i) {
+				if (pivot_windows[i] & bit) {
+					addRow (W, rank + i, rank + p, start);
+					pivot_windows[i] ^= x;
+				}
+			}
+
+			pivot_bits[p] = bit;
+			pivot_windows[p] = x;
+			++p;
+		}
+
+		if (p > 0) {
+			makeTable (W, rank, p, start);
+
+			for (unsigned x = 0; x < (1U << k); ++x) {
+				combination[x] = 0;
+
+				for (i = 0; i < p; ++i)
+					if (x & pivot_bits[i])
+						combination[x] |= 1U << i;
+			}
+
+			applyTable (W, rank + p, W.rows, col, k, combination);
+
+			if (reduced)
+				applyTable (W, 0, rank, col, k, combination);
+
+			rank += p;
+		}
+
+		col += k;
+	}
+
+	commentator.stop (MSG_DONE);
+
+	return A;
+}
+
+} // namespace LELA
+
+#endif // __LELA_ALGORITHMS_M4RI_ELIMINATION_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
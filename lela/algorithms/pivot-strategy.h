@@ -13,6 +13,10 @@
 #ifndef __LELA_ALGORITHMS_PIVOT_STRATEGY_H
 #define __LELA_ALGORITHMS_PIVOT_STRATEGY_H
 
+#include <vector>
+#include <set>
+#include <utility>
+
 namespace LELA
 {
 
@@ -52,6 +56,42 @@ public:
  	 */
 	template <class Matrix>
 	bool getPivot (const Matrix &A, typename Matrix::Element &pivot, size_t &row, size_t &col) const;
+
+	/** Inform the strategy that two rows of the matrix were exchanged
+	 *
+	 * Elimination calls this after exchanging rows, so that
+	 * strategies which keep an index of the rows can update
+	 * it. Strategies without state do nothing.
+	 *
+	 * @param A Matrix in which the rows were exchanged
+	 * @param i Index of first row
+	 * @param j Index of second row
+	 */
+	template <class Matrix>
+	void swapRows (const Matrix &A, size_t i, size_t j) const;
+
+	/** Inform the strategy that a row of the matrix was changed
+	 *
+	 * Elimination calls this after adding a multiple of the pivot-row
+	 * to another row. Only the entries after the column of the last
+	 * pivot may have changed.
+	 *
+	 * @param A Matrix in which the row was changed
+	 * @param i Index of row
+	 */
+	template <class Matrix>
+	void rowChanged (const Matrix &A, size_t i) const;
+
+	/** Inform the strategy that two columns of the matrix were exchanged
+	 *
+	 * Elimination::pluq calls this after exchanging columns.
+	 *
+	 * @param A Matrix in which the columns were exchanged
+	 * @param i Index of first column
+	 * @param j Index of second column
+	 */
+	template <class Matrix>
+	void swapColumns (const Matrix &A, size_t i, size_t j) const;
 };
 
 /** Dense pivot-strategy
@@ -89,6 +129,15 @@ public:
 	template <class Matrix>
 	bool getPivot (const Matrix &A, typename Ring::Element &pivot, size_t &row, size_t &col) const
 		{ return getPivot_spec (A, pivot, row, col, typename VectorTraits<Ring, typename Matrix::Row>::RepresentationType ()); }
+
+	template <class Matrix>
+	void swapRows (const Matrix &A, size_t i, size_t j) const {}
+
+	template <class Matrix>
+	void rowChanged (const Matrix &A, size_t i) const {}
+
+	template <class Matrix>
+	void swapColumns (const Matrix &A, size_t i, size_t j) const {}
 };
 
 /** Sparse pivot-strategy without column-permutations
@@ -132,6 +181,207 @@ public:
 	template <class Matrix>
 	bool getPivot (const Matrix &A, typename Ring::Element &pivot, size_t &row, size_t &col) const
 		{ return getPivot_spec (A, pivot, row, col, typename VectorTraits<Ring, typename Matrix::Row>::RepresentationType ()); }
+
+	template <class Matrix>
+	void swapRows (const Matrix &A, size_t i, size_t j) const {}
+
+	template <class Matrix>
+	void rowChanged (const Matrix &A, size_t i) const {}
+
+	template <class Matrix>
+	void swapColumns (const Matrix &A, size_t i, size_t j) const {}
+};
+
+/** Sparse pivot-strategy without column-permutations, with an index of the rows
+ *
+ * This chooses the same pivots as SparsePartialPivotStrategy, but
+ * instead of scanning all remaining rows for each pivot, it keeps the
+ * rows in a bucket-queue keyed by their leading column and, within
+ * each bucket, by their number of nonzero entries. Finding a pivot
+ * is then amortised O(log n) rather than linear in the number of rows.
+ *
+ * The index must be kept up to date with swapRows and rowChanged,
+ * which Elimination does, so this strategy cannot be used with
+ * algorithms which do not report their changes to the matrix, such as
+ * GaussJordan. It is rebuilt whenever getPivot is called on a
+ * different matrix or at an earlier row than before.
+ *
+ * This strategy is only available for matrices with sparse, sparse
+ * 0-1, or hybrid 0-1 rows.
+ *
+ * \ingroup algorithms
+ */
+template <class Ring, class Modules>
+class IndexedSparsePivotStrategy
+{
+	Context<Ring, Modules> &ctx;
+
+	// Bucket-entry of a row: number of nonzero entries from the
+	// leading column and index of the row
+	typedef std::pair<size_t, size_t> Entry;
+
+	// Matrix which the index describes
+	const void *_A;
+	size_t _rowdim, _coldim;
+
+	// Rows before this one already hold pivots and are not indexed
+	size_t _first_row;
+
+	// Leading columns are determined among the columns from this one
+	size_t _floor;
+
+	// No bucket before this one is nonempty
+	size_t _min_col;
+
+	// Rows by leading column
+	std::vector<std::set<Entry> > _buckets;
+
+	// Leading column and weight of each row; the leading column is
+	// _coldim if the row is zero
+	std::vector<std::pair<size_t, size_t> > _keys;
+
+	template <class Vector>
+	bool getKey_spec (const Vector &v, size_t &col, size_t &weight, VectorRepresentationTypes::Sparse) const;
+
+	template <class Vector>
+	bool getKey_spec (const Vector &v, size_t &col, size_t &weight, VectorRepresentationTypes::Sparse01) const;
+
+	template <class Vector>
+	bool getKey_spec (const Vector &v, size_t &col, size_t &weight, VectorRepresentationTypes::Hybrid01) const;
+
+	// Compute the key of row i of A and add it to the index
+	template <class Matrix>
+	void insertRow (const Matrix &A, size_t i);
+
+	// Remove row i from the index
+	void removeRow (size_t i);
+
+	// Index the rows of A from row on, taking leading columns from col on
+	template <class Matrix>
+	void build (const Matrix &A, size_t row, size_t col);
+
+public:
+	/** Constructor
+	 *
+	 * _ctx Context-object to be used
+	 */
+	IndexedSparsePivotStrategy (Context<Ring, Modules> &_ctx)
+		: ctx (_ctx), _A (NULL), _rowdim (0), _coldim (0), _first_row (0), _floor (0), _min_col (0)
+	{}
+
+	template <class Matrix>
+	bool getPivot (const Matrix &A, typename Ring::Element &pivot, size_t &row, size_t &col);
+
+	template <class Matrix>
+	void swapRows (const Matrix &A, size_t i, size_t j);
+
+	template <class Matrix>
+	void rowChanged (const Matrix &A, size_t i);
+
+	// The columns which Elimination::pluq exchanges are zero in
+	// all rows which are not eliminated afterwards, so the index is
+	// not affected
+	template <class Matrix>
+	void swapColumns (const Matrix &A, size_t i, size_t j) {}
+};
+
+/** Sparse pivot-strategy with column-permutations minimising fill-in
+ *
+ * This pivot-strategy is useful for sparse matrices in
+ * elimination-problems where column-permutations are permitted, i.e.
+ * with Elimination::pluq. It chooses the pivot (r, c) with the least
+ * Markowitz-cost (r_r - 1) (c_c - 1), where r_r is the number of
+ * nonzero entries in row r and c_c that in column c of the part of the
+ * matrix not yet eliminated. This bounds the fill-in which the
+ * elimination-step with that pivot can cause.
+ *
+ * The counts are maintained incrementally through swapRows,
+ * swapColumns, and rowChanged. Rows and columns are examined in order
+ * of increasing count, and the search stops when no better pivot can
+ * be found or after search_limit rows and columns, as proposed by
+ * Zlatev. Since the ring is exact, there is no numerical threshold on
+ * the size of the pivot.
+ *
+ * This strategy must only be used with Elimination::pluq. It is only
+ * available for matrices with sparse or sparse 0-1 rows.
+ *
+ * \ingroup algorithms
+ */
+template <class Ring, class Modules>
+class MarkowitzPivotStrategy
+{
+	Context<Ring, Modules> &ctx;
+
+	// Maximal number of rows and columns to examine for each pivot
+	size_t _search_limit;
+
+	// Count and index of a row or column
+	typedef std::pair<size_t, size_t> Entry;
+
+	// Matrix which the counts describe
+	const void *_A;
+	size_t _rowdim, _coldim;
+
+	// Rows and columns before these already hold pivots and are not
+	// counted
+	size_t _first_row, _first_col;
+
+	// Patterns of rows are taken from the columns from this one on
+	size_t _floor;
+
+	// Columns of the nonzero entries of each row
+	std::vector<std::vector<size_t> > _row_cols;
+
+	// Rows with nonzero entries in each column
+	std::vector<std::set<size_t> > _col_rows;
+
+	// Nonzero rows and columns in order of increasing count
+	std::set<Entry> _rows_by_count, _cols_by_count;
+
+	template <class Vector>
+	void getPattern_spec (const Vector &v, std::vector<size_t> &cols, VectorRepresentationTypes::Sparse) const;
+
+	template <class Vector>
+	void getPattern_spec (const Vector &v, std::vector<size_t> &cols, VectorRepresentationTypes::Sparse01) const;
+
+	// Add the pattern of row i to the counts of the columns, or remove it
+	void addPattern (size_t i);
+	void removePattern (size_t i);
+
+	// Take the pattern of row i from A and add it to the counts
+	template <class Matrix>
+	void insertRow (const Matrix &A, size_t i);
+
+	// Remove column c from the patterns of all rows
+	void retireColumn (size_t c);
+
+	// Count the rows of A from row on in the columns from col on
+	template <class Matrix>
+	void build (const Matrix &A, size_t row, size_t col);
+
+public:
+	/** Constructor
+	 *
+	 * @param _ctx Context-object to be used
+	 * @param search_limit Maximal number of rows and columns to
+	 * examine when searching for a pivot
+	 */
+	MarkowitzPivotStrategy (Context<Ring, Modules> &_ctx, size_t search_limit = 4)
+		: ctx (_ctx), _search_limit (search_limit), _A (NULL), _rowdim (0), _coldim (0),
+		  _first_row (0), _first_col (0), _floor (0)
+	{}
+
+	template <class Matrix>
+	bool getPivot (const Matrix &A, typename Ring::Element &pivot, size_t &row, size_t &col);
+
+	template <class Matrix>
+	void swapRows (const Matrix &A, size_t i, size_t j);
+
+	template <class Matrix>
+	void rowChanged (const Matrix &A, size_t i);
+
+	template <class Matrix>
+	void swapColumns (const Matrix &A, size_t i, size_t j);
 };
 
 /** Sensible default pivot-strategies for row-types */
@@ -159,6 +409,24 @@ template <class Ring, class Modules, class Row>
 struct DefaultPivotStrategy<Ring, Modules, Row, VectorRepresentationTypes::Hybrid01>
 	{ typedef SparsePartialPivotStrategy<Ring, Modules> Strategy; };
 
+/** Sensible default pivot-strategies for algorithms which report
+ * their changes to the matrix to the strategy, such as Elimination */
+template <class Ring, class Modules, class Row, class Trait = typename VectorTraits<Ring, Row>::RepresentationType>
+struct DefaultIndexedPivotStrategy
+	{ typedef typename DefaultPivotStrategy<Ring, Modules, Row, Trait>::Strategy Strategy; };
+
+template <class Ring, class Modules, class Row>
+struct DefaultIndexedPivotStrategy<Ring, Modules, Row, VectorRepresentationTypes::Sparse>
+	{ typedef IndexedSparsePivotStrategy<Ring, Modules> Strategy; };
+
+template <class Ring, class Modules, class Row>
+struct DefaultIndexedPivotStrategy<Ring, Modules, Row, VectorRepresentationTypes::Sparse01>
+	{ typedef IndexedSparsePivotStrategy<Ring, Modules> Strategy; };
+
+template <class Ring, class Modules, class Row>
+struct DefaultIndexedPivotStrategy<Ring, Modules, Row, VectorRepresentationTypes::Hybrid01>
+	{ typedef IndexedSparsePivotStrategy<Ring, Modules> Strategy; };
+
 } // namespace LELA
 
 #include "lela/algorithms/pivot-strategy.tcc"
@@ -13,6 +13,10 @@
 #ifndef __LELA_ALGORITHMS_PIVOT_STRATEGY_TCC
 #define __LELA_ALGORITHMS_PIVOT_STRATEGY_TCC
 
+#include <algorithm>
+
+#include "lela/algorithms/pivot-strategy.h"
+
 namespace LELA
 {
 
@@ -187,6 +191,425 @@ bool SparsePartialPivotStrategy<Ring, Modules>::getPivot_spec (const Matrix &A,
 	return min_blocks != 0xffffffffU;
 }
 
+template <class Ring, class Modules>
+template <class Vector>
+bool IndexedSparsePivotStrategy<Ring, Modules>::getKey_spec (const Vector &v, size_t &col, size_t &weight,
+							     VectorRepresentationTypes::Sparse) const
+{
+	typename Vector::const_iterator i = std::lower_bound (v.begin (), v.end (), _floor, VectorUtils::FindSparseEntryLB ());
+
+	if (i == v.end ())
+		return false;
+
+	col = i->first;
+	weight = v.end () - i;
+
+	return true;
+}
+
+template <class Ring, class Modules>
+template <class Vector>
+bool IndexedSparsePivotStrategy<Ring, Modules>::getKey_spec (const Vector &v, size_t &col, size_t &weight,
+							     VectorRepresentationTypes::Sparse01) const
+{
+	typename Vector::const_iterator i = std::lower_bound (v.begin (), v.end (), _floor);
+
+	if (i == v.end ())
+		return false;
+
+	col = *i;
+	weight = v.end () - i;
+
+	return true;
+}
+
+template <class Ring, class Modules>
+template <class Vector>
+bool IndexedSparsePivotStrategy<Ring, Modules>::getKey_spec (const Vector &v, size_t &col, size_t &weight,
+							     VectorRepresentationTypes::Hybrid01) const
+{
+	typedef typename Vector::word_type word_type;
+
+	typename Vector::const_iterator block
+		= std::lower_bound (v.begin (), v.end (), _floor >> WordTraits<word_type>::logof_size, VectorUtils::FindSparseEntryLB ());
+	word_type w, t;
+
+	for (; block != v.end (); ++block) {
+		w = block->second;
+
+		if (block->first == _floor >> WordTraits<word_type>::logof_size)
+			w &= Vector::Endianness::mask_right (_floor & WordTraits<word_type>::pos_mask);
+
+		if (w != 0)
+			break;
+	}
+
+	if (block == v.end ())
+		return false;
+
+	for (col = block->first << WordTraits<word_type>::logof_size, t = Vector::Endianness::e_0; (t & w) == 0; t = Vector::Endianness::shift_right (t, 1), ++col);
+
+	weight = v.end () - block;
+
+	return true;
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void IndexedSparsePivotStrategy<Ring, Modules>::insertRow (const Matrix &A, size_t i)
+{
+	size_t col, weight;
+
+	if (getKey_spec (*(A.rowBegin () + i), col, weight, typename VectorTraits<Ring, typename Matrix::Row>::RepresentationType ())) {
+		_keys[i] = std::pair<size_t, size_t> (col, weight);
+		_buckets[col].insert (Entry (weight, i));
+		_min_col = std::min (_min_col, col);
+	} else
+		_keys[i] = std::pair<size_t, size_t> (_coldim, 0);
+}
+
+template <class Ring, class Modules>
+void IndexedSparsePivotStrategy<Ring, Modules>::removeRow (size_t i)
+{
+	if (_keys[i].first < _coldim)
+		_buckets[_keys[i].first].erase (Entry (_keys[i].second, i));
+
+	_keys[i].first = _coldim;
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void IndexedSparsePivotStrategy<Ring, Modules>::build (const Matrix &A, size_t row, size_t col)
+{
+	_A = &A;
+	_rowdim = A.rowdim ();
+	_coldim = A.coldim ();
+	_first_row = row;
+	_floor = col;
+	_min_col = _coldim;
+
+	_buckets.clear ();
+	_buckets.resize (_coldim);
+	_keys.resize (_rowdim);
+
+	for (size_t i = row; i < _rowdim; ++i)
+		insertRow (A, i);
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+bool IndexedSparsePivotStrategy<Ring, Modules>::getPivot (const Matrix &A, typename Ring::Element &x, size_t &row, size_t &col)
+{
+	lela_check (row < A.rowdim ());
+	lela_check (col < A.coldim ());
+
+	if (_A != &A || _rowdim != A.rowdim () || _coldim != A.coldim () || row < _first_row)
+		build (A, row, col);
+
+	// Rows before the starting row now hold pivots
+	for (; _first_row < row; ++_first_row)
+		removeRow (_first_row);
+
+	// Recompute the keys of rows which lead before the starting
+	// column, since these entries are no longer considered
+	if (col > _floor) {
+		_floor = col;
+
+		for (; _min_col < col; ++_min_col) {
+			std::set<Entry> bucket;
+
+			bucket.swap (_buckets[_min_col]);
+
+			for (typename std::set<Entry>::const_iterator i = bucket.begin (); i != bucket.end (); ++i)
+				insertRow (A, i->second);
+		}
+	}
+
+	while (_min_col < _coldim && _buckets[_min_col].empty ())
+		++_min_col;
+
+	if (_min_col == _coldim)
+		return false;
+
+	row = _buckets[_min_col].begin ()->second;
+	col = _min_col;
+	A.getEntry (x, row, col);
+
+	// All other rows with an entry in this column are now
+	// eliminated, after which their keys are taken from the
+	// columns after the pivot
+	_floor = col + 1;
+
+	return true;
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void IndexedSparsePivotStrategy<Ring, Modules>::swapRows (const Matrix &A, size_t i, size_t j)
+{
+	if (_A != &A || i < _first_row || j < _first_row)
+		return;
+
+	std::pair<size_t, size_t> key_i = _keys[i], key_j = _keys[j];
+
+	removeRow (i);
+	removeRow (j);
+
+	if (key_j.first < _coldim)
+		_buckets[key_j.first].insert (Entry (key_j.second, i));
+
+	if (key_i.first < _coldim)
+		_buckets[key_i.first].insert (Entry (key_i.second, j));
+
+	_keys[i] = key_j;
+	_keys[j] = key_i;
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void IndexedSparsePivotStrategy<Ring, Modules>::rowChanged (const Matrix &A, size_t i)
+{
+	if (_A != &A || i < _first_row)
+		return;
+
+	removeRow (i);
+	insertRow (A, i);
+}
+
+template <class Ring, class Modules>
+template <class Vector>
+void MarkowitzPivotStrategy<Ring, Modules>::getPattern_spec (const Vector &v, std::vector<size_t> &cols,
+							     VectorRepresentationTypes::Sparse) const
+{
+	cols.clear ();
+
+	for (typename Vector::const_iterator i = std::lower_bound (v.begin (), v.end (), _floor, VectorUtils::FindSparseEntryLB ()); i != v.end (); ++i)
+		cols.push_back (i->first);
+}
+
+template <class Ring, class Modules>
+template <class Vector>
+void MarkowitzPivotStrategy<Ring, Modules>::getPattern_spec (const Vector &v, std::vector<size_t> &cols,
+							     VectorRepresentationTypes::Sparse01) const
+{
+	cols.assign (std::lower_bound (v.begin (), v.end (), _floor), v.end ());
+}
+
+template <class Ring, class Modules>
+void MarkowitzPivotStrategy<Ring, Modules>::addPattern (size_t i)
+{
+	for (std::vector<size_t>::const_iterator j = _row_cols[i].begin (); j != _row_cols[i].end (); ++j) {
+		if (!_col_rows[*j].empty ())
+			_cols_by_count.erase (Entry (_col_rows[*j].size (), *j));
+
+		_col_rows[*j].insert (i);
+		_cols_by_count.insert (Entry (_col_rows[*j].size (), *j));
+	}
+
+	if (!_row_cols[i].empty ())
+		_rows_by_count.insert (Entry (_row_cols[i].size (), i));
+}
+
+template <class Ring, class Modules>
+void MarkowitzPivotStrategy<Ring, Modules>::removePattern (size_t i)
+{
+	for (std::vector<size_t>::const_iterator j = _row_cols[i].begin (); j != _row_cols[i].end (); ++j) {
+		_cols_by_count.erase (Entry (_col_rows[*j].size (), *j));
+		_col_rows[*j].erase (i);
+
+		if (!_col_rows[*j].empty ())
+			_cols_by_count.insert (Entry (_col_rows[*j].size (), *j));
+	}
+
+	if (!_row_cols[i].empty ())
+		_rows_by_count.erase (Entry (_row_cols[i].size (), i));
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void MarkowitzPivotStrategy<Ring, Modules>::insertRow (const Matrix &A, size_t i)
+{
+	getPattern_spec (*(A.rowBegin () + i), _row_cols[i], typename VectorTraits<Ring, typename Matrix::Row>::RepresentationType ());
+	addPattern (i);
+}
+
+template <class Ring, class Modules>
+void MarkowitzPivotStrategy<Ring, Modules>::retireColumn (size_t c)
+{
+	for (std::set<size_t>::const_iterator i = _col_rows[c].begin (); i != _col_rows[c].end (); ++i) {
+		std::vector<size_t> &cols = _row_cols[*i];
+
+		_rows_by_count.erase (Entry (cols.size (), *i));
+		cols.erase (std::find (cols.begin (), cols.end (), c));
+
+		if (!cols.empty ())
+			_rows_by_count.insert (Entry (cols.size (), *i));
+	}
+
+	if (!_col_rows[c].empty ())
+		_cols_by_count.erase (Entry (_col_rows[c].size (), c));
+
+	_col_rows[c].clear ();
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void MarkowitzPivotStrategy<Ring, Modules>::build (const Matrix &A, size_t row, size_t col)
+{
+	_A = &A;
+	_rowdim = A.rowdim ();
+	_coldim = A.coldim ();
+	_first_row = row;
+	_first_col = col;
+	_floor = col;
+
+	_row_cols.clear ();
+	_row_cols.resize (_rowdim);
+	_col_rows.clear ();
+	_col_rows.resize (_coldim);
+	_rows_by_count.clear ();
+	_cols_by_count.clear ();
+
+	for (size_t i = row; i < _rowdim; ++i)
+		insertRow (A, i);
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+bool MarkowitzPivotStrategy<Ring, Modules>::getPivot (const Matrix &A, typename Ring::Element &x, size_t &row, size_t &col)
+{
+	lela_check (row < A.rowdim ());
+	lela_check (col < A.coldim ());
+
+	if (_A != &A || _rowdim != A.rowdim () || _coldim != A.coldim () || row < _first_row || col < _first_col)
+		build (A, row, col);
+
+	// Rows and columns before the starting point now hold pivots
+	for (; _first_row < row; ++_first_row) {
+		removePattern (_first_row);
+		_row_cols[_first_row].clear ();
+	}
+
+	for (; _first_col < col; ++_first_col)
+		retireColumn (_first_col);
+
+	_floor = std::max (_floor, col);
+
+	std::set<Entry>::const_iterator i_row = _rows_by_count.begin (), i_col = _cols_by_count.begin ();
+	size_t best_cost = (size_t) -1, examined = 0, k, cost;
+
+	// Examine rows and columns in order of increasing count. Every
+	// entry not yet examined lies in a row and a column with count
+	// at least k, so its cost is at least (k - 1)^2.
+	while (i_row != _rows_by_count.end () || i_col != _cols_by_count.end ()) {
+		if (i_col != _cols_by_count.end () && (i_row == _rows_by_count.end () || i_col->first <= i_row->first)) {
+			k = i_col->first;
+
+			for (std::set<size_t>::const_iterator j = _col_rows[i_col->second].begin (); j != _col_rows[i_col->second].end (); ++j) {
+				cost = (_row_cols[*j].size () - 1) * (k - 1);
+
+				if (cost < best_cost) {
+					best_cost = cost;
+					row = *j;
+					col = i_col->second;
+				}
+			}
+
+			++i_col;
+		} else {
+			k = i_row->first;
+
+			for (std::vector<size_t>::const_iterator j = _row_cols[i_row->second].begin (); j != _row_cols[i_row->second].end (); ++j) {
+				cost = (k - 1) * (_col_rows[*j].size () - 1);
+
+				if (cost < best_cost) {
+					best_cost = cost;
+					row = i_row->second;
+					col = *j;
+				}
+			}
+
+			++i_row;
+		}
+
+		++examined;
+
+		if (best_cost <= (k - 1) * (k - 1) || examined >= _search_limit)
+			break;
+	}
+
+	if (best_cost == (size_t) -1)
+		return false;
+
+	A.getEntry (x, row, col);
+
+	// Elimination::pluq moves the pivot to column _first_col, after
+	// which the patterns of the eliminated rows are taken from the
+	// following columns
+	_floor = _first_col + 1;
+
+	return true;
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void MarkowitzPivotStrategy<Ring, Modules>::swapRows (const Matrix &A, size_t i, size_t j)
+{
+	if (_A != &A || i < _first_row || j < _first_row)
+		return;
+
+	removePattern (i);
+	removePattern (j);
+	std::swap (_row_cols[i], _row_cols[j]);
+	addPattern (i);
+	addPattern (j);
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void MarkowitzPivotStrategy<Ring, Modules>::rowChanged (const Matrix &A, size_t i)
+{
+	if (_A != &A || i < _first_row)
+		return;
+
+	removePattern (i);
+	insertRow (A, i);
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void MarkowitzPivotStrategy<Ring, Modules>::swapColumns (const Matrix &A, size_t i, size_t j)
+{
+	if (_A != &A || i < _first_col || j < _first_col || i == j)
+		return;
+
+	std::set<size_t> rows (_col_rows[i]);
+	rows.insert (_col_rows[j].begin (), _col_rows[j].end ());
+
+	for (std::set<size_t>::const_iterator r = rows.begin (); r != rows.end (); ++r) {
+		for (std::vector<size_t>::iterator c = _row_cols[*r].begin (); c != _row_cols[*r].end (); ++c) {
+			if (*c == i)
+				*c = j;
+			else if (*c == j)
+				*c = i;
+		}
+	}
+
+	if (!_col_rows[i].empty ())
+		_cols_by_count.erase (Entry (_col_rows[i].size (), i));
+
+	if (!_col_rows[j].empty ())
+		_cols_by_count.erase (Entry (_col_rows[j].size (), j));
+
+	std::swap (_col_rows[i], _col_rows[j]);
+
+	if (!_col_rows[i].empty ())
+		_cols_by_count.insert (Entry (_col_rows[i].size (), i));
+
+	if (!_col_rows[j].empty ())
+		_cols_by_count.insert (Entry (_col_rows[j].size (), j));
+}
+
 } // namespace LELA
 
 #endif // __LELA_ALGORITHMS_PIVOT_STRATEGY_TCC
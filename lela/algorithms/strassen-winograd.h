@@ -26,7 +26,9 @@
 
 #include "lela/util/commentator.h"
 #include "lela/util/timer.h"
+#include "lela/util/scratch-arena.h"
 #include "lela/blas/context.h"
+#include "lela/blas/tuning.h"
 
 namespace LELA
 {
@@ -41,6 +43,19 @@ namespace LELA
  * computation ISSAC 09, 55. ACM Press. Retrieved from
  * http://arxiv.org/abs/0707.2347
  *
+ * The temporaries of the ordinary variants are taken from a
+ * ScratchArena, which keeps one workspace-matrix per level of the
+ * recursion between calls. Before the recursion starts, gemm sizes
+ * the workspace of every level it will reach, so the recursion itself
+ * allocates nothing.
+ *
+ * The in-place and overwriting variants follow the schedules of the
+ * same paper which need less memory. The in-place variants are used
+ * when requested in the constructor and wherever the limit on the
+ * workspace forbids the temporaries of the ordinary variants; the
+ * overwriting variants are used by gemm_overwrite, for callers which
+ * no longer need A and B.
+ *
  * \ingroup algorithms
  */
 template <class ParentTag>
@@ -48,8 +63,9 @@ class StrassenWinograd
 {
 	size_t _cutoff;
 	bool _use_ip;
+	ScratchArena _scratch;
 
-	// FIXME
+	// Cutoff when none is given; StrassenModule uses TuningParameters instead
 	static const size_t default_cutoff = 2048;
 
 	// Calculate the product of the residual part of the input classically
@@ -57,26 +73,62 @@ class StrassenWinograd
 	Matrix3 &gemm_res (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
 			   size_t m, size_t k, size_t n);
 
-	// Ordinary variants: require extra storage and are fast
+	// The part of gemm_res which adds the product of the residual
+	// columns of A and rows of B to the leading 2m x 2n block of C
 	template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
-	Matrix3 &mul (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, Matrix3 &C);
+	Matrix3 &gemm_res_inner (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, Matrix3 &C,
+				 size_t m, size_t k, size_t n);
 
+	// The part of gemm_res which computes the residual rows and
+	// columns of C; this reads the leading blocks of A and B, so the
+	// overwriting variants call it before their main product
 	template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
-	Matrix3 &addmul (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C);
+	Matrix3 &gemm_res_border (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+				  size_t m, size_t k, size_t n);
+
+	// Get the workspace for the given level of the recursion. It
+	// holds side by side an m x max (k, n), a k x n, and an m x n
+	// temporary, starting in the columns 0, col2, and col3; NULL
+	// if the arena refuses it
+	template <class Matrix>
+	Matrix *workspace (size_t level, size_t m, size_t k, size_t n, size_t &col2, size_t &col3);
+
+	// Set up the workspace of each level which the product of a
+	// rows x inner and an inner x cols matrix reaches, from the top
+	template <class Matrix>
+	void reserve (size_t rows, size_t inner, size_t cols);
+
+	// Ordinary variants: require extra storage and are fast
+	template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
+	Matrix3 &mul (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, Matrix3 &C, size_t level);
 
-	// In-place variants: require no extra storage and are not quite as fast
 	template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
-	Matrix3 &mul_ip (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, Matrix3 &C);
+	Matrix3 &addmul (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+			 size_t level);
 
+	// In-place variants: leave A and B intact and need much less
+	// extra storage than the ordinary variants, but are not quite as
+	// fast. mul_ip needs one m x max (k, n) temporary per level and
+	// k <= m; addmul_ip needs an m x k and a k x n temporary
 	template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
-	Matrix3 &addmul_ip (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C);
+	Matrix3 &mul_ip (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, Matrix3 &C, size_t level);
 
-	// Overwriting variants: require no extra storage and are fast, but overwrite the inputs A and B
 	template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
-	Matrix3 &mul_ow (const Ring &R, Modules &M, const typename Ring::Element &a, Matrix1 &A, Matrix2 &B, Matrix3 &C);
+	Matrix3 &addmul_ip (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+			    size_t level);
+
+	// Overwriting variants: are fast and use the blocks of A and B
+	// as temporaries, leaving garbage there. mul_ow needs no extra
+	// storage; addmul_ow needs an m x k and a k x n temporary per
+	// level. Both need the blocks of A, B, and C to have the same
+	// dimensions, i.e. the matrices must be square up to the
+	// alignment, and use the ordinary variants otherwise
+	template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
+	Matrix3 &mul_ow (const Ring &R, Modules &M, const typename Ring::Element &a, Matrix1 &A, Matrix2 &B, Matrix3 &C, size_t level);
 
 	template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
-	Matrix3 &addmul_ow (const Ring &R, Modules &M, const typename Ring::Element &a, Matrix1 &A, Matrix2 &B, const typename Ring::Element &b, Matrix3 &C);
+	Matrix3 &addmul_ow (const Ring &R, Modules &M, const typename Ring::Element &a, Matrix1 &A, Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+			    size_t level);
 
 public:
 	/** Main constructor
@@ -84,17 +136,35 @@ public:
 	 * @param cutoff Size below which to switch to classical multiplication
 	 *
 	 * @param use_ip Set to true to use the in-place variant,
-	 * which requires no additional memory but is slower than the
-	 * ordinary variant
+	 * which requires much less additional memory but is slower
+	 * than the ordinary variant
 	 */
 	StrassenWinograd (size_t cutoff = default_cutoff, bool use_ip = false)
 		: _cutoff (cutoff), _use_ip (use_ip) {}
 
+	/// The copy has the same parameters and limit on workspace but none of the workspace itself
 	StrassenWinograd (const StrassenWinograd &sw)
-		: _cutoff (sw._cutoff), _use_ip (sw._use_ip) {}
+		: _cutoff (sw._cutoff), _use_ip (sw._use_ip), _scratch (sw._scratch) {}
 
 	StrassenWinograd &operator = (const StrassenWinograd &sw)
-		{ _cutoff = sw._cutoff; _use_ip = sw._use_ip; return *this; }
+		{ _cutoff = sw._cutoff; _use_ip = sw._use_ip; _scratch = sw._scratch; return *this; }
+
+	/// Size below which to switch to classical multiplication
+	size_t cutoff () const { return _cutoff; }
+
+	/// Set the size below which to switch to classical multiplication
+	void setCutoff (size_t cutoff) { _cutoff = cutoff; }
+
+	/** Workspace for the temporaries
+	 *
+	 * Use this to read the peak usage of workspace or to limit
+	 * it. Where the limit forbids the workspace for a level of the
+	 * recursion, that level uses the in-place variant, or is
+	 * computed classically if even that does not fit.
+	 */
+	ScratchArena &scratch () { return _scratch; }
+
+	const ScratchArena &scratch () const { return _scratch; }
 
 	/** C <- a A * B + b * C using Strassen-Winograd
 	 */
@@ -107,21 +177,28 @@ public:
 
 		if (_use_ip) {
 			if (R.isZero (b))
-				return mul_ip (R, M, a, A, B, C);
+				return mul_ip (R, M, a, A, B, C, 0);
 			else
-				return addmul_ip (R, M, a, A, B, b, C);
+				return addmul_ip (R, M, a, A, B, b, C, 0);
 		} else {
+			reserve<typename Matrix3::ContainerType> (A.rowdim (), A.coldim (), B.coldim ());
+
 			if (R.isZero (b))
-				return mul (R, M, a, A, B, C);
+				return mul (R, M, a, A, B, C, 0);
 			else
-				return addmul (R, M, a, A, B, b, C);
+				return addmul (R, M, a, A, B, b, C, 0);
 		}
 	}
 
 	/** C <- a A * B + b * C using Strassen-Winograd
 	 *
-	 * This variant overwrites the inputs A and B. It requires no
-	 * additional memory and is faster than the in-place variant.
+	 * This variant overwrites the inputs A and B, whose entries
+	 * are undefined afterwards. If b is zero it requires no
+	 * additional memory, otherwise workspace of half the size of
+	 * A at the top level of the recursion and a quarter of that
+	 * of the level above at each level below, and it is faster
+	 * than the in-place variant. It applies when A, B, and C are square; otherwise
+	 * the ordinary variant is used and A and B are left intact.
 	 */
 	template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
 	inline Matrix3 &gemm_overwrite (const Ring &R, Modules &M, const typename Ring::Element &a, Matrix1 &A, Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
@@ -131,9 +208,9 @@ public:
 		lela_check (B.coldim () == C.coldim ());
 
 		if (R.isZero (b))
-			return mul_ow (R, M, a, A, B, C);
+			return mul_ow (R, M, a, A, B, C, 0);
 		else
-			return addmul_ow (R, M, a, A, B, b, C);
+			return addmul_ow (R, M, a, A, B, b, C, 0);
 	}
 };
 
@@ -147,7 +224,13 @@ struct StrassenModule : public ParentModule
 
 	StrassenWinograd<typename ParentModule::Tag> sw;
 
-	StrassenModule (const Ring &R) : ParentModule (R) {}
+	StrassenModule (const Ring &R) : ParentModule (R), sw (TuningParameters<Ring>::strassen_cutoff) {}
+
+	void setStrassenCutoff (size_t cutoff) { sw.setCutoff (cutoff); }
+	size_t strassenCutoff () const { return sw.cutoff (); }
+
+	void setStrassenScratchLimit (size_t limit) { sw.scratch ().setLimit (limit); }
+	size_t strassenScratchPeak () const { return sw.scratch ().peak (); }
 };
 
 } // namespace LELA
@@ -49,6 +49,10 @@ template <class T1, class T2>
 T1 round_down (T1 n, const T2 m)
 	{ return m * (n / m); }
 
+template <class T1, class T2>
+T1 round_up (T1 n, const T2 m)
+	{ return m * ((n + m - 1) / m); }
+
 template <class Matrix1, class Matrix2>
 inline size_t align_row (size_t i)
 	{ return round_down (i, const_lcm <Matrix1::rowAlign, Matrix2::rowAlign>::val); }
@@ -61,18 +65,47 @@ template <class RowMatrix, class ColMatrix>
 inline size_t align_rowcol (size_t i)
 	{ return round_down (i, const_lcm <RowMatrix::rowAlign, ColMatrix::colAlign>::val); }
 
+template <class Matrix1, class Matrix2, class Matrix3>
+inline size_t align_square (size_t i)
+	{ return round_down (i, const_lcm<const_lcm<const_lcm<Matrix1::rowAlign, Matrix1::colAlign>::val,
+						    const_lcm<Matrix2::rowAlign, Matrix2::colAlign>::val>::val,
+					  const_lcm<Matrix3::rowAlign, Matrix3::colAlign>::val>::val); }
+
 template <class ParentTag>
-template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
-Matrix3 &StrassenWinograd<ParentTag>::gemm_res (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
-						size_t m, size_t k, size_t n)
+template <class Matrix>
+Matrix *StrassenWinograd<ParentTag>::workspace (size_t level, size_t m, size_t k, size_t n, size_t &col2, size_t &col3)
 {
-#ifdef __LELA_SW_DETAILED_PROFILE
-	commentator.start ("Residual gemm", __FUNCTION__);
+	col2 = round_up (std::max (k, n), Matrix::colAlign);
+	col3 = col2 + round_up (n, Matrix::colAlign);
 
-	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
-		<< "Size-parameters: " << m << ", " << k << ", " << n << std::endl;
-#endif // __LELA_SW_DETAILED_PROFILE
+	return _scratch.workspace<Matrix> (level, std::max (m, k), col3 + n);
+}
+
+template <class ParentTag>
+template <class Matrix>
+void StrassenWinograd<ParentTag>::reserve (size_t rows, size_t inner, size_t cols)
+{
+	size_t level, m, k, n, col2, col3;
 
+	for (level = 0; rows >= _cutoff && inner >= _cutoff && cols >= _cutoff; ++level) {
+		m = round_down (rows / 2, Matrix::rowAlign);
+		k = round_down (inner / 2, const_lcm<Matrix::rowAlign, Matrix::colAlign>::val);
+		n = round_down (cols / 2, Matrix::colAlign);
+
+		if (m == 0 || k == 0 || n == 0 || workspace<Matrix> (level, m, k, n, col2, col3) == NULL)
+			break;
+
+		rows = m;
+		inner = k;
+		cols = n;
+	}
+}
+
+template <class ParentTag>
+template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
+Matrix3 &StrassenWinograd<ParentTag>::gemm_res_inner (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, Matrix3 &C,
+						      size_t m, size_t k, size_t n)
+{
 	if (2 * k < A.coldim ()) {
 		typename Matrix3::AlignedSubmatrixType      C11 (C, 0,     0,     2 * m,               2 * n);
 		typename Matrix1::ConstAlignedSubmatrixType A12 (A, 0,     2 * k, 2 * m,               A.coldim () - 2 * k);
@@ -81,6 +114,14 @@ Matrix3 &StrassenWinograd<ParentTag>::gemm_res (const Ring &R, Modules &M, const
 		BLAS3::_gemm<Ring, ParentTag>::op (R, M, a, A12, B21, R.one (), C11);
 	}
 
+	return C;
+}
+
+template <class ParentTag>
+template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
+Matrix3 &StrassenWinograd<ParentTag>::gemm_res_border (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+						       size_t m, size_t k, size_t n)
+{
 	if (2 * n < C.coldim ()) {
 		typename Matrix3::AlignedSubmatrixType      C12 (C, 0,     2 * n, 2 * m, C.coldim () - 2 * n);
 		typename Matrix1::ConstAlignedSubmatrixType A11 (A, 0,     0,     2 * m, 2 * k);
@@ -126,6 +167,24 @@ Matrix3 &StrassenWinograd<ParentTag>::gemm_res (const Ring &R, Modules &M, const
 		}
 	}
 
+	return C;
+}
+
+template <class ParentTag>
+template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
+Matrix3 &StrassenWinograd<ParentTag>::gemm_res (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+						size_t m, size_t k, size_t n)
+{
+#ifdef __LELA_SW_DETAILED_PROFILE
+	commentator.start ("Residual gemm", __FUNCTION__);
+
+	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+		<< "Size-parameters: " << m << ", " << k << ", " << n << std::endl;
+#endif // __LELA_SW_DETAILED_PROFILE
+
+	gemm_res_inner (R, M, a, A, B, C, m, k, n);
+	gemm_res_border (R, M, a, A, B, b, C, m, k, n);
+
 #ifdef __LELA_SW_DETAILED_PROFILE
 	commentator.stop (MSG_DONE);
 #endif // __LELA_SW_DETAILED_PROFILE
@@ -135,16 +194,22 @@ Matrix3 &StrassenWinograd<ParentTag>::gemm_res (const Ring &R, Modules &M, const
 
 template <class ParentTag>
 template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
-Matrix3 &StrassenWinograd<ParentTag>::mul (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, Matrix3 &C)
+Matrix3 &StrassenWinograd<ParentTag>::mul (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, Matrix3 &C, size_t level)
 {
 	lela_check (A.coldim () == B.rowdim ());
 	lela_check (A.rowdim () == C.rowdim ());
 	lela_check (B.coldim () == C.coldim ());
 
+	typedef typename Matrix3::ContainerType Workspace;
+
 	size_t m = align_row<Matrix1, Matrix3> (C.rowdim () / 2), k = align_rowcol<Matrix1, Matrix2> (A.coldim () / 2), n = align_col<Matrix2, Matrix3> (C.coldim () / 2);
+	size_t col2, col3;
+	Workspace *W = NULL;
 
 	if (C.rowdim () < _cutoff || C.coldim () < _cutoff || A.coldim () < _cutoff || m == 0 || n == 0 || k == 0)
 		return BLAS3::_gemm<Ring, ParentTag>::op (R, M, a, A, B, R.zero (), C);
+	else if ((W = workspace<Workspace> (level, m, k, n, col2, col3)) == NULL)
+		return mul_ip (R, M, a, A, B, C, level);
 	else {
 #ifdef __LELA_SW_DETAILED_PROFILE
 		commentator.start ("StrassenWinograd::mul", __FUNCTION__);
@@ -168,7 +233,9 @@ Matrix3 &StrassenWinograd<ParentTag>::mul (const Ring &R, Modules &M, const type
 
 		SW_TIMER_START(other);
 
-		typename Matrix3::ContainerType X1 (m, std::max (k, n)), X2 (k, n);
+		typename Workspace::AlignedSubmatrixType X11 (*W, 0, 0,    m, k);
+		typename Workspace::AlignedSubmatrixType X12 (*W, 0, 0,    m, n);
+		typename Workspace::AlignedSubmatrixType X2  (*W, 0, col2, k, n);
 
 		typename Matrix1::ConstAlignedSubmatrixType A11 (A, 0, 0, m, k);
 		typename Matrix1::ConstAlignedSubmatrixType A12 (A, 0, k, m, k);
@@ -185,9 +252,6 @@ Matrix3 &StrassenWinograd<ParentTag>::mul (const Ring &R, Modules &M, const type
 		typename Matrix3::AlignedSubmatrixType C21 (C, m, 0, m, n);
 		typename Matrix3::AlignedSubmatrixType C22 (C, m, n, m, n);
 
-		typename Matrix3::ContainerType::AlignedSubmatrixType X11 (X1, 0, 0, m, k);
-		typename Matrix3::ContainerType::AlignedSubmatrixType X12 (X1, 0, 0, m, n);
-
 		BLAS3::_copy<Ring, ParentTag>::op (R, M, A11, X11);
 		BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), A21, X11);
 
@@ -197,7 +261,7 @@ Matrix3 &StrassenWinograd<ParentTag>::mul (const Ring &R, Modules &M, const type
 		SW_TIMER_STOP(other);
 
 		SW_TIMER_START(mul1);
-		mul (R, M, R.one (), X11, X2, C21);
+		mul (R, M, R.one (), X11, X2, C21, level + 1);
 		SW_TIMER_STOP(mul1);
 
 		SW_TIMER_START(other);
@@ -211,7 +275,7 @@ Matrix3 &StrassenWinograd<ParentTag>::mul (const Ring &R, Modules &M, const type
 		SW_TIMER_STOP(other);
 
 		SW_TIMER_START(mul2);
-		mul (R, M, R.one (), X11, X2, C22);
+		mul (R, M, R.one (), X11, X2, C22, level + 1);
 		SW_TIMER_STOP(mul2);
 
 		SW_TIMER_START(other);
@@ -224,7 +288,7 @@ Matrix3 &StrassenWinograd<ParentTag>::mul (const Ring &R, Modules &M, const type
 		SW_TIMER_STOP(other);
 
 		SW_TIMER_START(mul3);
-		mul (R, M, R.one (), X11, X2, C12);
+		mul (R, M, R.one (), X11, X2, C12, level + 1);
 		SW_TIMER_STOP(mul3);
 
 		SW_TIMER_START(other);
@@ -235,10 +299,10 @@ Matrix3 &StrassenWinograd<ParentTag>::mul (const Ring &R, Modules &M, const type
 		SW_TIMER_STOP(other);
 
 		SW_TIMER_START(mul4);
-		mul (R, M, R.one (), X11, B22, C11);
+		mul (R, M, R.one (), X11, B22, C11, level + 1);
 		SW_TIMER_STOP(mul4);
 		SW_TIMER_START(mul5);
-		mul (R, M, R.one (), A11, B11, X12);
+		mul (R, M, R.one (), A11, B11, X12, level + 1);
 		SW_TIMER_STOP(mul5);
 
 		SW_TIMER_START(other);
@@ -253,7 +317,7 @@ Matrix3 &StrassenWinograd<ParentTag>::mul (const Ring &R, Modules &M, const type
 		SW_TIMER_STOP(other);
 
 		SW_TIMER_START(mul6);
-		mul (R, M, R.one (), A22, X2, C11);
+		mul (R, M, R.one (), A22, X2, C11, level + 1);
 		SW_TIMER_STOP(mul6);
 
 		SW_TIMER_START(other);
@@ -263,7 +327,7 @@ Matrix3 &StrassenWinograd<ParentTag>::mul (const Ring &R, Modules &M, const type
 		SW_TIMER_STOP(other);
 
 		SW_TIMER_START(mul7);
-		mul (R, M, R.one (), A12, B21, C11);
+		mul (R, M, R.one (), A12, B21, C11, level + 1);
 		SW_TIMER_STOP(mul7);
 
 		SW_TIMER_START(other);
@@ -294,16 +358,23 @@ Matrix3 &StrassenWinograd<ParentTag>::mul (const Ring &R, Modules &M, const type
 
 template <class ParentTag>
 template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
-Matrix3 &StrassenWinograd<ParentTag>::addmul (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
+Matrix3 &StrassenWinograd<ParentTag>::addmul (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+					      size_t level)
 {
 	lela_check (A.coldim () == B.rowdim ());
 	lela_check (A.rowdim () == C.rowdim ());
 	lela_check (B.coldim () == C.coldim ());
 
+	typedef typename Matrix3::ContainerType Workspace;
+
 	size_t m = align_row<Matrix1, Matrix3> (C.rowdim () / 2), k = align_rowcol<Matrix1, Matrix2> (A.coldim () / 2), n = align_col<Matrix2, Matrix3> (C.coldim () / 2);
+	size_t col2, col3;
+	Workspace *W = NULL;
 
 	if (C.rowdim () < _cutoff || C.coldim () < _cutoff || A.coldim () < _cutoff || m == 0 || n == 0 || k == 0)
 		return BLAS3::_gemm<Ring, ParentTag>::op (R, M, a, A, B, b, C);
+	else if ((W = workspace<Workspace> (level, m, k, n, col2, col3)) == NULL)
+		return addmul_ip (R, M, a, A, B, b, C, level);
 	else {
 #ifdef __LELA_SW_DETAILED_PROFILE
 		commentator.start ("StrassenWinograd::mul", __FUNCTION__);
@@ -326,7 +397,9 @@ Matrix3 &StrassenWinograd<ParentTag>::addmul (const Ring &R, Modules &M, const t
 
 		SW_TIMER_START(other);
 
-		typename Matrix3::ContainerType X1 (m, k), X2 (k, n), X3 (m, n);
+		typename Workspace::AlignedSubmatrixType X1 (*W, 0, 0,    m, k);
+		typename Workspace::AlignedSubmatrixType X2 (*W, 0, col2, k, n);
+		typename Workspace::AlignedSubmatrixType X3 (*W, 0, col3, m, n);
 
 		typename Matrix1::ConstAlignedSubmatrixType A11 (A, 0, 0, m, k);
 		typename Matrix1::ConstAlignedSubmatrixType A12 (A, 0, k, m, k);
@@ -353,7 +426,7 @@ Matrix3 &StrassenWinograd<ParentTag>::addmul (const Ring &R, Modules &M, const t
 		SW_TIMER_STOP(other);
 
 		SW_TIMER_START(mul1);
-		mul (R, M, a, X1, X2, X3);
+		mul (R, M, a, X1, X2, X3, level + 1);
 		SW_TIMER_STOP(mul1);
 
 		SW_TIMER_START(other);
@@ -372,7 +445,7 @@ Matrix3 &StrassenWinograd<ParentTag>::addmul (const Ring &R, Modules &M, const t
 		SW_TIMER_STOP(other);
 
 		SW_TIMER_START(mul2);
-		mul (R, M, a, A11, B11, X3);
+		mul (R, M, a, A11, B11, X3, level + 1);
 		SW_TIMER_STOP(mul2);
 
 		SW_TIMER_START(other);
@@ -383,10 +456,10 @@ Matrix3 &StrassenWinograd<ParentTag>::addmul (const Ring &R, Modules &M, const t
 		SW_TIMER_STOP(other);
 
 		SW_TIMER_START(mul3);
-		addmul (R, M, a, X1, X2, R.one (), X3);
+		addmul (R, M, a, X1, X2, R.one (), X3, level + 1);
 		SW_TIMER_STOP(mul3);
 		SW_TIMER_START(mul4);
-		addmul (R, M, a, A12, B21, R.one (), C11);
+		addmul (R, M, a, A12, B21, R.one (), C11, level + 1);
 		SW_TIMER_STOP(mul4);
 
 		SW_TIMER_START(other);
@@ -399,7 +472,7 @@ Matrix3 &StrassenWinograd<ParentTag>::addmul (const Ring &R, Modules &M, const t
 		SW_TIMER_STOP(other);
 
 		SW_TIMER_START(mul5);
-		addmul (R, M, a, X1, B22, R.one (), C12);
+		addmul (R, M, a, X1, B22, R.one (), C12, level + 1);
 		SW_TIMER_STOP(mul5);
 
 		SW_TIMER_START(other);
@@ -412,7 +485,7 @@ Matrix3 &StrassenWinograd<ParentTag>::addmul (const Ring &R, Modules &M, const t
 		SW_TIMER_STOP(other);
 
 		SW_TIMER_START(mul6);
-		addmul (R, M, a, A22, X2, neg_b, C21);
+		addmul (R, M, a, A22, X2, neg_b, C21, level + 1);
 		SW_TIMER_STOP(mul6);
 
 		SW_TIMER_START(other);
@@ -426,7 +499,7 @@ Matrix3 &StrassenWinograd<ParentTag>::addmul (const Ring &R, Modules &M, const t
 		SW_TIMER_STOP(other);
 
 		SW_TIMER_START(mul7);
-		addmul (R, M, a, X1, X2, R.one (), X3);
+		addmul (R, M, a, X1, X2, R.one (), X3, level + 1);
 		SW_TIMER_STOP(mul7);
 
 		SW_TIMER_START(other);
@@ -454,33 +527,494 @@ Matrix3 &StrassenWinograd<ParentTag>::addmul (const Ring &R, Modules &M, const t
 	}
 }
 
-// FIXME
-
 template <class ParentTag>
 template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
-Matrix3 &StrassenWinograd<ParentTag>::mul_ip (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, Matrix3 &C)
+Matrix3 &StrassenWinograd<ParentTag>::mul_ip (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, Matrix3 &C, size_t level)
 {
-	return C;
+	lela_check (A.coldim () == B.rowdim ());
+	lela_check (A.rowdim () == C.rowdim ());
+	lela_check (B.coldim () == C.coldim ());
+
+	typedef typename Matrix3::ContainerType Workspace;
+
+	size_t m = align_row<Matrix1, Matrix3> (C.rowdim () / 2), k = align_rowcol<Matrix1, Matrix2> (A.coldim () / 2), n = align_col<Matrix2, Matrix3> (C.coldim () / 2);
+	Workspace *W = NULL;
+
+	// The temporaries for B are kept in the upper k x n part of C11, so k may not exceed m
+	if (C.rowdim () < _cutoff || C.coldim () < _cutoff || A.coldim () < _cutoff || m == 0 || n == 0 || k == 0 || k > m ||
+	    (W = _scratch.workspace<Workspace> (level, m, std::max (k, n))) == NULL)
+		return BLAS3::_gemm<Ring, ParentTag>::op (R, M, a, A, B, R.zero (), C);
+
+#ifdef __LELA_SW_DETAILED_PROFILE
+	commentator.start ("StrassenWinograd::mul_ip", __FUNCTION__);
+
+	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+		<< "Sizes: " << C.rowdim () << ", " << A.coldim () << ", " << C.coldim () << std::endl;
+
+	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+		<< "Size-parameters: " << m << ", " << k << ", " << n << std::endl;
+#endif // __LELA_SW_DETAILED_PROFILE
+
+	typename Workspace::AlignedSubmatrixType X1 (*W, 0, 0, m, k);
+	typename Workspace::AlignedSubmatrixType X2 (*W, 0, 0, m, n);
+
+	typename Matrix1::ConstAlignedSubmatrixType A11 (A, 0, 0, m, k);
+	typename Matrix1::ConstAlignedSubmatrixType A12 (A, 0, k, m, k);
+	typename Matrix1::ConstAlignedSubmatrixType A21 (A, m, 0, m, k);
+	typename Matrix1::ConstAlignedSubmatrixType A22 (A, m, k, m, k);
+
+	typename Matrix2::ConstAlignedSubmatrixType B11 (B, 0, 0, k, n);
+	typename Matrix2::ConstAlignedSubmatrixType B12 (B, 0, n, k, n);
+	typename Matrix2::ConstAlignedSubmatrixType B21 (B, k, 0, k, n);
+	typename Matrix2::ConstAlignedSubmatrixType B22 (B, k, n, k, n);
+
+	typename Matrix3::AlignedSubmatrixType C11 (C, 0, 0, m, n);
+	typename Matrix3::AlignedSubmatrixType C12 (C, 0, n, m, n);
+	typename Matrix3::AlignedSubmatrixType C21 (C, m, 0, m, n);
+	typename Matrix3::AlignedSubmatrixType C22 (C, m, n, m, n);
+
+	typename Matrix3::AlignedSubmatrixType Y (C, 0, 0, k, n);
+
+	typename Ring::Element neg_a;
+	R.neg (neg_a, a);
+
+	// C21 <- P7 = (A11 - A21) (B22 - B12)
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, A11, X1);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), A21, X1);
+
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, B22, Y);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), B12, Y);
+
+	mul_ip (R, M, a, X1, Y, C21, level + 1);
+
+	// C22 <- P5 = (A21 + A22) (B12 - B11)
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, A21, X1);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A22, X1);
+
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, B12, Y);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), B11, Y);
+
+	mul_ip (R, M, a, X1, Y, C22, level + 1);
+
+	// C12 <- P6 = (A21 + A22 - A11) (B22 - B12 + B11)
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), A11, X1);
+
+	BLAS3::_scal<Ring, ParentTag>::op (R, M, R.minusOne (), Y);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), B22, Y);
+
+	mul_ip (R, M, a, X1, Y, C12, level + 1);
+
+	// C22 <- P5 + P6, C12 <- P6 - P4 with P4 = A22 (B22 - B12 + B11 - B21)
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C12, C22);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), B21, Y);
+
+	addmul_ip (R, M, neg_a, A22, Y, R.one (), C12, level + 1);
+
+	// C11 <- P3 = (A12 - A21 - A22 + A11) B22, which overwrites Y
+	BLAS3::_scal<Ring, ParentTag>::op (R, M, R.minusOne (), X1);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A12, X1);
+
+	mul_ip (R, M, a, X1, B22, C11, level + 1);
+
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C22, C11);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C21, C22);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C12, C21);
+
+	// X2 <- P1 = A11 B11, which is part of all four blocks
+	mul_ip (R, M, a, A11, B11, X2, level + 1);
+
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, C11, C12);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), X2, C12);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), X2, C21);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), X2, C22);
+
+	// C11 <- P1 + P2 with P2 = A12 B21
+	mul_ip (R, M, a, A12, B21, C11, level + 1);
+
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), X2, C11);
+
+#ifdef __LELA_SW_DETAILED_PROFILE
+	commentator.stop (MSG_DONE);
+#endif // __LELA_SW_DETAILED_PROFILE
+
+	return gemm_res (R, M, a, A, B, R.zero (), C, m, k, n);
 }
 
 template <class ParentTag>
 template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
-Matrix3 &StrassenWinograd<ParentTag>::addmul_ip (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
+Matrix3 &StrassenWinograd<ParentTag>::addmul_ip (const Ring &R, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+						 size_t level)
 {
-	return C;
+	lela_check (A.coldim () == B.rowdim ());
+	lela_check (A.rowdim () == C.rowdim ());
+	lela_check (B.coldim () == C.coldim ());
+
+	typedef typename Matrix3::ContainerType Workspace;
+
+	size_t m = align_row<Matrix1, Matrix3> (C.rowdim () / 2), k = align_rowcol<Matrix1, Matrix2> (A.coldim () / 2), n = align_col<Matrix2, Matrix3> (C.coldim () / 2);
+	size_t col2 = round_up (k, Workspace::colAlign);
+	Workspace *W = NULL;
+
+	if (C.rowdim () < _cutoff || C.coldim () < _cutoff || A.coldim () < _cutoff || m == 0 || n == 0 || k == 0 ||
+	    (W = _scratch.workspace<Workspace> (level, std::max (m, k), col2 + n)) == NULL)
+		return BLAS3::_gemm<Ring, ParentTag>::op (R, M, a, A, B, b, C);
+
+#ifdef __LELA_SW_DETAILED_PROFILE
+	commentator.start ("StrassenWinograd::addmul_ip", __FUNCTION__);
+
+	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+		<< "Sizes: " << C.rowdim () << ", " << A.coldim () << ", " << C.coldim () << std::endl;
+
+	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+		<< "Size-parameters: " << m << ", " << k << ", " << n << std::endl;
+#endif // __LELA_SW_DETAILED_PROFILE
+
+	typename Workspace::AlignedSubmatrixType X (*W, 0, 0,    m, k);
+	typename Workspace::AlignedSubmatrixType Y (*W, 0, col2, k, n);
+
+	typename Matrix1::ConstAlignedSubmatrixType A11 (A, 0, 0, m, k);
+	typename Matrix1::ConstAlignedSubmatrixType A12 (A, 0, k, m, k);
+	typename Matrix1::ConstAlignedSubmatrixType A21 (A, m, 0, m, k);
+	typename Matrix1::ConstAlignedSubmatrixType A22 (A, m, k, m, k);
+
+	typename Matrix2::ConstAlignedSubmatrixType B11 (B, 0, 0, k, n);
+	typename Matrix2::ConstAlignedSubmatrixType B12 (B, 0, n, k, n);
+	typename Matrix2::ConstAlignedSubmatrixType B21 (B, k, 0, k, n);
+	typename Matrix2::ConstAlignedSubmatrixType B22 (B, k, n, k, n);
+
+	typename Matrix3::AlignedSubmatrixType C11 (C, 0, 0, m, n);
+	typename Matrix3::AlignedSubmatrixType C12 (C, 0, n, m, n);
+	typename Matrix3::AlignedSubmatrixType C21 (C, m, 0, m, n);
+	typename Matrix3::AlignedSubmatrixType C22 (C, m, n, m, n);
+
+	if (!R.isOne (b)) {
+		typename Matrix3::AlignedSubmatrixType C_part (C, 0, 0, 2 * m, 2 * n);
+		BLAS3::_scal<Ring, ParentTag>::op (R, M, b, C_part);
+	}
+
+	typename Ring::Element neg_a;
+	R.neg (neg_a, a);
+
+	// A product which belongs to several blocks is accumulated in
+	// one of them, after subtracting that one from the others and
+	// before adding it back
+
+	// P5 = (A21 + A22) (B12 - B11) to C12 and C22
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, A21, X);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A22, X);
+
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, B12, Y);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), B11, Y);
+
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), C22, C12);
+	addmul_ip (R, M, a, X, Y, R.one (), C22, level + 1);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C22, C12);
+
+	// P1 = A11 B11 to all four blocks
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), C11, C12);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), C11, C21);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), C11, C22);
+	addmul_ip (R, M, a, A11, B11, R.one (), C11, level + 1);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C11, C12);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C11, C21);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C11, C22);
+
+	// P6 = (A21 + A22 - A11) (B22 - B12 + B11) to C12, C21, and C22
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), A11, X);
+
+	BLAS3::_scal<Ring, ParentTag>::op (R, M, R.minusOne (), Y);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), B22, Y);
+
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), C22, C12);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), C22, C21);
+	addmul_ip (R, M, a, X, Y, R.one (), C22, level + 1);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C22, C12);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C22, C21);
+
+	// P3 = (A12 - A21 - A22 + A11) B22 to C12
+	BLAS3::_scal<Ring, ParentTag>::op (R, M, R.minusOne (), X);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A12, X);
+
+	addmul_ip (R, M, a, X, B22, R.one (), C12, level + 1);
+
+	// -P4 = -A22 (B22 - B12 + B11 - B21) to C21
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), B21, Y);
+
+	addmul_ip (R, M, neg_a, A22, Y, R.one (), C21, level + 1);
+
+	// P7 = (A11 - A21) (B22 - B12) to C21 and C22
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, A11, X);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), A21, X);
+
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, B22, Y);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), B12, Y);
+
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), C22, C21);
+	addmul_ip (R, M, a, X, Y, R.one (), C22, level + 1);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C22, C21);
+
+	// P2 = A12 B21 to C11
+	addmul_ip (R, M, a, A12, B21, R.one (), C11, level + 1);
+
+#ifdef __LELA_SW_DETAILED_PROFILE
+	commentator.stop (MSG_DONE);
+#endif // __LELA_SW_DETAILED_PROFILE
+
+	return gemm_res (R, M, a, A, B, b, C, m, k, n);
 }
 
 template <class ParentTag>
 template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
-Matrix3 &StrassenWinograd<ParentTag>::mul_ow (const Ring &R, Modules &M, const typename Ring::Element &a, Matrix1 &A, Matrix2 &B, Matrix3 &C)
+Matrix3 &StrassenWinograd<ParentTag>::mul_ow (const Ring &R, Modules &M, const typename Ring::Element &a, Matrix1 &A, Matrix2 &B, Matrix3 &C, size_t level)
 {
+	lela_check (A.coldim () == B.rowdim ());
+	lela_check (A.rowdim () == C.rowdim ());
+	lela_check (B.coldim () == C.coldim ());
+
+	// The schedule moves blocks between A, B, and C, so they must all have the same dimensions
+	size_t h = align_square<Matrix1, Matrix2, Matrix3> (C.rowdim () / 2);
+
+	if (C.rowdim () < _cutoff || C.coldim () < _cutoff || A.coldim () < _cutoff || h == 0 ||
+	    align_square<Matrix1, Matrix2, Matrix3> (A.coldim () / 2) != h || align_square<Matrix1, Matrix2, Matrix3> (C.coldim () / 2) != h)
+		return mul (R, M, a, A, B, C, level);
+
+#ifdef __LELA_SW_DETAILED_PROFILE
+	commentator.start ("StrassenWinograd::mul_ow", __FUNCTION__);
+
+	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+		<< "Sizes: " << C.rowdim () << ", " << A.coldim () << ", " << C.coldim () << std::endl;
+
+	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+		<< "Size-parameter: " << h << std::endl;
+#endif // __LELA_SW_DETAILED_PROFILE
+
+	typename Matrix1::AlignedSubmatrixType A11 (A, 0, 0, h, h);
+	typename Matrix1::AlignedSubmatrixType A12 (A, 0, h, h, h);
+	typename Matrix1::AlignedSubmatrixType A21 (A, h, 0, h, h);
+	typename Matrix1::AlignedSubmatrixType A22 (A, h, h, h, h);
+
+	typename Matrix2::AlignedSubmatrixType B11 (B, 0, 0, h, h);
+	typename Matrix2::AlignedSubmatrixType B12 (B, 0, h, h, h);
+	typename Matrix2::AlignedSubmatrixType B21 (B, h, 0, h, h);
+	typename Matrix2::AlignedSubmatrixType B22 (B, h, h, h, h);
+
+	typename Matrix3::AlignedSubmatrixType C11 (C, 0, 0, h, h);
+	typename Matrix3::AlignedSubmatrixType C12 (C, 0, h, h, h);
+	typename Matrix3::AlignedSubmatrixType C21 (C, h, 0, h, h);
+	typename Matrix3::AlignedSubmatrixType C22 (C, h, h, h, h);
+
+	// The border of C needs the leading blocks of A and B, which are destroyed below
+	gemm_res_border (R, M, a, A, B, R.zero (), C, h, h, h);
+
+	// C21 <- A11 - A21, C22 <- B12 - B11
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, A11, C21);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), A21, C21);
+
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, B12, C22);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), B11, C22);
+
+	// C11 <- P1 = A11 B11
+	mul_ow (R, M, a, A11, B11, C11, level + 1);
+
+	// A21 <- A21 + A22, B11 <- B22 - B12 + B11
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A22, A21);
+
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, B22, B11);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), C22, B11);
+
+	// C12 <- P5 = (A21 + A22) (B12 - B11)
+	mul_ow (R, M, a, A21, C22, C12, level + 1);
+
+	// A11 <- A12 + A11 - A21 - A22, B12 <- B22 - B12
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, A12, A11);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C21, A11);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), A22, A11);
+
+	BLAS3::_scal<Ring, ParentTag>::op (R, M, R.minusOne (), B12);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), B22, B12);
+
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, C12, C22);
+
+	// A21 <- P3 = (A12 - A21 - A22 + A11) B22
+	mul_ow (R, M, a, A11, B22, A21, level + 1);
+
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A21, C12);
+
+	// B22 <- B22 - B12 + B11 - B21, A21 <- A21 + A22 - A11
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, B11, B22);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), B21, B22);
+
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, A22, A21);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), C21, A21);
+
+	// A11 <- P4 = A22 (B22 - B12 + B11 - B21), A22 <- P2 = A12 B21
+	mul_ow (R, M, a, A22, B22, A11, level + 1);
+	mul_ow (R, M, a, A12, B21, A22, level + 1);
+
+	// A11 <- P1 - P4, C11 <- P1 + P2
+	BLAS3::_scal<Ring, ParentTag>::op (R, M, R.minusOne (), A11);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C11, A11);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C11, C12);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C11, C22);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A22, C11);
+
+	// A22 <- P6 = (A21 + A22 - A11) (B22 - B12 + B11)
+	mul_ow (R, M, a, A21, B11, A22, level + 1);
+
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A22, C12);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A22, C22);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A22, A11);
+
+	// A21 <- P7 = (A11 - A21) (B22 - B12)
+	mul_ow (R, M, a, C21, B12, A21, level + 1);
+
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A21, C22);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A21, A11);
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, A11, C21);
+
+	gemm_res_inner (R, M, a, A, B, C, h, h, h);
+
+#ifdef __LELA_SW_DETAILED_PROFILE
+	commentator.stop (MSG_DONE);
+#endif // __LELA_SW_DETAILED_PROFILE
+
 	return C;
 }
 
 template <class ParentTag>
 template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
-Matrix3 &StrassenWinograd<ParentTag>::addmul_ow (const Ring &R, Modules &M, const typename Ring::Element &a, Matrix1 &A, Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
+Matrix3 &StrassenWinograd<ParentTag>::addmul_ow (const Ring &R, Modules &M, const typename Ring::Element &a, Matrix1 &A, Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+						 size_t level)
 {
+	lela_check (A.coldim () == B.rowdim ());
+	lela_check (A.rowdim () == C.rowdim ());
+	lela_check (B.coldim () == C.coldim ());
+
+	typedef typename Matrix3::ContainerType Workspace;
+
+	// The schedule moves blocks between A, B, and C, so they must all have the same dimensions
+	size_t h = align_square<Matrix1, Matrix2, Matrix3> (C.rowdim () / 2);
+	size_t col2 = round_up (h, Workspace::colAlign);
+	Workspace *W = NULL;
+
+	if (C.rowdim () < _cutoff || C.coldim () < _cutoff || A.coldim () < _cutoff || h == 0 ||
+	    align_square<Matrix1, Matrix2, Matrix3> (A.coldim () / 2) != h || align_square<Matrix1, Matrix2, Matrix3> (C.coldim () / 2) != h ||
+	    (W = _scratch.workspace<Workspace> (level, h, col2 + h)) == NULL)
+		return addmul (R, M, a, A, B, b, C, level);
+
+#ifdef __LELA_SW_DETAILED_PROFILE
+	commentator.start ("StrassenWinograd::addmul_ow", __FUNCTION__);
+
+	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+		<< "Sizes: " << C.rowdim () << ", " << A.coldim () << ", " << C.coldim () << std::endl;
+
+	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+		<< "Size-parameter: " << h << std::endl;
+#endif // __LELA_SW_DETAILED_PROFILE
+
+	typename Workspace::AlignedSubmatrixType X (*W, 0, 0,    h, h);
+	typename Workspace::AlignedSubmatrixType Y (*W, 0, col2, h, h);
+
+	typename Matrix1::AlignedSubmatrixType A11 (A, 0, 0, h, h);
+	typename Matrix1::AlignedSubmatrixType A12 (A, 0, h, h, h);
+	typename Matrix1::AlignedSubmatrixType A21 (A, h, 0, h, h);
+	typename Matrix1::AlignedSubmatrixType A22 (A, h, h, h, h);
+
+	typename Matrix2::AlignedSubmatrixType B11 (B, 0, 0, h, h);
+	typename Matrix2::AlignedSubmatrixType B12 (B, 0, h, h, h);
+	typename Matrix2::AlignedSubmatrixType B21 (B, h, 0, h, h);
+	typename Matrix2::AlignedSubmatrixType B22 (B, h, h, h, h);
+
+	typename Matrix3::AlignedSubmatrixType C11 (C, 0, 0, h, h);
+	typename Matrix3::AlignedSubmatrixType C12 (C, 0, h, h, h);
+	typename Matrix3::AlignedSubmatrixType C21 (C, h, 0, h, h);
+	typename Matrix3::AlignedSubmatrixType C22 (C, h, h, h, h);
+
+	// The border of C needs the leading blocks of A and B, which are destroyed below
+	gemm_res_border (R, M, a, A, B, b, C, h, h, h);
+
+	if (!R.isOne (b)) {
+		typename Matrix3::AlignedSubmatrixType C_part (C, 0, 0, 2 * h, 2 * h);
+		BLAS3::_scal<Ring, ParentTag>::op (R, M, b, C_part);
+	}
+
+	// X <- A11 - A21, Y <- B12 - B11
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, A11, X);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), A21, X);
+
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, B12, Y);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), B11, Y);
+
+	// P1 = A11 B11 to all four blocks, accumulated in C11
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), C11, C12);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), C11, C21);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), C11, C22);
+	addmul_ow (R, M, a, A11, B11, R.one (), C11, level + 1);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C11, C12);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C11, C21);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), C11, C22);
+
+	// A21 <- A21 + A22, B11 <- B22 - B12 + B11
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A22, A21);
+
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, B22, B11);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), Y, B11);
+
+	// P5 = (A21 + A22) (B12 - B11) to C12 and C22
+	mul_ow (R, M, a, A21, Y, A11, level + 1);
+
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A11, C12);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A11, C22);
+
+	// A11 <- A12 + A11 - A21 - A22, B12 <- B22 - B12
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, A12, A11);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), X, A11);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), A22, A11);
+
+	BLAS3::_scal<Ring, ParentTag>::op (R, M, R.minusOne (), B12);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), B22, B12);
+
+	// P3 = (A12 - A21 - A22 + A11) B22 to C12
+	mul_ow (R, M, a, A11, B22, A21, level + 1);
+
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A21, C12);
+
+	// B22 <- B22 - B12 + B11 - B21, A21 <- A21 + A22 - A11
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, B11, B22);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), B21, B22);
+
+	BLAS3::_copy<Ring, ParentTag>::op (R, M, A22, A21);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), X, A21);
+
+	// -P4 = -A22 (B22 - B12 + B11 - B21) to C21
+	mul_ow (R, M, a, A22, B22, A11, level + 1);
+
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.minusOne (), A11, C21);
+
+	// P2 = A12 B21 to C11
+	mul_ow (R, M, a, A12, B21, A11, level + 1);
+
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A11, C11);
+
+	// P6 = (A21 + A22 - A11) (B22 - B12 + B11) to C12, C21, and C22
+	mul_ow (R, M, a, A21, B11, A11, level + 1);
+
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A11, C12);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A11, C21);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A11, C22);
+
+	// P7 = (A11 - A21) (B22 - B12) to C21 and C22
+	mul_ow (R, M, a, X, B12, A11, level + 1);
+
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A11, C21);
+	BLAS3::_axpy<Ring, ParentTag>::op (R, M, R.one (), A11, C22);
+
+	gemm_res_inner (R, M, a, A, B, C, h, h, h);
+
+#ifdef __LELA_SW_DETAILED_PROFILE
+	commentator.stop (MSG_DONE);
+#endif // __LELA_SW_DETAILED_PROFILE
+
 	return C;
 }
 
@@ -10,6 +10,10 @@
 #ifndef __BLAS_CONTEXT_H
 #define __BLAS_CONTEXT_H
 
+#include <cstddef>
+
+#include "lela/util/scratch-vectors.h"
+
 namespace LELA
 {
 
@@ -35,6 +39,27 @@ struct GenericModule
 
 	GenericModule (const Ring &R) {}
 	GenericModule () {}
+
+	/// Temporary vectors reused by the vector-operations which
+	/// merge into a temporary, such as axpy on sparse vectors
+	ScratchVectors vector_scratch;
+
+	/// @name Tuning-parameters
+	///
+	/// Modules which depend on a parameter hide these with
+	/// their own versions. Here they do nothing.
+	//@{
+
+	void setStrassenCutoff (size_t cutoff) {}
+	size_t strassenCutoff () const { return 0; }
+
+	void setStrassenScratchLimit (size_t limit) {}
+	size_t strassenScratchPeak () const { return 0; }
+
+	void setBlockSize (size_t block_size) {}
+	size_t blockSize () const { return 0; }
+
+	//@}
 };
 
 /** All modules
@@ -81,6 +106,62 @@ public:
 
 	/// Copy-constructor
 	Context (const Context &ctx) : F (ctx.F), M (ctx.M) {}
+
+	/** Set the dimension below which Strassen-Winograd
+	 * multiplication switches to the classical algorithm
+	 *
+	 * This overrides the value from @ref TuningParameters. It has
+	 * no effect if Modules does not include StrassenModule. To
+	 * override the value only for some computations, copy the
+	 * Context and change the copy.
+	 */
+	void setStrassenCutoff (size_t cutoff) { M.setStrassenCutoff (cutoff); }
+
+	/// Current cutoff for Strassen-Winograd multiplication; 0 if not applicable
+	size_t strassenCutoff () const { return M.strassenCutoff (); }
+
+	/** Limit the workspace which Strassen-Winograd
+	 * multiplication may hold, in entries of its temporary
+	 * matrices
+	 *
+	 * Levels of the recursion whose workspace would exceed the
+	 * limit use the in-place schedule, which needs less, and are
+	 * computed classically only if even that does not fit. 0
+	 * removes the limit. It has no effect if Modules does not
+	 * include StrassenModule.
+	 */
+	void setStrassenScratchLimit (size_t limit) { M.setStrassenScratchLimit (limit); }
+
+	/** Largest workspace, in entries, which Strassen-Winograd
+	 * multiplication has held at once through this Context; 0 if
+	 * not applicable
+	 *
+	 * Workspace used by copies of the modules on worker-threads,
+	 * e.g. in ParallelModule, is not included.
+	 */
+	size_t strassenScratchPeak () const { return M.strassenScratchPeak (); }
+
+	/** Set the number of products ZpModule accumulates before
+	 * reducing by the modulus
+	 *
+	 * This overrides the value from @ref TuningParameters. The
+	 * value is still limited by what the arithmetic permits, and 0
+	 * restores that limit. It has no effect if Modules does not
+	 * include ZpModule or if the ring does not use a block-size.
+	 */
+	void setBlockSize (size_t block_size) { M.setBlockSize (block_size); }
+
+	/// Current block-size of ZpModule; 0 if unlimited or not applicable
+	size_t blockSize () const { return M.blockSize (); }
+
+	/** Number of temporary vectors the vector-operations have
+	 * constructed through this Context
+	 *
+	 * Sparse axpy and similar operations keep one temporary of
+	 * each vector-type and exchange its storage with that of the
+	 * output, so this stays small however many operations run.
+	 */
+	size_t scratchVectorAllocations () const { return M.vector_scratch.allocations (); }
 };
 
 /// @name Enumerations used in arithmetic operations
@@ -223,7 +223,14 @@ Vector2 &_axpy<Ring, typename GenericModule<Ring>::Tag>::axpy_impl
 	(const Ring &F, Modules &M, const typename Ring::Element &a, const Vector1 &x, Vector2 &y,
 	 VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Sparse)
 {
-	SparseVector<typename Ring::Element, std::vector<typename Vector2::value_type::first_type>, std::vector<typename Vector2::value_type::second_type> > tmp;
+	typedef SparseVector<typename Ring::Element, std::vector<typename Vector2::value_type::first_type>, std::vector<typename Vector2::value_type::second_type> > Scratch;
+
+	// The result is merged into a temporary kept by the modules,
+	// which fast_copy exchanges with y if they have the same type,
+	// so the temporary then holds the old storage of y for the
+	// next call
+	Scratch &tmp = M.vector_scratch.template get<Scratch> ();
+	tmp.clear ();
 
 	typename Vector1::const_iterator i;
 	typename Vector2::const_iterator j;
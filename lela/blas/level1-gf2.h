@@ -40,6 +40,11 @@ class _dot<GF2, GenericModule<GF2>::Tag>
 	static reference &dot_impl (const GF2 &F, Modules &M, reference &res, const Vector1 &x, const Vector2 &y,
 				    VectorRepresentationTypes::Dense01, VectorRepresentationTypes::Hybrid01);
 
+	template <class Modules, class reference, class Vector1, class Vector>
+	static reference &dot_impl (const GF2 &F, Modules &M, reference &res, const Vector1 &x,
+				    const SparseSubvector<Vector, VectorRepresentationTypes::Hybrid01> &y,
+				    VectorRepresentationTypes::Dense01, VectorRepresentationTypes::Hybrid01);
+
 	template <class Modules, class reference, class Vector1, class Vector2>
 	static reference &dot_impl (const GF2 &F, Modules &M, reference &res, const Vector1 &x, const Vector2 &y,
 				    VectorRepresentationTypes::Sparse01, VectorRepresentationTypes::Dense01)
@@ -117,6 +122,10 @@ class _copy<GF2, GenericModule<GF2>::Tag>
 	static Vector2 &copy_impl (const GF2 &F, Modules &M, const Vector1 &x, Vector2 &y,
 				   VectorRepresentationTypes::Hybrid01, VectorRepresentationTypes::Dense01);
 
+	template <class Modules, class Vector, class Vector2>
+	static Vector2 &copy_impl (const GF2 &F, Modules &M, const SparseSubvector<Vector, VectorRepresentationTypes::Hybrid01> &x, Vector2 &y,
+				   VectorRepresentationTypes::Hybrid01, VectorRepresentationTypes::Dense01);
+
 	template <class Modules, class Vector1, class Vector2>
 	static Vector2 &copy_impl (const GF2 &F, Modules &M, const Vector1 &x, Vector2 &y,
 				   VectorRepresentationTypes::Hybrid01, VectorRepresentationTypes::Sparse01);
@@ -161,6 +170,10 @@ class _axpy<GF2, GenericModule<GF2>::Tag>
 	static Vector2 &axpy_impl (const GF2 &F, Modules &M, bool a, const Vector1 &x, Vector2 &y,
 				   VectorRepresentationTypes::Hybrid01, VectorRepresentationTypes::Dense01);
 
+	template <class Modules, class Vector, class Vector2>
+	static Vector2 &axpy_impl (const GF2 &F, Modules &M, bool a, const SparseSubvector<Vector, VectorRepresentationTypes::Hybrid01> &x, Vector2 &y,
+				   VectorRepresentationTypes::Hybrid01, VectorRepresentationTypes::Dense01);
+
 	template <class Modules, class Vector1, class Vector2>
 	static Vector2 &axpy_impl (const GF2 &F, Modules &M, bool a, const Vector1 &x, Vector2 &y,
 				   VectorRepresentationTypes::Hybrid01, VectorRepresentationTypes::Sparse01);
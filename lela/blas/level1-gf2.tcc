@@ -85,6 +85,40 @@ reference &_dot<GF2, GenericModule<GF2>::Tag>::dot_impl (const GF2 &F, Modules &
         return res = WordTraits<typename Vector1::word_type>::ParallelParity (t);
 }
 
+// Unaligned subvectors of hybrid vectors are handled word by word of
+// the underlying vector, shifting x into its alignment, rather than
+// going through the iterator of the subvector
+
+template <class Modules, class reference, class Vector1, class Vector>
+reference &_dot<GF2, GenericModule<GF2>::Tag>::dot_impl (const GF2 &F, Modules &M, reference &res, const Vector1 &x,
+							 const SparseSubvector<Vector, VectorRepresentationTypes::Hybrid01> &y,
+							 VectorRepresentationTypes::Dense01, VectorRepresentationTypes::Hybrid01)
+{
+	typedef typename Vector::word_type word_type;
+	typedef typename Vector::Endianness Endianness;
+
+	const size_t full = x.size () >> WordTraits<word_type>::logof_size, s0 = y.parent_offset (), s = y.shift ();
+	const word_type back = (x.size () & WordTraits<word_type>::pos_mask) ? x.back_word () & Endianness::mask_left (x.size () & WordTraits<word_type>::pos_mask) : word_type (0);
+
+	typename Vector1::const_word_iterator i = x.word_begin ();
+	typename Vector::const_iterator j;
+	typename Endianness::word_pair w;
+	word_type t = 0;
+	size_t v;
+
+	for (j = y.parent_begin (); j != y.parent_end (); ++j) {
+		v = j->first - s0;
+
+		w.parts.low = (v == 0) ? word_type (0) : (v - 1 < full) ? *(i + (v - 1)) : (v - 1 == full) ? back : word_type (0);
+		w.parts.high = (v < full) ? *(i + v) : (v == full) ? back : word_type (0);
+
+		w.full = Endianness::shift_right (w.full, s);
+		t ^= w.parts.high & j->second;
+	}
+
+	return res = WordTraits<word_type>::ParallelParity (t);
+}
+
 template <class Modules, class reference, class Vector1, class Vector2>
 reference &_dot<GF2, GenericModule<GF2>::Tag>::dot_impl (const GF2 &F, Modules &M, reference &res, const Vector1 &x, const Vector2 &y,
 							 VectorRepresentationTypes::Sparse01, VectorRepresentationTypes::Sparse01)
@@ -243,6 +277,16 @@ Vector2 &_copy<GF2, GenericModule<GF2>::Tag>::copy_impl (const GF2 &F, Modules &
 	return y;
 }
 
+template <class Modules, class Vector, class Vector2>
+Vector2 &_copy<GF2, GenericModule<GF2>::Tag>::copy_impl (const GF2 &F, Modules &M, const SparseSubvector<Vector, VectorRepresentationTypes::Hybrid01> &x, Vector2 &y,
+							 VectorRepresentationTypes::Hybrid01, VectorRepresentationTypes::Dense01)
+{
+	std::fill (y.word_begin (), y.word_end (), 0);
+	y.back_word () = 0;
+
+	return _axpy<GF2, GenericModule<GF2>::Tag>::op (F, M, true, x, y);
+}
+
 template <class Modules, class Vector1, class Vector2>
 Vector2 &_copy<GF2, GenericModule<GF2>::Tag>::copy_impl (const GF2 &F, Modules &M, const Vector1 &x, Vector2 &y,
 							 VectorRepresentationTypes::Hybrid01, VectorRepresentationTypes::Sparse01)
@@ -334,7 +378,8 @@ Vector2 &_axpy<GF2, GenericModule<GF2>::Tag>::axpy_impl (const GF2 &F, Modules &
 							 VectorRepresentationTypes::Sparse01, VectorRepresentationTypes::Sparse01)
 {
 	if (a) {
-		std::vector<typename Vector2::value_type> res;
+		std::vector<typename Vector2::value_type> &res = M.vector_scratch.template get<std::vector<typename Vector2::value_type> > ();
+		res.clear ();
 
 		typename Vector2::const_iterator i = y.begin ();
 		typename Vector1::const_iterator j = x.begin ();
@@ -386,6 +431,50 @@ Vector2 &_axpy<GF2, GenericModule<GF2>::Tag>::axpy_impl (const GF2 &F, Modules &
 	return y;
 }
 
+template <class Modules, class Vector, class Vector2>
+Vector2 &_axpy<GF2, GenericModule<GF2>::Tag>::axpy_impl (const GF2 &F, Modules &M, bool a, const SparseSubvector<Vector, VectorRepresentationTypes::Hybrid01> &x, Vector2 &y,
+							 VectorRepresentationTypes::Hybrid01, VectorRepresentationTypes::Dense01)
+{
+	typedef typename Vector::word_type word_type;
+	typedef typename Vector::Endianness Endianness;
+
+	if (!a)
+		return y;
+
+	const size_t full = y.size () >> WordTraits<word_type>::logof_size, s0 = x.parent_offset (), s = x.shift ();
+	const word_type back_mask = Endianness::mask_left (y.size () & WordTraits<word_type>::pos_mask);
+	const bool partial = (y.size () & WordTraits<word_type>::pos_mask) != 0;
+
+	typename Vector2::word_iterator j = y.word_begin ();
+	typename Vector::const_iterator i;
+	typename Endianness::word_pair w;
+	size_t v;
+
+	// Each word of the underlying vector is split between the
+	// words v - 1 and v of y
+	for (i = x.parent_begin (); i != x.parent_end (); ++i) {
+		v = i->first - s0;
+
+		w.parts.low = 0;
+		w.parts.high = i->second;
+		w.full = Endianness::shift_left (w.full, s);
+
+		if (s != 0 && v > 0) {
+			if (v - 1 < full)
+				*(j + (v - 1)) ^= w.parts.low;
+			else if (v - 1 == full && partial)
+				y.back_word () ^= w.parts.low & back_mask;
+		}
+
+		if (v < full)
+			*(j + v) ^= w.parts.high;
+		else if (v == full && partial)
+			y.back_word () ^= w.parts.high & back_mask;
+	}
+
+	return y;
+}
+
 template <class Modules, class Vector1, class Vector2>
 Vector2 &_axpy<GF2, typename GenericModule<GF2>::Tag>::axpy_impl
 	(const GF2 &F, Modules &M, bool a, const Vector1 &x, Vector2 &y,
@@ -407,7 +496,10 @@ Vector2 &_axpy<GF2, GenericModule<GF2>::Tag>::axpy_impl (const GF2 &F, Modules &
 							 VectorRepresentationTypes::Hybrid01, VectorRepresentationTypes::Hybrid01)
 {
 	if (a) {
-		HybridVector<typename Vector2::Endianness, typename Vector2::index_type, typename Vector2::word_type> res;
+		typedef HybridVector<typename Vector2::Endianness, typename Vector2::index_type, typename Vector2::word_type> Scratch;
+
+		Scratch &res = M.vector_scratch.template get<Scratch> ();
+		res.clear ();
 
 		typename Vector2::iterator i = y.begin ();
 		typename Vector1::const_iterator j = x.begin ();
@@ -578,7 +670,8 @@ bool _equal<GF2, GenericModule<GF2>::Tag>::equal_impl (const GF2 &F, Modules &M,
 	for (; i != x.word_end (); ++i)
 		if (*i) return false;
 
-	return true;
+	// The last word of x has only been compared if y has an entry for it
+	return j != y.end () || !x.back_word ();
 }
 
 template <class Modules, class Vector1, class Vector2>
@@ -14,6 +14,7 @@
 #include <iostream>
 
 #include "lela/blas/context.h"
+#include "lela/vector/bit-iterator.h"
 
 namespace LELA
 {
@@ -84,6 +84,38 @@ public:
 				   typename VectorTraits<Modular<uint32>, Vector2>::RepresentationType ()); }
 };
 
+#ifdef __LELA_UINT128
+
+template <>
+class _dot<Modular<uint64>, ZpModule<uint64>::Tag>
+{
+	template <class Vector1, class Vector2>
+	static uint64 &dot_impl (const Modular<uint64> &F, ZpModule<uint64> &M, uint64 &res, const Vector1 &x, const Vector2 &y,
+				 VectorRepresentationTypes::Dense, VectorRepresentationTypes::Dense);
+
+	template <class Vector1, class Vector2>
+	static uint64 &dot_impl (const Modular<uint64> &F, ZpModule<uint64> &M, uint64 &res, const Vector1 &x, const Vector2 &y,
+				 VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Dense);
+
+	template <class Vector1, class Vector2>
+	static uint64 &dot_impl (const Modular<uint64> &F, ZpModule<uint64> &M, uint64 &res, const Vector1 &x, const Vector2 &y,
+				 VectorRepresentationTypes::Dense, VectorRepresentationTypes::Sparse)
+		{ return op (F, M, res, y, x); }
+
+	template <class Vector1, class Vector2>
+	static uint64 &dot_impl (const Modular<uint64> &F, ZpModule<uint64> &M, uint64 &res, const Vector1 &x, const Vector2 &y,
+				 VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Sparse);
+
+public:
+	template <class Modules, class reference, class Vector1, class Vector2>
+	static reference &op (const Modular<uint64> &F, Modules &M, reference &res, const Vector1 &x, const Vector2 &y)
+		{ return dot_impl (F, M, res, x, y,
+				   typename VectorTraits<Modular<uint64>, Vector1>::RepresentationType (),
+				   typename VectorTraits<Modular<uint64>, Vector2>::RepresentationType ()); }
+};
+
+#endif // __LELA_UINT128
+
 } // namespace BLAS1
 
 } // namespace LELA
@@ -13,6 +13,8 @@
 #ifndef __BLAS_LEVEL1_MODULAR_TCC
 #define __BLAS_LEVEL1_MODULAR_TCC
 
+#include <algorithm>
+
 #include "lela/blas/level1-modular.h"
 #include "lela/ring/type-wrapper.h"
 
@@ -204,6 +206,81 @@ uint32 &_dot<Modular<uint32>, ZpModule<uint32>::Tag>::dot_impl (const Modular<ui
 	return res = s % (uint64) F._modulus;
 }
 
+#ifdef __LELA_UINT128
+
+template <class Vector1, class Vector2>
+uint64 &_dot<Modular<uint64>, ZpModule<uint64>::Tag>::dot_impl (const Modular<uint64> &F, ZpModule<uint64> &M, uint64 &res, const Vector1 &x, const Vector2 &y,
+								VectorRepresentationTypes::Dense, VectorRepresentationTypes::Dense)
+{
+	lela_check (x.size () == y.size ());
+
+	typename Vector1::const_iterator i = x.begin (), block_end;
+	typename Vector2::const_iterator j = y.begin ();
+
+	uint128 s = 0;
+
+	while (i != x.end ()) {
+		block_end = i + std::min<size_t> (M.block_size, x.end () - i);
+
+		for (; i != block_end; ++i, ++j)
+			s += (uint128) *i * (uint128) *j;
+
+		s %= F._modulus;
+	}
+
+	return res = s;
+}
+
+template <class Vector1, class Vector2>
+uint64 &_dot<Modular<uint64>, ZpModule<uint64>::Tag>::dot_impl (const Modular<uint64> &F, ZpModule<uint64> &M, uint64 &res, const Vector1 &x, const Vector2 &y,
+								VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Dense)
+{
+	lela_check (VectorUtils::hasDim<Modular<uint64> > (x, y.size ()));
+
+	typename Vector1::const_iterator i = x.begin (), block_end;
+
+	uint128 s = 0;
+
+	while (i != x.end ()) {
+		block_end = i + std::min<size_t> (M.block_size, x.end () - i);
+
+		for (; i != block_end; ++i)
+			s += (uint128) i->second * (uint128) y[i->first];
+
+		s %= F._modulus;
+	}
+
+	return res = s;
+}
+
+template <class Vector1, class Vector2>
+uint64 &_dot<Modular<uint64>, ZpModule<uint64>::Tag>::dot_impl (const Modular<uint64> &F, ZpModule<uint64> &M, uint64 &res, const Vector1 &x, const Vector2 &y,
+								VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Sparse)
+{
+	typename Vector1::const_iterator i = x.begin ();
+	typename Vector2::const_iterator j = y.begin ();
+
+	uint128 s = 0;
+	size_t count = 0;
+
+	for (; i != x.end () && j != y.end (); ++i) {
+		while (j != y.end () && j->first < i->first) ++j;
+
+		if (j != y.end () && i->first == j->first) {
+			s += (uint128) i->second * (uint128) j->second;
+
+			if (++count == M.block_size) {
+				s %= F._modulus;
+				count = 0;
+			}
+		}
+	}
+
+	return res = s % F._modulus;
+}
+
+#endif // __LELA_UINT128
+
 } // namespace BLAS1
 
 } // namespace LELA
@@ -0,0 +1,78 @@
+/* lela/blas/level1-montgomery.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Implementations of level 1 BLAS interface for Z/p with
+ * Montgomery-reduction
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL1_MONTGOMERY_H
+#define __BLAS_LEVEL1_MONTGOMERY_H
+
+#include "lela/ring/modular-montgomery.h"
+#include "lela/blas/context.h"
+#include "lela/vector/traits.h"
+#include "lela/blas/level1-ll.h"
+
+namespace LELA
+{
+
+namespace BLAS1
+{
+
+template <class Element>
+class _dot<ModularMontgomery<Element>, typename MontgomeryModule<Element>::Tag>
+{
+	template <class Vector1, class Vector2>
+	static Element &dot_impl (const ModularMontgomery<Element> &F, MontgomeryModule<Element> &M, Element &res, const Vector1 &x, const Vector2 &y,
+				  VectorRepresentationTypes::Dense, VectorRepresentationTypes::Dense);
+
+	template <class Vector1, class Vector2>
+	static Element &dot_impl (const ModularMontgomery<Element> &F, MontgomeryModule<Element> &M, Element &res, const Vector1 &x, const Vector2 &y,
+				  VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Dense);
+
+	template <class Vector1, class Vector2>
+	static Element &dot_impl (const ModularMontgomery<Element> &F, MontgomeryModule<Element> &M, Element &res, const Vector1 &x, const Vector2 &y,
+				  VectorRepresentationTypes::Dense, VectorRepresentationTypes::Sparse)
+		{ return op (F, M, res, y, x); }
+
+	template <class Vector1, class Vector2>
+	static Element &dot_impl (const ModularMontgomery<Element> &F, MontgomeryModule<Element> &M, Element &res, const Vector1 &x, const Vector2 &y,
+				  VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Sparse);
+
+	template <class Vector1, class Vector2>
+	static Element &dot_impl (const ModularMontgomery<Element> &F, MontgomeryModule<Element> &M, Element &res, const Vector1 &x, const Vector2 &y,
+				  VectorRepresentationTypes::Generic, VectorRepresentationTypes::Generic)
+		{ return _dot<ModularMontgomery<Element>, typename MontgomeryModule<Element>::Tag::Parent>::op (F, M, res, x, y); }
+
+public:
+	template <class Modules, class reference, class Vector1, class Vector2>
+	static reference &op (const ModularMontgomery<Element> &F, Modules &M, reference &res, const Vector1 &x, const Vector2 &y)
+		{ return dot_impl (F, M, res, x, y,
+				   typename VectorTraits<ModularMontgomery<Element>, Vector1>::RepresentationType (),
+				   typename VectorTraits<ModularMontgomery<Element>, Vector2>::RepresentationType ()); }
+
+	template <class Modules, class Iterator, class Accessor, class Vector1, class Vector2>
+	static Element &op (const ModularMontgomery<Element> &F, Modules &M, Property<Iterator, Accessor> res, const Vector1 &x, const Vector2 &y)
+		{ return dot_impl (F, M, res.ref (), x, y,
+				   typename VectorTraits<ModularMontgomery<Element>, Vector1>::RepresentationType (),
+				   typename VectorTraits<ModularMontgomery<Element>, Vector2>::RepresentationType ()); }
+};
+
+} // namespace BLAS1
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL1_MONTGOMERY_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
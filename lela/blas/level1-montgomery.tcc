@@ -0,0 +1,116 @@
+/* lela/blas/level1-montgomery.tcc
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Implementations of level 1 BLAS interface for Z/p with
+ * Montgomery-reduction
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL1_MONTGOMERY_TCC
+#define __BLAS_LEVEL1_MONTGOMERY_TCC
+
+#include "lela/blas/level1-montgomery.h"
+
+namespace LELA
+{
+
+namespace BLAS1
+{
+
+template <class Element>
+template <class Vector1, class Vector2>
+Element &_dot<ModularMontgomery<Element>, typename MontgomeryModule<Element>::Tag>::dot_impl
+	(const ModularMontgomery<Element> &F, MontgomeryModule<Element> &M, Element &res, const Vector1 &x, const Vector2 &y,
+	 VectorRepresentationTypes::Dense, VectorRepresentationTypes::Dense)
+{
+	lela_check (x.size () == y.size ());
+
+	typedef typename MontgomeryTraits<Element>::FatElement FatElement;
+
+	typename Vector1::const_iterator i = x.begin ();
+	typename Vector2::const_iterator j = y.begin ();
+
+	FatElement s = 0, t;
+
+	for (; i != x.end (); ++i, ++j) {
+		t = (FatElement) *i * (FatElement) *j;
+		s += t;
+
+		if (s < t)
+			s += F._r2;
+	}
+
+	return res = F.reduce (s);
+}
+
+template <class Element>
+template <class Vector1, class Vector2>
+Element &_dot<ModularMontgomery<Element>, typename MontgomeryModule<Element>::Tag>::dot_impl
+	(const ModularMontgomery<Element> &F, MontgomeryModule<Element> &M, Element &res, const Vector1 &x, const Vector2 &y,
+	 VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Dense)
+{
+	lela_check (VectorUtils::hasDim<ModularMontgomery<Element> > (x, y.size ()));
+
+	typedef typename MontgomeryTraits<Element>::FatElement FatElement;
+
+	typename Vector1::const_iterator i;
+
+	FatElement s = 0, t;
+
+	for (i = x.begin (); i != x.end (); ++i) {
+		t = (FatElement) i->second * (FatElement) y[i->first];
+		s += t;
+
+		if (s < t)
+			s += F._r2;
+	}
+
+	return res = F.reduce (s);
+}
+
+template <class Element>
+template <class Vector1, class Vector2>
+Element &_dot<ModularMontgomery<Element>, typename MontgomeryModule<Element>::Tag>::dot_impl
+	(const ModularMontgomery<Element> &F, MontgomeryModule<Element> &M, Element &res, const Vector1 &x, const Vector2 &y,
+	 VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Sparse)
+{
+	typedef typename MontgomeryTraits<Element>::FatElement FatElement;
+
+	typename Vector1::const_iterator i = x.begin ();
+	typename Vector2::const_iterator j = y.begin ();
+
+	FatElement s = 0, t;
+
+	for (; i != x.end () && j != y.end (); ++i) {
+		while (j != y.end () && j->first < i->first) ++j;
+
+		if (j != y.end () && i->first == j->first) {
+			t = (FatElement) i->second * (FatElement) j->second;
+			s += t;
+
+			if (s < t)
+				s += F._r2;
+		}
+	}
+
+	return res = F.reduce (s);
+}
+
+} // namespace BLAS1
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL1_MONTGOMERY_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,260 @@
+/* lela/blas/level1-simd.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Vectorised dot-product and axpy for Z/p, and row-addition for GF(2)
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL1_SIMD_H
+#define __BLAS_LEVEL1_SIMD_H
+
+#include <vector>
+#include <cstddef>
+
+#include "lela/integer.h"
+#include "lela/util/debug.h"
+#include "lela/blas/context.h"
+#include "lela/blas/level1-ll.h"
+#include "lela/vector/traits.h"
+
+namespace LELA
+{
+
+// Forward-declaration
+template <class _Element>
+class Modular;
+
+/** Instruction-sets for which there are vectorised kernels */
+enum SIMDInstructionSet { SIMD_NONE, SIMD_SSE41, SIMD_AVX2 };
+
+/** Most recent instruction-set supported both by the processor on
+ * which the program runs and by the kernels compiled into LELA
+ *
+ * \ingroup blas
+ */
+SIMDInstructionSet availableSIMDInstructionSet ();
+
+/** Vectorised kernels for Z/p
+ *
+ * Pointers to the kernels for the given element-type which suit the
+ * processor on which the program runs. A pointer is NULL if there is
+ * no kernel for the element-type, the modulus, or the processor.
+ *
+ * Kernels exist for uint8, uint16, and uint32 when LELA is built with
+ * support for x86 vector-instructions. The kernels for axpy require
+ * the modulus to be at most 2^31.
+ *
+ * \ingroup blas
+ */
+template <class Element>
+struct SIMDKernels
+{
+	/// Compute x^T y, reduced by the modulus, for vectors x and y of length n
+	Element (*dot) (const Element *x, const Element *y, size_t n, Element modulus);
+
+	/// Replace y by a x + y for vectors x and y of length n
+	void (*axpy) (Element a, const Element *x, Element *y, size_t n, Element modulus);
+
+	/// Instruction-set used by the kernels
+	SIMDInstructionSet instruction_set;
+
+	/** Select the kernels
+	 *
+	 * @param modulus Modulus of the ring
+	 * @param limit Most recent instruction-set which may be used
+	 */
+	SIMDKernels (Element modulus, SIMDInstructionSet limit = SIMD_AVX2)
+		: dot (NULL), axpy (NULL), instruction_set (SIMD_NONE) {}
+};
+
+template <> SIMDKernels<uint8>::SIMDKernels (uint8 modulus, SIMDInstructionSet limit);
+template <> SIMDKernels<uint16>::SIMDKernels (uint16 modulus, SIMDInstructionSet limit);
+template <> SIMDKernels<uint32>::SIMDKernels (uint32 modulus, SIMDInstructionSet limit);
+
+/** Vectorised kernel for GF(2)
+ *
+ * Rows of dense matrices over GF(2) are added by XORing their
+ * words. The kernel adds several rows to one row at once, so that the
+ * destination is loaded and stored only once. This is the inner loop
+ * of the Method of the Four Russians (see M4RMModule).
+ *
+ * Unlike the kernels for Z/p, the kernel is never NULL: a portable
+ * version is used when no instruction-set is available.
+ *
+ * \ingroup blas
+ */
+template <>
+struct SIMDKernels<bool>
+{
+	/// Replace y by y + x[0] + ... + x[k-1] for vectors of n words
+	void (*add_rows) (uint64 *y, const uint64 *const *x, size_t k, size_t n);
+
+	/// Instruction-set used by the kernel
+	SIMDInstructionSet instruction_set;
+
+	/** Select the kernel
+	 *
+	 * @param limit Most recent instruction-set which may be used
+	 */
+	SIMDKernels (SIMDInstructionSet limit = SIMD_AVX2);
+};
+
+/** Types of storage of dense vectors as far as the kernels are concerned */
+namespace SIMDStorageTypes
+{
+	/** Entries may not be adjacent in memory */
+	struct Generic {};
+
+	/** Entries are adjacent in memory, so the kernels may be used */
+	struct Contiguous {};
+}
+
+/** Storage of the dense vector with the given iterator-type */
+template <class Iterator>
+struct SIMDStorage { typedef SIMDStorageTypes::Generic Type; };
+
+template <> struct SIMDStorage<std::vector<uint8>::iterator> { typedef SIMDStorageTypes::Contiguous Type; };
+template <> struct SIMDStorage<std::vector<uint8>::const_iterator> { typedef SIMDStorageTypes::Contiguous Type; };
+template <> struct SIMDStorage<std::vector<uint16>::iterator> { typedef SIMDStorageTypes::Contiguous Type; };
+template <> struct SIMDStorage<std::vector<uint16>::const_iterator> { typedef SIMDStorageTypes::Contiguous Type; };
+template <> struct SIMDStorage<std::vector<uint32>::iterator> { typedef SIMDStorageTypes::Contiguous Type; };
+template <> struct SIMDStorage<std::vector<uint32>::const_iterator> { typedef SIMDStorageTypes::Contiguous Type; };
+
+template <class Ring, class ParentModule>
+struct SIMDModuleTag { typedef typename ParentModule::Tag Parent; };
+
+/** Module with vectorised kernels for Z/p
+ *
+ * This module computes dot-products and axpy of dense vectors whose
+ * entries are contiguous in memory (e.g. std::vector or rows of
+ * DenseMatrix) with the kernels of SIMDKernels. The products are
+ * accumulated without reduction in 64-bit lanes and only folded
+ * together and reduced by the modulus at the end of each block. All
+ * other operations, and all operations for which there is no kernel,
+ * are passed to the parent.
+ *
+ * It is part of AllModules<Modular<Element> >, directly above
+ * ZpModule, so all routines which work through dot-products or
+ * axpy benefit from it.
+ *
+ * \ingroup blas
+ */
+template <class Ring, class ParentModule>
+struct SIMDModule : public ParentModule
+{
+	typedef SIMDModuleTag<Ring, ParentModule> Tag;
+
+	/// Kernels to use; may be replaced to select a different instruction-set
+	SIMDKernels<typename Ring::Element> kernels;
+
+	SIMDModule (const Ring &R) : ParentModule (R), kernels (R._modulus) {}
+};
+
+namespace BLAS1
+{
+
+template <class Element, class ParentModule>
+class _dot<Modular<Element>, SIMDModuleTag<Modular<Element>, ParentModule> >
+{
+	template <class Modules, class T, class Vector1, class Vector2>
+	static T &dot_storage (const Modular<Element> &F, Modules &M, T &res, const Vector1 &x, const Vector2 &y,
+			       SIMDStorageTypes::Contiguous, SIMDStorageTypes::Contiguous)
+	{
+		lela_check (x.size () == y.size ());
+
+		const SIMDModule<Modular<Element>, ParentModule> &SM = M;
+
+		if (SM.kernels.dot == NULL || x.size () == 0)
+			return _dot<Modular<Element>, typename ParentModule::Tag>::op (F, M, res, x, y);
+
+		res = SM.kernels.dot (&*x.begin (), &*y.begin (), x.size (), F._modulus);
+
+		return res;
+	}
+
+	template <class Modules, class T, class Vector1, class Vector2, class Storage1, class Storage2>
+	static T &dot_storage (const Modular<Element> &F, Modules &M, T &res, const Vector1 &x, const Vector2 &y,
+			       Storage1, Storage2)
+		{ return _dot<Modular<Element>, typename ParentModule::Tag>::op (F, M, res, x, y); }
+
+	template <class Modules, class T, class Vector1, class Vector2>
+	static T &dot_impl (const Modular<Element> &F, Modules &M, T &res, const Vector1 &x, const Vector2 &y,
+			    VectorRepresentationTypes::Dense, VectorRepresentationTypes::Dense)
+		{ return dot_storage (F, M, res, x, y,
+				      typename SIMDStorage<typename Vector1::const_iterator>::Type (),
+				      typename SIMDStorage<typename Vector2::const_iterator>::Type ()); }
+
+	template <class Modules, class T, class Vector1, class Vector2>
+	static T &dot_impl (const Modular<Element> &F, Modules &M, T &res, const Vector1 &x, const Vector2 &y,
+			    VectorRepresentationTypes::Generic, VectorRepresentationTypes::Generic)
+		{ return _dot<Modular<Element>, typename ParentModule::Tag>::op (F, M, res, x, y); }
+
+public:
+	template <class Modules, class T, class Vector1, class Vector2>
+	static T &op (const Modular<Element> &F, Modules &M, T &res, const Vector1 &x, const Vector2 &y)
+		{ return dot_impl (F, M, res, x, y,
+				   typename VectorTraits<Modular<Element>, Vector1>::RepresentationType (),
+				   typename VectorTraits<Modular<Element>, Vector2>::RepresentationType ()); }
+};
+
+template <class Element, class ParentModule>
+class _axpy<Modular<Element>, SIMDModuleTag<Modular<Element>, ParentModule> >
+{
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &axpy_storage (const Modular<Element> &F, Modules &M, const Element &a, const Vector1 &x, Vector2 &y,
+				      SIMDStorageTypes::Contiguous, SIMDStorageTypes::Contiguous)
+	{
+		lela_check (x.size () == y.size ());
+
+		const SIMDModule<Modular<Element>, ParentModule> &SM = M;
+
+		if (SM.kernels.axpy == NULL || x.size () == 0)
+			return _axpy<Modular<Element>, typename ParentModule::Tag>::op (F, M, a, x, y);
+
+		SM.kernels.axpy (a, &*x.begin (), &*y.begin (), x.size (), F._modulus);
+
+		return y;
+	}
+
+	template <class Modules, class Vector1, class Vector2, class Storage1, class Storage2>
+	static Vector2 &axpy_storage (const Modular<Element> &F, Modules &M, const Element &a, const Vector1 &x, Vector2 &y,
+				      Storage1, Storage2)
+		{ return _axpy<Modular<Element>, typename ParentModule::Tag>::op (F, M, a, x, y); }
+
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &axpy_impl (const Modular<Element> &F, Modules &M, const Element &a, const Vector1 &x, Vector2 &y,
+				   VectorRepresentationTypes::Dense, VectorRepresentationTypes::Dense)
+		{ return axpy_storage (F, M, a, x, y,
+				       typename SIMDStorage<typename Vector1::const_iterator>::Type (),
+				       typename SIMDStorage<typename Vector2::iterator>::Type ()); }
+
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &axpy_impl (const Modular<Element> &F, Modules &M, const Element &a, const Vector1 &x, Vector2 &y,
+				   VectorRepresentationTypes::Generic, VectorRepresentationTypes::Generic)
+		{ return _axpy<Modular<Element>, typename ParentModule::Tag>::op (F, M, a, x, y); }
+
+public:
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &op (const Modular<Element> &F, Modules &M, const Element &a, const Vector1 &x, Vector2 &y)
+		{ return axpy_impl (F, M, a, x, y,
+				    typename VectorTraits<Modular<Element>, Vector1>::RepresentationType (),
+				    typename VectorTraits<Modular<Element>, Vector2>::RepresentationType ()); }
+};
+
+} // namespace BLAS1
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL1_SIMD_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,386 @@
+/* lela/blas/level1-sliced.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Level 1 BLAS for bit-sliced vectors over small prime fields
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL1_SLICED_H
+#define __BLAS_LEVEL1_SLICED_H
+
+#include <cstddef>
+
+#include "lela/integer.h"
+#include "lela/util/debug.h"
+#include "lela/blas/context.h"
+#include "lela/blas/level1-ll.h"
+#include "lela/vector/traits.h"
+#include "lela/vector/sliced-vector.h"
+
+namespace LELA
+{
+
+// Forward-declarations
+template <class _Element>
+class Modular;
+
+template <class Element>
+struct ModularTraits;
+
+template <class Ring, class ParentModule>
+struct SlicedModuleTag { typedef typename ParentModule::Tag Parent; };
+
+/** Module for bit-sliced vectors and matrices
+ *
+ * This module implements the level 1 BLAS on @ref SlicedVector and
+ * BLAS3::gemm on @ref SlicedMatrix with the word-parallel arithmetic
+ * of @ref SlicedArithmetic, and copies between bit-sliced and
+ * ordinary dense or sparse vectors. The other level 3 operations on a
+ * SlicedMatrix go through the generic row-wise implementations to
+ * the level 1 operations here. All other operations are passed to
+ * the parent.
+ *
+ * It is part of AllModules<Modular<Element> >. The characteristic of
+ * the ring must be less than 2^Planes for the vectors used.
+ *
+ * \ingroup blas
+ */
+template <class Ring, class ParentModule>
+struct SlicedModule : public ParentModule
+{
+	typedef SlicedModuleTag<Ring, ParentModule> Tag;
+
+	SlicedModule (const Ring &R) : ParentModule (R) {}
+};
+
+/** Arithmetic modulo a small prime on bit-sliced words
+ *
+ * A block is an array of Planes words, the k-th of which holds bit k
+ * of each of as many entries as a word has bits, as in @ref
+ * SlicedVector. Addition is a ripple-carry adder over the planes
+ * followed by a conditional subtraction of p; multiplication by a
+ * scalar is by doubling and adding; the dot-product counts the bits
+ * of the pairwise products of the planes. All operations take a
+ * whole range of blocks, and all map zero entries to zero, so the
+ * padding at the end of a vector stays zero.
+ *
+ * \ingroup blas
+ */
+template <size_t Planes, class Word>
+class SlicedArithmetic
+{
+	// Bits of p, each spread over a whole word
+	Word _p[Planes + 1];
+	unsigned int _modulus;
+
+	// z <- x + y, where z may be x or y
+	inline void add_block (Word *z, const Word *x, const Word *y) const
+	{
+		Word s[Planes + 1], d[Planes], t, carry = 0, borrow = 0;
+		size_t k;
+
+		for (k = 0; k < Planes; ++k) {
+			t = x[k] ^ y[k];
+			s[k] = t ^ carry;
+			carry = (x[k] & y[k]) | (carry & t);
+		}
+
+		s[Planes] = carry;
+
+		// Subtract p; where the subtraction borrows, s was less than p
+		for (k = 0; k < Planes; ++k) {
+			t = s[k] ^ _p[k];
+			d[k] = t ^ borrow;
+			borrow = (~s[k] & _p[k]) | (~t & borrow);
+		}
+
+		borrow = (~s[Planes] & _p[Planes]) | (~(s[Planes] ^ _p[Planes]) & borrow);
+
+		for (k = 0; k < Planes; ++k)
+			z[k] = (s[k] & borrow) | (d[k] & ~borrow);
+	}
+
+	// z <- -x, where z may be x
+	inline void neg_block (Word *z, const Word *x) const
+	{
+		Word nonzero = 0, borrow = 0, t;
+		size_t k;
+
+		for (k = 0; k < Planes; ++k)
+			nonzero |= x[k];
+
+		for (k = 0; k < Planes; ++k) {
+			t = _p[k] ^ x[k];
+			Word d = t ^ borrow;
+			borrow = (~_p[k] & x[k]) | (~t & borrow);
+			z[k] = d & nonzero;
+		}
+	}
+
+	// z <- a x for 0 < a < p, where z may not be x
+	inline void mul_block (Word *z, unsigned int a, const Word *x) const
+	{
+		Word t[Planes];
+		size_t k;
+
+		for (k = 0; k < Planes; ++k) {
+			t[k] = x[k];
+			z[k] = 0;
+		}
+
+		for (; a != 0; a >>= 1) {
+			if (a & 1)
+				add_block (z, z, t);
+
+			if (a > 1)
+				add_block (t, t, t);
+		}
+	}
+
+    public:
+	SlicedArithmetic (unsigned int modulus)
+		: _modulus (modulus)
+	{
+		lela_check (modulus < (1U << Planes));
+
+		for (size_t k = 0; k <= Planes; ++k)
+			_p[k] = ((modulus >> k) & 1) ? WordTraits<Word>::all_ones : 0;
+	}
+
+	unsigned int modulus () const { return _modulus; }
+
+	/// y <- x + y on the given number of blocks
+	void addin (Word *y, const Word *x, size_t blocks) const
+	{
+		for (; blocks > 0; --blocks, x += Planes, y += Planes)
+			add_block (y, x, y);
+	}
+
+	/// x <- a x on the given number of blocks, for a reduced modulo p
+	void mulin (Word *x, unsigned int a, size_t blocks) const
+	{
+		Word t[Planes];
+		size_t k;
+
+		if (a == 1)
+			return;
+
+		for (; blocks > 0; --blocks, x += Planes) {
+			if (a == 0) {
+				for (k = 0; k < Planes; ++k)
+					x[k] = 0;
+			}
+			else if (2 * a > _modulus) {
+				mul_block (t, _modulus - a, x);
+				neg_block (x, t);
+			} else {
+				mul_block (t, a, x);
+
+				for (k = 0; k < Planes; ++k)
+					x[k] = t[k];
+			}
+		}
+	}
+
+	/// y <- a x + y on the given number of blocks, for a reduced modulo p
+	void axpyin (Word *y, unsigned int a, const Word *x, size_t blocks) const
+	{
+		Word t[Planes];
+
+		if (a == 0)
+			return;
+		else if (a == 1)
+			addin (y, x, blocks);
+		else if (2 * a > _modulus) {
+			for (; blocks > 0; --blocks, x += Planes, y += Planes) {
+				mul_block (t, _modulus - a, x);
+				neg_block (t, t);
+				add_block (y, t, y);
+			}
+		} else {
+			for (; blocks > 0; --blocks, x += Planes, y += Planes) {
+				mul_block (t, a, x);
+				add_block (y, t, y);
+			}
+		}
+	}
+
+	/// Dot-product of the given number of blocks, reduced modulo p
+	unsigned int dot (const Word *x, const Word *y, size_t blocks) const
+	{
+		uint64 count[2 * Planes - 1];
+		size_t j, k;
+
+		for (j = 0; j < 2 * Planes - 1; ++j)
+			count[j] = 0;
+
+		for (; blocks > 0; --blocks, x += Planes, y += Planes)
+			for (j = 0; j < Planes; ++j)
+				for (k = 0; k < Planes; ++k)
+					count[j + k] += WordTraits<Word>::Popcount (x[j] & y[k]);
+
+		uint64 d = 0, c = 1;
+
+		for (j = 0; j < 2 * Planes - 1; ++j, c = (2 * c) % _modulus)
+			d = (d + (count[j] % _modulus) * c) % _modulus;
+
+		return (unsigned int) d;
+	}
+};
+
+/** Representative in 0, ..., p - 1 of an element, as held in the
+ * planes of a bit-sliced vector
+ *
+ * Modular<float> and Modular<double> store their elements in the
+ * symmetric range about zero, so the element may not be used
+ * directly.
+ */
+template <class Element>
+inline unsigned int sliced_rep (const Modular<Element> &F, Element a)
+	{ return (unsigned int) ModularTraits<Element>::positive_rep (a, F._modulus); }
+
+/** Element with the given representative in 0, ..., p - 1 */
+template <class Element>
+inline Element sliced_element (const Modular<Element> &F, unsigned int a)
+{
+	Element x = a;
+	return ModularTraits<Element>::valid_rep (x, F._modulus);
+}
+
+namespace BLAS1
+{
+
+template <class Element, class ParentModule>
+class _dot<Modular<Element>, SlicedModuleTag<Modular<Element>, ParentModule> >
+{
+public:
+	template <class Modules, class T, class Vector1, class Vector2>
+	static T &op (const Modular<Element> &F, Modules &M, T &res, const Vector1 &x, const Vector2 &y)
+		{ return _dot<Modular<Element>, typename ParentModule::Tag>::op (F, M, res, x, y); }
+
+	template <class Modules, class T, size_t Planes, class Endianness>
+	static T &op (const Modular<Element> &F, Modules &M, T &res, const SlicedVector<Planes, Endianness> &x, const SlicedVector<Planes, Endianness> &y);
+};
+
+template <class Element, class ParentModule>
+class _copy<Modular<Element>, SlicedModuleTag<Modular<Element>, ParentModule> >
+{
+	template <class Modules, class Vector1, size_t Planes, class Endianness>
+	static SlicedVector<Planes, Endianness> &copy_impl (const Modular<Element> &F, Modules &M, const Vector1 &x, SlicedVector<Planes, Endianness> &y,
+							    VectorRepresentationTypes::Dense);
+
+	template <class Modules, class Vector1, size_t Planes, class Endianness>
+	static SlicedVector<Planes, Endianness> &copy_impl (const Modular<Element> &F, Modules &M, const Vector1 &x, SlicedVector<Planes, Endianness> &y,
+							    VectorRepresentationTypes::Sparse);
+
+	template <class Modules, size_t Planes, class Endianness, class Vector2>
+	static Vector2 &copy_impl (const Modular<Element> &F, Modules &M, const SlicedVector<Planes, Endianness> &x, Vector2 &y,
+				   VectorRepresentationTypes::Dense);
+
+	template <class Modules, size_t Planes, class Endianness, class Vector2>
+	static Vector2 &copy_impl (const Modular<Element> &F, Modules &M, const SlicedVector<Planes, Endianness> &x, Vector2 &y,
+				   VectorRepresentationTypes::Sparse);
+
+public:
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &op (const Modular<Element> &F, Modules &M, const Vector1 &x, Vector2 &y)
+		{ return _copy<Modular<Element>, typename ParentModule::Tag>::op (F, M, x, y); }
+
+	template <class Modules, class Vector1, size_t Planes, class Endianness>
+	static SlicedVector<Planes, Endianness> &op (const Modular<Element> &F, Modules &M, const Vector1 &x, SlicedVector<Planes, Endianness> &y)
+		{ return copy_impl (F, M, x, y, typename VectorTraits<Modular<Element>, Vector1>::RepresentationType ()); }
+
+	template <class Modules, size_t Planes, class Endianness, class Vector2>
+	static Vector2 &op (const Modular<Element> &F, Modules &M, const SlicedVector<Planes, Endianness> &x, Vector2 &y)
+		{ return copy_impl (F, M, x, y, typename VectorTraits<Modular<Element>, Vector2>::RepresentationType ()); }
+
+	template <class Modules, size_t Planes, class Endianness>
+	static SlicedVector<Planes, Endianness> &op (const Modular<Element> &F, Modules &M, const SlicedVector<Planes, Endianness> &x, SlicedVector<Planes, Endianness> &y)
+	{
+		lela_check (x.size () == y.size ());
+		std::copy (x.word_begin (), x.word_end (), y.word_begin ());
+		return y;
+	}
+};
+
+template <class Element, class ParentModule>
+class _axpy<Modular<Element>, SlicedModuleTag<Modular<Element>, ParentModule> >
+{
+public:
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &op (const Modular<Element> &F, Modules &M, const Element &a, const Vector1 &x, Vector2 &y)
+		{ return _axpy<Modular<Element>, typename ParentModule::Tag>::op (F, M, a, x, y); }
+
+	template <class Modules, size_t Planes, class Endianness>
+	static SlicedVector<Planes, Endianness> &op (const Modular<Element> &F, Modules &M, const Element &a,
+						     const SlicedVector<Planes, Endianness> &x, SlicedVector<Planes, Endianness> &y);
+};
+
+template <class Element, class ParentModule>
+class _scal<Modular<Element>, SlicedModuleTag<Modular<Element>, ParentModule> >
+{
+public:
+	template <class Modules, class Vector>
+	static Vector &op (const Modular<Element> &F, Modules &M, const Element &a, Vector &x)
+		{ return _scal<Modular<Element>, typename ParentModule::Tag>::op (F, M, a, x); }
+
+	template <class Modules, size_t Planes, class Endianness>
+	static SlicedVector<Planes, Endianness> &op (const Modular<Element> &F, Modules &M, const Element &a, SlicedVector<Planes, Endianness> &x);
+};
+
+template <class Element, class ParentModule>
+class _equal<Modular<Element>, SlicedModuleTag<Modular<Element>, ParentModule> >
+{
+public:
+	template <class Modules, class Vector1, class Vector2>
+	static bool op (const Modular<Element> &F, Modules &M, const Vector1 &x, const Vector2 &y)
+		{ return _equal<Modular<Element>, typename ParentModule::Tag>::op (F, M, x, y); }
+
+	// The entries are reduced and the padding is zero, so equal
+	// vectors have equal words
+	template <class Modules, size_t Planes, class Endianness>
+	static bool op (const Modular<Element> &F, Modules &M, const SlicedVector<Planes, Endianness> &x, const SlicedVector<Planes, Endianness> &y)
+	{
+		lela_check (x.size () == y.size ());
+		return std::equal (x.word_begin (), x.word_end (), y.word_begin ());
+	}
+};
+
+template <class Element, class ParentModule>
+class _is_zero<Modular<Element>, SlicedModuleTag<Modular<Element>, ParentModule> >
+{
+public:
+	template <class Modules, class Vector>
+	static bool op (const Modular<Element> &F, Modules &M, const Vector &x)
+		{ return _is_zero<Modular<Element>, typename ParentModule::Tag>::op (F, M, x); }
+
+	template <class Modules, size_t Planes, class Endianness>
+	static bool op (const Modular<Element> &F, Modules &M, const SlicedVector<Planes, Endianness> &x)
+	{
+		for (typename SlicedVector<Planes, Endianness>::const_word_iterator i = x.word_begin (); i != x.word_end (); ++i)
+			if (*i != 0)
+				return false;
+
+		return true;
+	}
+};
+
+} // namespace BLAS1
+
+} // namespace LELA
+
+#include "lela/blas/level1-sliced.tcc"
+
+#endif // __BLAS_LEVEL1_SLICED_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
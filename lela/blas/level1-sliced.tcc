@@ -0,0 +1,204 @@
+/* lela/blas/level1-sliced.tcc
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Level 1 BLAS for bit-sliced vectors over small prime fields
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL1_SLICED_TCC
+#define __BLAS_LEVEL1_SLICED_TCC
+
+#include <algorithm>
+
+#include "lela/blas/level1-sliced.h"
+
+namespace LELA
+{
+
+namespace BLAS1
+{
+
+template <class Element, class ParentModule>
+template <class Modules, class T, size_t Planes, class Endianness>
+T &_dot<Modular<Element>, SlicedModuleTag<Modular<Element>, ParentModule> >::op
+	(const Modular<Element> &F, Modules &M, T &res, const SlicedVector<Planes, Endianness> &x, const SlicedVector<Planes, Endianness> &y)
+{
+	lela_check (x.size () == y.size ());
+
+	if (x.size () == 0)
+		return res = 0;
+
+	SlicedArithmetic<Planes, typename Endianness::word> Z ((unsigned int) F._modulus);
+
+	return res = sliced_element (F, Z.dot (&*x.word_begin (), &*y.word_begin (), x.word_size () / Planes));
+}
+
+// The entries of each block are collected into its planes before
+// they are written, so that each word is written once
+
+template <class Element, class ParentModule>
+template <class Modules, class Vector1, size_t Planes, class Endianness>
+SlicedVector<Planes, Endianness> &_copy<Modular<Element>, SlicedModuleTag<Modular<Element>, ParentModule> >::copy_impl
+	(const Modular<Element> &F, Modules &M, const Vector1 &x, SlicedVector<Planes, Endianness> &y,
+	 VectorRepresentationTypes::Dense)
+{
+	typedef typename Endianness::word Word;
+
+	lela_check (x.size () == y.size ());
+
+	typename Vector1::const_iterator i = x.begin ();
+	typename SlicedVector<Planes, Endianness>::word_iterator w;
+	Word block[Planes];
+	size_t k;
+	uint8 pos;
+
+	for (w = y.word_begin (); w != y.word_end (); w += Planes) {
+		for (k = 0; k < Planes; ++k)
+			block[k] = 0;
+
+		for (pos = 0; pos < WordTraits<Word>::bits && i != x.end (); ++pos, ++i) {
+			unsigned int a = sliced_rep (F, (Element) *i);
+
+			for (k = 0; k < Planes; ++k, a >>= 1)
+				if (a & 1)
+					block[k] |= Endianness::e_j (pos);
+		}
+
+		std::copy (block, block + Planes, w);
+	}
+
+	return y;
+}
+
+template <class Element, class ParentModule>
+template <class Modules, class Vector1, size_t Planes, class Endianness>
+SlicedVector<Planes, Endianness> &_copy<Modular<Element>, SlicedModuleTag<Modular<Element>, ParentModule> >::copy_impl
+	(const Modular<Element> &F, Modules &M, const Vector1 &x, SlicedVector<Planes, Endianness> &y,
+	 VectorRepresentationTypes::Sparse)
+{
+	std::fill (y.word_begin (), y.word_end (), 0);
+
+	for (typename Vector1::const_iterator i = x.begin (); i != x.end (); ++i) {
+		lela_check (i->first < y.size ());
+		y[i->first] = (uint8) sliced_rep (F, (Element) i->second);
+	}
+
+	return y;
+}
+
+template <class Element, class ParentModule>
+template <class Modules, size_t Planes, class Endianness, class Vector2>
+Vector2 &_copy<Modular<Element>, SlicedModuleTag<Modular<Element>, ParentModule> >::copy_impl
+	(const Modular<Element> &F, Modules &M, const SlicedVector<Planes, Endianness> &x, Vector2 &y,
+	 VectorRepresentationTypes::Dense)
+{
+	typedef typename Endianness::word Word;
+
+	lela_check (x.size () == y.size ());
+
+	typename SlicedVector<Planes, Endianness>::const_word_iterator w = x.word_begin ();
+	typename Vector2::iterator i = y.begin ();
+	size_t k;
+	uint8 pos;
+
+	for (; i != y.end (); w += Planes) {
+		for (pos = 0; pos < WordTraits<Word>::bits && i != y.end (); ++pos, ++i) {
+			unsigned int a = 0;
+
+			for (k = Planes; k-- > 0;)
+				a = (a << 1) | ((w[k] & Endianness::e_j (pos)) ? 1 : 0);
+
+			*i = sliced_element (F, a);
+		}
+	}
+
+	return y;
+}
+
+template <class Element, class ParentModule>
+template <class Modules, size_t Planes, class Endianness, class Vector2>
+Vector2 &_copy<Modular<Element>, SlicedModuleTag<Modular<Element>, ParentModule> >::copy_impl
+	(const Modular<Element> &F, Modules &M, const SlicedVector<Planes, Endianness> &x, Vector2 &y,
+	 VectorRepresentationTypes::Sparse)
+{
+	typedef typename Endianness::word Word;
+
+	typename SlicedVector<Planes, Endianness>::const_word_iterator w;
+	size_t idx, k;
+	uint8 pos;
+
+	y.clear ();
+
+	for (w = x.word_begin (), idx = 0; w != x.word_end (); w += Planes, idx += WordTraits<Word>::bits) {
+		Word nonzero = 0;
+
+		for (k = 0; k < Planes; ++k)
+			nonzero |= w[k];
+
+		if (nonzero == 0)
+			continue;
+
+		for (pos = 0; pos < WordTraits<Word>::bits; ++pos) {
+			if (nonzero & Endianness::e_j (pos)) {
+				unsigned int a = 0;
+
+				for (k = Planes; k-- > 0;)
+					a = (a << 1) | ((w[k] & Endianness::e_j (pos)) ? 1 : 0);
+
+				y.push_back (typename Vector2::value_type (idx + pos, sliced_element (F, a)));
+			}
+		}
+	}
+
+	return y;
+}
+
+template <class Element, class ParentModule>
+template <class Modules, size_t Planes, class Endianness>
+SlicedVector<Planes, Endianness> &_axpy<Modular<Element>, SlicedModuleTag<Modular<Element>, ParentModule> >::op
+	(const Modular<Element> &F, Modules &M, const Element &a, const SlicedVector<Planes, Endianness> &x, SlicedVector<Planes, Endianness> &y)
+{
+	lela_check (x.size () == y.size ());
+
+	if (x.size () == 0)
+		return y;
+
+	SlicedArithmetic<Planes, typename Endianness::word> Z ((unsigned int) F._modulus);
+
+	Z.axpyin (&*y.word_begin (), sliced_rep (F, a), &*x.word_begin (), x.word_size () / Planes);
+
+	return y;
+}
+
+template <class Element, class ParentModule>
+template <class Modules, size_t Planes, class Endianness>
+SlicedVector<Planes, Endianness> &_scal<Modular<Element>, SlicedModuleTag<Modular<Element>, ParentModule> >::op
+	(const Modular<Element> &F, Modules &M, const Element &a, SlicedVector<Planes, Endianness> &x)
+{
+	if (x.size () == 0)
+		return x;
+
+	SlicedArithmetic<Planes, typename Endianness::word> Z ((unsigned int) F._modulus);
+
+	Z.mulin (&*x.word_begin (), sliced_rep (F, a), x.word_size () / Planes);
+
+	return x;
+}
+
+} // namespace BLAS1
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL1_SLICED_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
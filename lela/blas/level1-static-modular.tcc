@@ -0,0 +1,122 @@
+/* lela/blas/level1-static-modular.tcc
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Implementations of level 1 BLAS interface for Z/p with a modulus
+ * fixed at compile-time
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL1_STATIC_MODULAR_TCC
+#define __BLAS_LEVEL1_STATIC_MODULAR_TCC
+
+#include <algorithm>
+
+#include "lela/blas/level1-static-modular.h"
+
+namespace LELA
+{
+
+namespace BLAS1
+{
+
+template <class Element, Element p>
+template <class Vector1, class Vector2>
+Element &_dot<StaticModular<Element, p>, typename StaticZpModule<Element, p>::Tag>::dot_impl
+	(const StaticModular<Element, p> &F, StaticZpModule<Element, p> &M, Element &res, const Vector1 &x, const Vector2 &y,
+	 VectorRepresentationTypes::Dense, VectorRepresentationTypes::Dense)
+{
+	lela_check (x.size () == y.size ());
+
+	typedef typename StaticZpModule<Element, p>::DoubleFatElement DoubleFatElement;
+
+	typename Vector1::const_iterator i = x.begin (), block_end;
+	typename Vector2::const_iterator j = y.begin ();
+
+	DoubleFatElement s = 0;
+
+	while (i != x.end ()) {
+		block_end = i + std::min<DoubleFatElement> (StaticZpModule<Element, p>::block_size, x.end () - i);
+
+		for (; i != block_end; ++i, ++j)
+			s += (DoubleFatElement) *i * (DoubleFatElement) *j;
+
+		s %= p;
+	}
+
+	return res = s;
+}
+
+template <class Element, Element p>
+template <class Vector1, class Vector2>
+Element &_dot<StaticModular<Element, p>, typename StaticZpModule<Element, p>::Tag>::dot_impl
+	(const StaticModular<Element, p> &F, StaticZpModule<Element, p> &M, Element &res, const Vector1 &x, const Vector2 &y,
+	 VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Dense)
+{
+	lela_check ((VectorUtils::hasDim<StaticModular<Element, p> > (x, y.size ())));
+
+	typedef typename StaticZpModule<Element, p>::DoubleFatElement DoubleFatElement;
+
+	typename Vector1::const_iterator i = x.begin (), block_end;
+
+	DoubleFatElement s = 0;
+
+	while (i != x.end ()) {
+		block_end = i + std::min<DoubleFatElement> (StaticZpModule<Element, p>::block_size, x.end () - i);
+
+		for (; i != block_end; ++i)
+			s += (DoubleFatElement) i->second * (DoubleFatElement) y[i->first];
+
+		s %= p;
+	}
+
+	return res = s;
+}
+
+template <class Element, Element p>
+template <class Vector1, class Vector2>
+Element &_dot<StaticModular<Element, p>, typename StaticZpModule<Element, p>::Tag>::dot_impl
+	(const StaticModular<Element, p> &F, StaticZpModule<Element, p> &M, Element &res, const Vector1 &x, const Vector2 &y,
+	 VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Sparse)
+{
+	typedef typename StaticZpModule<Element, p>::DoubleFatElement DoubleFatElement;
+
+	typename Vector1::const_iterator i = x.begin ();
+	typename Vector2::const_iterator j = y.begin ();
+
+	DoubleFatElement s = 0;
+	DoubleFatElement count = 0;
+
+	for (; i != x.end () && j != y.end (); ++i) {
+		while (j != y.end () && j->first < i->first) ++j;
+
+		if (j != y.end () && i->first == j->first) {
+			s += (DoubleFatElement) i->second * (DoubleFatElement) j->second;
+
+			if (++count == StaticZpModule<Element, p>::block_size) {
+				s %= p;
+				count = 0;
+			}
+		}
+	}
+
+	return res = s % p;
+}
+
+} // namespace BLAS1
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL1_STATIC_MODULAR_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
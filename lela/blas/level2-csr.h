@@ -0,0 +1,126 @@
+/* lela/blas/level2-csr.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Level 2 BLAS for matrices in compressed-sparse-row format
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL2_CSR_H
+#define __BLAS_LEVEL2_CSR_H
+
+#include "lela/util/debug.h"
+#include "lela/blas/context.h"
+#include "lela/blas/level1-ll.h"
+#include "lela/blas/level2-ll.h"
+#include "lela/vector/traits.h"
+
+namespace LELA
+{
+
+// Forward-declaration
+template <class _Element>
+class CSRMatrix;
+
+template <class Ring, class ParentModule>
+struct CSRModuleTag { typedef typename ParentModule::Tag Parent; };
+
+/** Module for matrices in compressed-sparse-row format
+ *
+ * This module computes products with a @ref CSRMatrix by running once
+ * through its arrays of indices and entries rather than through the
+ * generic row-iterators, and implements BLAS3::copy and BLAS3::scal
+ * with a CSRMatrix as output, which the generic implementations can
+ * not do since they cannot change the nonzero-structure of its rows.
+ * All other operations are passed to the parent.
+ *
+ * It is part of AllModules<Modular<Element> >, so that a CSRMatrix may
+ * be used with the default context, e.g. in @ref MatrixReader.
+ *
+ * \ingroup blas
+ */
+template <class Ring, class ParentModule>
+struct CSRModule : public ParentModule
+{
+	typedef CSRModuleTag<Ring, ParentModule> Tag;
+
+	CSRModule (const Ring &R) : ParentModule (R) {}
+};
+
+namespace BLAS2
+{
+
+template <class Ring, class ParentModule>
+class _gemv<Ring, CSRModuleTag<Ring, ParentModule> >
+{
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &gemv_impl (const Ring &F, Modules &M,
+				   const typename Ring::Element &a, const CSRMatrix<typename Ring::Element> &A, const Vector1 &x,
+				   const typename Ring::Element &b, Vector2 &y,
+				   VectorRepresentationTypes::Dense, VectorRepresentationTypes::Dense)
+	{
+		typedef CSRMatrix<typename Ring::Element> Matrix;
+
+		lela_check (x.size () == A.coldim ());
+		lela_check (y.size () == A.rowdim ());
+
+		const size_t *i_p = A.rowPointersBegin ();
+		const uint32 *idx_begin, *idx_end;
+		const typename Ring::Element *elt_begin;
+		typename Vector2::iterator j = y.begin ();
+
+		typename Ring::Element d;
+
+		for (; j != y.end (); ++j, ++i_p) {
+			idx_begin = A.indicesBegin () + i_p[0];
+			idx_end = A.indicesBegin () + i_p[1];
+			elt_begin = A.entriesBegin () + i_p[0];
+
+			typename Matrix::ConstRow row (idx_begin, idx_end, elt_begin);
+
+			BLAS1::_dot<Ring, typename ParentModule::Tag>::op (F, M, d, x, row);
+			F.mulin (*j, b);
+			F.axpyin (*j, a, d);
+		}
+
+		return y;
+	}
+
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &gemv_impl (const Ring &F, Modules &M,
+				   const typename Ring::Element &a, const CSRMatrix<typename Ring::Element> &A, const Vector1 &x,
+				   const typename Ring::Element &b, Vector2 &y,
+				   VectorRepresentationTypes::Generic, VectorRepresentationTypes::Generic)
+		{ return _gemv<Ring, typename ParentModule::Tag>::op (F, M, a, A, x, b, y); }
+
+public:
+	template <class Modules, class Matrix, class Vector1, class Vector2>
+	static Vector2 &op (const Ring &F, Modules &M,
+			    const typename Ring::Element &a, const Matrix &A, const Vector1 &x, const typename Ring::Element &b, Vector2 &y)
+		{ return _gemv<Ring, typename ParentModule::Tag>::op (F, M, a, A, x, b, y); }
+
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &op (const Ring &F, Modules &M,
+			    const typename Ring::Element &a, const CSRMatrix<typename Ring::Element> &A, const Vector1 &x,
+			    const typename Ring::Element &b, Vector2 &y)
+		{ return gemv_impl (F, M, a, A, x, b, y,
+				    typename VectorTraits<Ring, Vector1>::RepresentationType (),
+				    typename VectorTraits<Ring, Vector2>::RepresentationType ()); }
+};
+
+} // namespace BLAS2
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL2_CSR_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -111,6 +111,68 @@ public:
 				    typename VectorTraits<Modular<uint32>, Vector2>::RepresentationType ()); }
 };
 
+#ifdef __LELA_UINT128
+
+template <>
+class _gemv<Modular<uint64>, ZpModule<uint64>::Tag>
+{
+	template <class Matrix, class Vector1, class Vector2>
+	static Vector2 &gemv_col_dense (const Modular<uint64> &F, ZpModule<uint64> &M,
+					uint64 a, const Matrix &A, const Vector1 &x, uint64 b, Vector2 &y,
+					VectorRepresentationTypes::Dense,
+					VectorRepresentationTypes::Dense);
+
+	template <class Matrix, class Vector1, class Vector2>
+	static Vector2 &gemv_col_dense (const Modular<uint64> &F, ZpModule<uint64> &M,
+					uint64 a, const Matrix &A, const Vector1 &x, uint64 b, Vector2 &y,
+					VectorRepresentationTypes::Sparse,
+					VectorRepresentationTypes::Dense);
+
+	template <class Matrix, class Vector1, class Vector2>
+	static Vector2 &gemv_col_dense (const Modular<uint64> &F, ZpModule<uint64> &M,
+					uint64 a, const Matrix &A, const Vector1 &x, uint64 b, Vector2 &y,
+					VectorRepresentationTypes::Generic,
+					VectorRepresentationTypes::Generic)
+		{ return _gemv<Modular<uint64>, ZpModule<uint64>::Tag::Parent>::op (F, M, a, A, x, b, y); }
+
+	template <class Matrix, class Vector1, class Vector2>
+	static Vector2 &gemv_impl (const Modular<uint64> &F, ZpModule<uint64> &M,
+				   uint64 a, const Matrix &A, const Vector1 &x, uint64 b, Vector2 &y,
+				   MatrixIteratorTypes::Col,
+				   VectorRepresentationTypes::Dense,
+				   VectorRepresentationTypes::Generic)
+		{ return gemv_col_dense (F, M, a, A, x, b, y,
+					 typename VectorTraits<Modular<uint64>, typename Matrix::Column>::RepresentationType (),
+					 typename VectorTraits<Modular<uint64>, Vector2>::RepresentationType ()); }
+
+	template <class Matrix, class Vector1, class Vector2>
+	static Vector2 &gemv_impl (const Modular<uint64> &F, ZpModule<uint64> &M,
+				   uint64 a, const Matrix &A, const Vector1 &x, uint64 b, Vector2 &y,
+				   MatrixIteratorTypes::Generic,
+				   VectorRepresentationTypes::Generic,
+				   VectorRepresentationTypes::Generic)
+		{ return _gemv<Modular<uint64>, ZpModule<uint64>::Tag::Parent>::op (F, M, a, A, x, b, y); }
+
+	// Reduce the accumulated products in M._tmp after every block of M.block_size columns
+	static void reduce_tmp (const Modular<uint64> &F, ZpModule<uint64> &M, size_t &count);
+
+public:
+	template <class Modules, class Matrix, class Vector1, class Vector2>
+	static Vector2 &op (const Modular<uint64> &F,
+			    Modules               &M,
+			    uint64                 a,
+			    const Matrix          &A,
+			    const Vector1         &x,
+			    uint64                 b,
+			    Vector2               &y)
+		{ return gemv_impl (F, M, a, A, x, b, y,
+				    typename Matrix::IteratorType (),
+				    typename VectorTraits<Modular<uint64>, Vector1>::RepresentationType (),
+				    typename VectorTraits<Modular<uint64>, Vector2>::RepresentationType ()); }
+};
+
+#endif // __LELA_UINT128
+
 } // namespace BLAS2
 
 } // namespace LELA
@@ -165,6 +165,100 @@ Vector2 &_gemv<Modular<uint32>, ZpModule<uint32>::Tag>::gemv_col_dense (const Mo
 	return y;
 }
 
+#ifdef __LELA_UINT128
+
+inline void _gemv<Modular<uint64>, ZpModule<uint64>::Tag>::reduce_tmp (const Modular<uint64> &F, ZpModule<uint64> &M, size_t &count)
+{
+	if (++count == M.block_size) {
+		std::vector<uint128>::iterator l;
+
+		for (l = M._tmp.begin (); l != M._tmp.end (); ++l)
+			*l %= F._modulus;
+
+		count = 0;
+	}
+}
+
+template <class Matrix, class Vector1, class Vector2>
+Vector2 &_gemv<Modular<uint64>, ZpModule<uint64>::Tag>::gemv_col_dense (const Modular<uint64> &F, ZpModule<uint64> &M,
+									uint64 a, const Matrix &A, const Vector1 &x, uint64 b, Vector2 &y,
+									VectorRepresentationTypes::Dense,
+									VectorRepresentationTypes::Dense)
+{
+	lela_check (VectorUtils::hasDim<Modular<uint64> > (x, A.coldim ()));
+	lela_check (VectorUtils::hasDim<Modular<uint64> > (y, A.rowdim ()));
+
+	typename Matrix::ConstColIterator i = A.colBegin ();
+	typename Vector1::const_iterator j;
+	typename Matrix::ConstColumn::const_iterator k;
+	std::vector<uint128>::iterator l;
+
+	size_t count = 0;
+
+	M._tmp.resize (y.size ());
+	std::fill (M._tmp.begin (), M._tmp.end (), 0);
+
+	for (j = x.begin (); j != x.end (); ++j, ++i) {
+		for (k = i->begin (), l = M._tmp.begin (); k != i->end (); ++k, ++l)
+			*l += (uint128) *k * (uint128) *j;
+
+		reduce_tmp (F, M, count);
+	}
+
+	typename Vector2::iterator y_j;
+
+	for (y_j = y.begin (), l = M._tmp.begin (); y_j != y.end (); ++y_j, ++l) {
+		uint64 al, byj;
+
+		F.mul (al, a, uint64 (*l % F._modulus));
+		F.mul (byj, b, *y_j);
+		F.add (*y_j, al, byj);
+	}
+
+	return y;
+}
+
+template <class Matrix, class Vector1, class Vector2>
+Vector2 &_gemv<Modular<uint64>, ZpModule<uint64>::Tag>::gemv_col_dense (const Modular<uint64> &F, ZpModule<uint64> &M,
+									uint64 a, const Matrix &A, const Vector1 &x, uint64 b, Vector2 &y,
+									VectorRepresentationTypes::Sparse,
+									VectorRepresentationTypes::Dense)
+{
+	lela_check (VectorUtils::hasDim<Modular<uint64> > (x, A.coldim ()));
+	lela_check (VectorUtils::hasDim<Modular<uint64> > (y, A.rowdim ()));
+
+	typename Matrix::ConstColIterator i = A.colBegin ();
+	typename Vector1::const_iterator j;
+	typename Matrix::ConstColumn::const_iterator k;
+	std::vector<uint128>::iterator l;
+
+	size_t count = 0;
+
+	M._tmp.resize (y.size ());
+	std::fill (M._tmp.begin (), M._tmp.end (), 0);
+
+	for (j = x.begin (); j != x.end (); ++j, ++i) {
+		for (k = i->begin (); k != i->end (); ++k)
+			M._tmp[k->first] += (uint128) k->second * (uint128) *j;
+
+		reduce_tmp (F, M, count);
+	}
+
+	typename Vector2::iterator y_j;
+
+	for (y_j = y.begin (), l = M._tmp.begin (); y_j != y.end (); ++y_j, ++l) {
+		uint64 al, byj;
+
+		F.mul (al, a, uint64 (*l % F._modulus));
+		F.mul (byj, b, *y_j);
+		F.add (*y_j, al, byj);
+	}
+
+	return y;
+}
+
+#endif // __LELA_UINT128
+
 } // namespace BLAS2
 
 } // namespace LELA
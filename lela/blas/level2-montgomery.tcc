@@ -0,0 +1,131 @@
+/* lela/blas/level2-montgomery.tcc
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Implementations of level 2 BLAS interface for Z/p with
+ * Montgomery-reduction
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL2_MONTGOMERY_TCC
+#define __BLAS_LEVEL2_MONTGOMERY_TCC
+
+#include <algorithm>
+
+#include "lela/blas/level2-montgomery.h"
+
+namespace LELA
+{
+
+namespace BLAS2
+{
+
+template <class Element>
+template <class Vector2>
+Vector2 &_gemv<ModularMontgomery<Element>, typename MontgomeryModule<Element>::Tag>::finish
+	(const ModularMontgomery<Element> &F, MontgomeryModule<Element> &M, Element a, Element b, Vector2 &y)
+{
+	typename Vector2::iterator y_j;
+	typename std::vector<typename MontgomeryTraits<Element>::FatElement>::iterator l;
+
+	for (y_j = y.begin (), l = M._tmp.begin (); y_j != y.end (); ++y_j, ++l) {
+		Element al, byj;
+
+		F.mul (al, a, F.reduce (*l));
+		F.mul (byj, b, *y_j);
+		F.add (*y_j, al, byj);
+	}
+
+	return y;
+}
+
+template <class Element>
+template <class Matrix, class Vector1, class Vector2>
+Vector2 &_gemv<ModularMontgomery<Element>, typename MontgomeryModule<Element>::Tag>::gemv_col_dense
+	(const ModularMontgomery<Element> &F, MontgomeryModule<Element> &M,
+	 Element a, const Matrix &A, const Vector1 &x, Element b, Vector2 &y,
+	 VectorRepresentationTypes::Dense,
+	 VectorRepresentationTypes::Dense)
+{
+	lela_check (VectorUtils::hasDim<ModularMontgomery<Element> > (x, A.coldim ()));
+	lela_check (VectorUtils::hasDim<ModularMontgomery<Element> > (y, A.rowdim ()));
+
+	typedef typename MontgomeryTraits<Element>::FatElement FatElement;
+
+	typename Matrix::ConstColIterator i = A.colBegin ();
+	typename Vector1::const_iterator j;
+	typename Matrix::ConstColumn::const_iterator k;
+	typename std::vector<FatElement>::iterator l;
+
+	FatElement t;
+
+	M._tmp.resize (y.size ());
+	std::fill (M._tmp.begin (), M._tmp.end (), 0);
+
+	for (j = x.begin (); j != x.end (); ++j, ++i) {
+		for (k = i->begin (), l = M._tmp.begin (); k != i->end (); ++k, ++l) {
+			t = (FatElement) *k * (FatElement) *j;
+
+			*l += t;
+
+			if (*l < t)
+				*l += F._r2;
+		}
+	}
+
+	return finish (F, M, a, b, y);
+}
+
+template <class Element>
+template <class Matrix, class Vector1, class Vector2>
+Vector2 &_gemv<ModularMontgomery<Element>, typename MontgomeryModule<Element>::Tag>::gemv_col_dense
+	(const ModularMontgomery<Element> &F, MontgomeryModule<Element> &M,
+	 Element a, const Matrix &A, const Vector1 &x, Element b, Vector2 &y,
+	 VectorRepresentationTypes::Sparse,
+	 VectorRepresentationTypes::Dense)
+{
+	lela_check (VectorUtils::hasDim<ModularMontgomery<Element> > (x, A.coldim ()));
+	lela_check (VectorUtils::hasDim<ModularMontgomery<Element> > (y, A.rowdim ()));
+
+	typedef typename MontgomeryTraits<Element>::FatElement FatElement;
+
+	typename Matrix::ConstColIterator i = A.colBegin ();
+	typename Vector1::const_iterator j;
+	typename Matrix::ConstColumn::const_iterator k;
+
+	FatElement t;
+
+	M._tmp.resize (y.size ());
+	std::fill (M._tmp.begin (), M._tmp.end (), 0);
+
+	for (j = x.begin (); j != x.end (); ++j, ++i) {
+		for (k = i->begin (); k != i->end (); ++k) {
+			t = (FatElement) k->second * (FatElement) *j;
+
+			M._tmp[k->first] += t;
+
+			if (M._tmp[k->first] < t)
+				M._tmp[k->first] += F._r2;
+		}
+	}
+
+	return finish (F, M, a, b, y);
+}
+
+} // namespace BLAS2
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL2_MONTGOMERY_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
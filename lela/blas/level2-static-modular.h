@@ -0,0 +1,99 @@
+/* lela/blas/level2-static-modular.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Implementations of level 2 BLAS interface for Z/p with a modulus
+ * fixed at compile-time
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL2_STATIC_MODULAR_H
+#define __BLAS_LEVEL2_STATIC_MODULAR_H
+
+#include "lela/ring/static-modular.h"
+#include "lela/blas/context.h"
+#include "lela/vector/traits.h"
+#include "lela/matrix/traits.h"
+#include "lela/blas/level2-ll.h"
+
+namespace LELA
+{
+
+namespace BLAS2
+{
+
+template <class Element, Element p>
+class _gemv<StaticModular<Element, p>, typename StaticZpModule<Element, p>::Tag>
+{
+	template <class Matrix, class Vector1, class Vector2>
+	static Vector2 &gemv_col_dense (const StaticModular<Element, p> &F, StaticZpModule<Element, p> &M,
+					Element a, const Matrix &A, const Vector1 &x, Element b, Vector2 &y,
+					VectorRepresentationTypes::Dense,
+					VectorRepresentationTypes::Dense);
+
+	template <class Matrix, class Vector1, class Vector2>
+	static Vector2 &gemv_col_dense (const StaticModular<Element, p> &F, StaticZpModule<Element, p> &M,
+					Element a, const Matrix &A, const Vector1 &x, Element b, Vector2 &y,
+					VectorRepresentationTypes::Sparse,
+					VectorRepresentationTypes::Dense);
+
+	template <class Matrix, class Vector1, class Vector2>
+	static Vector2 &gemv_col_dense (const StaticModular<Element, p> &F, StaticZpModule<Element, p> &M,
+					Element a, const Matrix &A, const Vector1 &x, Element b, Vector2 &y,
+					VectorRepresentationTypes::Generic,
+					VectorRepresentationTypes::Generic)
+		{ return _gemv<StaticModular<Element, p>, typename StaticZpModule<Element, p>::Tag::Parent>::op (F, M, a, A, x, b, y); }
+
+	template <class Matrix, class Vector1, class Vector2>
+	static Vector2 &gemv_impl (const StaticModular<Element, p> &F, StaticZpModule<Element, p> &M,
+				   Element a, const Matrix &A, const Vector1 &x, Element b, Vector2 &y,
+				   MatrixIteratorTypes::Col,
+				   VectorRepresentationTypes::Dense,
+				   VectorRepresentationTypes::Generic)
+		{ return gemv_col_dense (F, M, a, A, x, b, y,
+					 typename VectorTraits<StaticModular<Element, p>, typename Matrix::Column>::RepresentationType (),
+					 typename VectorTraits<StaticModular<Element, p>, Vector2>::RepresentationType ()); }
+
+	template <class Matrix, class Vector1, class Vector2>
+	static Vector2 &gemv_impl (const StaticModular<Element, p> &F, StaticZpModule<Element, p> &M,
+				   Element a, const Matrix &A, const Vector1 &x, Element b, Vector2 &y,
+				   MatrixIteratorTypes::Generic,
+				   VectorRepresentationTypes::Generic,
+				   VectorRepresentationTypes::Generic)
+		{ return _gemv<StaticModular<Element, p>, typename StaticZpModule<Element, p>::Tag::Parent>::op (F, M, a, A, x, b, y); }
+
+	// Set y <- a * M._tmp + b * y, reducing the entries of M._tmp
+	template <class Vector2>
+	static Vector2 &finish (const StaticModular<Element, p> &F, StaticZpModule<Element, p> &M, Element a, Element b, Vector2 &y);
+
+public:
+	template <class Modules, class Matrix, class Vector1, class Vector2>
+	static Vector2 &op (const StaticModular<Element, p> &F,
+			    Modules                         &M,
+			    Element                          a,
+			    const Matrix                    &A,
+			    const Vector1                   &x,
+			    Element                          b,
+			    Vector2                         &y)
+		{ return gemv_impl (F, M, a, A, x, b, y,
+				    typename Matrix::IteratorType (),
+				    typename VectorTraits<StaticModular<Element, p>, Vector1>::RepresentationType (),
+				    typename VectorTraits<StaticModular<Element, p>, Vector2>::RepresentationType ()); }
+};
+
+} // namespace BLAS2
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL2_STATIC_MODULAR_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,134 @@
+/* lela/blas/level2-static-modular.tcc
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Implementations of level 2 BLAS interface for Z/p with a modulus
+ * fixed at compile-time
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL2_STATIC_MODULAR_TCC
+#define __BLAS_LEVEL2_STATIC_MODULAR_TCC
+
+#include <algorithm>
+
+#include "lela/blas/level2-static-modular.h"
+
+namespace LELA
+{
+
+namespace BLAS2
+{
+
+template <class Element, Element p>
+template <class Vector2>
+Vector2 &_gemv<StaticModular<Element, p>, typename StaticZpModule<Element, p>::Tag>::finish
+	(const StaticModular<Element, p> &F, StaticZpModule<Element, p> &M, Element a, Element b, Vector2 &y)
+{
+	typename Vector2::iterator y_j;
+	typename std::vector<typename StaticZpModule<Element, p>::DoubleFatElement>::iterator l;
+
+	for (y_j = y.begin (), l = M._tmp.begin (); y_j != y.end (); ++y_j, ++l) {
+		Element al, byj;
+
+		F.mul (al, a, Element (*l % p));
+		F.mul (byj, b, *y_j);
+		F.add (*y_j, al, byj);
+	}
+
+	return y;
+}
+
+template <class Element, Element p>
+template <class Matrix, class Vector1, class Vector2>
+Vector2 &_gemv<StaticModular<Element, p>, typename StaticZpModule<Element, p>::Tag>::gemv_col_dense
+	(const StaticModular<Element, p> &F, StaticZpModule<Element, p> &M,
+	 Element a, const Matrix &A, const Vector1 &x, Element b, Vector2 &y,
+	 VectorRepresentationTypes::Dense,
+	 VectorRepresentationTypes::Dense)
+{
+	lela_check ((VectorUtils::hasDim<StaticModular<Element, p> > (x, A.coldim ())));
+	lela_check ((VectorUtils::hasDim<StaticModular<Element, p> > (y, A.rowdim ())));
+
+	typedef typename StaticZpModule<Element, p>::DoubleFatElement DoubleFatElement;
+
+	typename Matrix::ConstColIterator i = A.colBegin ();
+	typename Vector1::const_iterator j;
+	typename Matrix::ConstColumn::const_iterator k;
+	typename std::vector<DoubleFatElement>::iterator l;
+
+	DoubleFatElement count = 0;
+
+	M._tmp.resize (y.size ());
+	std::fill (M._tmp.begin (), M._tmp.end (), 0);
+
+	for (j = x.begin (); j != x.end (); ++j, ++i) {
+		for (k = i->begin (), l = M._tmp.begin (); k != i->end (); ++k, ++l)
+			*l += (DoubleFatElement) *k * (DoubleFatElement) *j;
+
+		if (++count == StaticZpModule<Element, p>::block_size) {
+			for (l = M._tmp.begin (); l != M._tmp.end (); ++l)
+				*l %= p;
+
+			count = 0;
+		}
+	}
+
+	return finish (F, M, a, b, y);
+}
+
+template <class Element, Element p>
+template <class Matrix, class Vector1, class Vector2>
+Vector2 &_gemv<StaticModular<Element, p>, typename StaticZpModule<Element, p>::Tag>::gemv_col_dense
+	(const StaticModular<Element, p> &F, StaticZpModule<Element, p> &M,
+	 Element a, const Matrix &A, const Vector1 &x, Element b, Vector2 &y,
+	 VectorRepresentationTypes::Sparse,
+	 VectorRepresentationTypes::Dense)
+{
+	lela_check ((VectorUtils::hasDim<StaticModular<Element, p> > (x, A.coldim ())));
+	lela_check ((VectorUtils::hasDim<StaticModular<Element, p> > (y, A.rowdim ())));
+
+	typedef typename StaticZpModule<Element, p>::DoubleFatElement DoubleFatElement;
+
+	typename Matrix::ConstColIterator i = A.colBegin ();
+	typename Vector1::const_iterator j;
+	typename Matrix::ConstColumn::const_iterator k;
+	typename std::vector<DoubleFatElement>::iterator l;
+
+	DoubleFatElement count = 0;
+
+	M._tmp.resize (y.size ());
+	std::fill (M._tmp.begin (), M._tmp.end (), 0);
+
+	for (j = x.begin (); j != x.end (); ++j, ++i) {
+		for (k = i->begin (); k != i->end (); ++k)
+			M._tmp[k->first] += (DoubleFatElement) k->second * (DoubleFatElement) *j;
+
+		if (++count == StaticZpModule<Element, p>::block_size) {
+			for (l = M._tmp.begin (); l != M._tmp.end (); ++l)
+				*l %= p;
+
+			count = 0;
+		}
+	}
+
+	return finish (F, M, a, b, y);
+}
+
+} // namespace BLAS2
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL2_STATIC_MODULAR_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
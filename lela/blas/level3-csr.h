@@ -0,0 +1,196 @@
+/* lela/blas/level3-csr.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Level 3 BLAS for matrices in compressed-sparse-row format
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL3_CSR_H
+#define __BLAS_LEVEL3_CSR_H
+
+#include "lela/util/debug.h"
+#include "lela/blas/context.h"
+#include "lela/blas/level1-ll.h"
+#include "lela/blas/level2-csr.h"
+#include "lela/blas/level3-ll.h"
+#include "lela/vector/subvector.h"
+#include "lela/matrix/traits.h"
+#include "lela/matrix/sparse.h"
+#include "lela/matrix/csr.h"
+
+namespace LELA
+{
+
+namespace BLAS3
+{
+
+template <class Ring, class ParentModule>
+class _copy<Ring, CSRModuleTag<Ring, ParentModule> >
+{
+	template <class Modules, class Matrix1>
+	static CSRMatrix<typename Ring::Element> &copy_impl (const Ring &F, Modules &M, const Matrix1 &A, CSRMatrix<typename Ring::Element> &B,
+							     MatrixIteratorTypes::Row)
+	{
+		lela_check (A.rowdim () == B.rowdim ());
+		lela_check (A.coldim () == B.coldim ());
+		lela_check (!B.isAttached ());
+
+		typename Vector<Ring>::Sparse v;
+		typename Matrix1::ConstRowIterator i_A;
+		typename CSRMatrix<typename Ring::Element>::RowPointerVector::iterator i_p = B.rowPointers ().begin ();
+
+		B.indices ().clear ();
+		B.entries ().clear ();
+
+		for (i_A = A.rowBegin (); i_A != A.rowEnd (); ++i_A) {
+			BLAS1::_copy<Ring, typename Modules::Tag>::op (F, M, *i_A, v);
+
+			for (typename Vector<Ring>::Sparse::const_iterator j = v.begin (); j != v.end (); ++j) {
+				B.indices ().push_back (j->first);
+				B.entries ().push_back (j->second);
+			}
+
+			*++i_p = B.indices ().size ();
+		}
+
+		return B;
+	}
+
+	template <class Modules, class Matrix1>
+	static CSRMatrix<typename Ring::Element> &copy_impl (const Ring &F, Modules &M, const Matrix1 &A, CSRMatrix<typename Ring::Element> &B,
+							     MatrixIteratorTypes::Generic)
+	{
+		SparseMatrix<typename Ring::Element> T (A.rowdim (), A.coldim ());
+		_copy<Ring, typename ParentModule::Tag>::op (F, M, A, T);
+		return copy_impl (F, M, T, B, MatrixIteratorTypes::Row ());
+	}
+
+public:
+	template <class Modules, class Matrix1, class Matrix2>
+	static Matrix2 &op (const Ring &F, Modules &M, const Matrix1 &A, Matrix2 &B)
+		{ return _copy<Ring, typename ParentModule::Tag>::op (F, M, A, B); }
+
+	template <class Modules, class Matrix1>
+	static CSRMatrix<typename Ring::Element> &op (const Ring &F, Modules &M, const Matrix1 &A, CSRMatrix<typename Ring::Element> &B)
+		{ return copy_impl (F, M, A, B, typename Matrix1::IteratorType ()); }
+
+	template <class Modules>
+	static CSRMatrix<typename Ring::Element> &op (const Ring &F, Modules &M, const CSRMatrix<typename Ring::Element> &A, CSRMatrix<typename Ring::Element> &B)
+	{
+		lela_check (A.rowdim () == B.rowdim ());
+		lela_check (A.coldim () == B.coldim ());
+		lela_check (!B.isAttached ());
+
+		B.indices ().assign (A.indicesBegin (), A.indicesBegin () + A.size ());
+		B.entries ().assign (A.entriesBegin (), A.entriesBegin () + A.size ());
+		B.rowPointers ().assign (A.rowPointersBegin (), A.rowPointersBegin () + (A.rowdim () + 1));
+
+		return B;
+	}
+};
+
+template <class Ring, class ParentModule>
+class _scal<Ring, CSRModuleTag<Ring, ParentModule> >
+{
+public:
+	template <class Modules, class Matrix>
+	static Matrix &op (const Ring &F, Modules &M, const typename Ring::Element &a, Matrix &A)
+		{ return _scal<Ring, typename ParentModule::Tag>::op (F, M, a, A); }
+
+	template <class Modules>
+	static CSRMatrix<typename Ring::Element> &op (const Ring &F, Modules &M, const typename Ring::Element &a, CSRMatrix<typename Ring::Element> &A)
+	{
+		if (F.isZero (a) && !A.isAttached ())
+			A.clear ();
+		else {
+			Subvector<typename Ring::Element *, const typename Ring::Element *> v (A.entriesBegin (), A.entriesBegin () + A.size ());
+			BLAS1::_scal<Ring, typename Modules::Tag>::op (F, M, a, v);
+		}
+
+		return A;
+	}
+};
+
+template <class Ring, class ParentModule>
+class _gemm<Ring, CSRModuleTag<Ring, ParentModule> >
+{
+	template <class Modules, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_impl (const Ring &F, Modules &M,
+				   const typename Ring::Element &a, const CSRMatrix<typename Ring::Element> &A, const Matrix2 &B,
+				   const typename Ring::Element &b, Matrix3 &C,
+				   MatrixIteratorTypes::Row, MatrixIteratorTypes::Row, VectorRepresentationTypes::Dense)
+	{
+		lela_check (A.rowdim () == C.rowdim ());
+		lela_check (A.coldim () == B.rowdim ());
+		lela_check (B.coldim () == C.coldim ());
+
+		const size_t *i_p = A.rowPointersBegin ();
+		const uint32 *j_idx = A.indicesBegin ();
+		const typename Ring::Element *j_elt = A.entriesBegin ();
+		typename Matrix3::RowIterator i_C;
+
+		typename Ring::Element t;
+
+		for (i_C = C.rowBegin (); i_C != C.rowEnd (); ++i_C, ++i_p) {
+			BLAS1::_scal<Ring, typename Modules::Tag>::op (F, M, b, *i_C);
+
+			for (; j_idx != A.indicesBegin () + i_p[1]; ++j_idx, ++j_elt) {
+				F.mul (t, a, *j_elt);
+				BLAS1::_axpy<Ring, typename Modules::Tag>::op (F, M, t, *(B.rowBegin () + *j_idx), *i_C);
+			}
+		}
+
+		return C;
+	}
+
+	template <class Modules, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_impl (const Ring &F, Modules &M,
+				   const typename Ring::Element &a, const CSRMatrix<typename Ring::Element> &A, const Matrix2 &B,
+				   const typename Ring::Element &b, Matrix3 &C,
+				   MatrixIteratorTypes::Row, MatrixIteratorTypes::Row, VectorRepresentationTypes::Generic)
+		{ return _gemm<Ring, typename ParentModule::Tag>::op (F, M, a, A, B, b, C); }
+
+	template <class Modules, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_impl (const Ring &F, Modules &M,
+				   const typename Ring::Element &a, const CSRMatrix<typename Ring::Element> &A, const Matrix2 &B,
+				   const typename Ring::Element &b, Matrix3 &C,
+				   MatrixIteratorTypes::Row, MatrixIteratorTypes::Row)
+		{ return gemm_impl (F, M, a, A, B, b, C, MatrixIteratorTypes::Row (), MatrixIteratorTypes::Row (),
+				    typename VectorTraits<Ring, typename Matrix3::Row>::RepresentationType ()); }
+
+	template <class Modules, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_impl (const Ring &F, Modules &M,
+				   const typename Ring::Element &a, const CSRMatrix<typename Ring::Element> &A, const Matrix2 &B,
+				   const typename Ring::Element &b, Matrix3 &C,
+				   MatrixIteratorTypes::Generic, MatrixIteratorTypes::Generic)
+		{ return _gemm<Ring, typename ParentModule::Tag>::op (F, M, a, A, B, b, C); }
+
+public:
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &op (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
+		{ return _gemm<Ring, typename ParentModule::Tag>::op (F, M, a, A, B, b, C); }
+
+	template <class Modules, class Matrix2, class Matrix3>
+	static Matrix3 &op (const Ring &F, Modules &M,
+			    const typename Ring::Element &a, const CSRMatrix<typename Ring::Element> &A, const Matrix2 &B,
+			    const typename Ring::Element &b, Matrix3 &C)
+		{ return gemm_impl (F, M, a, A, B, b, C, typename Matrix2::IteratorType (), typename Matrix3::IteratorType ()); }
+};
+
+} // namespace BLAS3
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL3_CSR_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
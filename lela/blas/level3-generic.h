@@ -179,6 +179,16 @@ public:
 				    typename Matrix3::IteratorType ()); }
 };
 
+template <class Ring>
+class _gemm_overwrite<Ring, typename GenericModule<Ring>::Tag>
+{
+public:
+	// Without a module which makes use of it, A and B are just left intact
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &op (const Ring &F, Modules &M, const typename Ring::Element &a, Matrix1 &A, Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
+		{ return _gemm<Ring, typename Modules::Tag>::op (F, M, a, A, B, b, C); }
+};
+
 template <class Ring>
 class _trmm<Ring, typename GenericModule<Ring>::Tag>
 {
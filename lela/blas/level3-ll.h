@@ -57,6 +57,15 @@ public:
 		{ return _gemm<Ring, typename ModulesTag::Parent>::op (F, M, a, A, B, b, C); }
 };
 
+template <class Ring, class ModulesTag>
+class _gemm_overwrite
+{
+public:
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &op (const Ring &F, Modules &M, const typename Ring::Element &a, Matrix1 &A, Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
+		{ return _gemm_overwrite<Ring, typename ModulesTag::Parent>::op (F, M, a, A, B, b, C); }
+};
+
 template <class Ring, class ModulesTag>
 class _trmm
 {
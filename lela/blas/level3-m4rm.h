@@ -0,0 +1,192 @@
+/* lela/blas/level3-m4rm.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Matrix-multiplication over GF(2) by the Method of the Four Russians
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL3_M4RM_H
+#define __BLAS_LEVEL3_M4RM_H
+
+#ifdef __LELA_HAVE_M4RI
+#  error "This header file is only used if LELA is configured without libm4ri."
+#endif
+
+#include "lela/integer.h"
+#include "lela/blas/context.h"
+#include "lela/blas/level3-ll.h"
+#include "lela/matrix/traits.h"
+#include "lela/matrix/dense-zero-one.h"
+#include "lela/matrix/submatrix.h"
+#include "lela/vector/bit-iterator.h"
+
+namespace LELA
+{
+
+/** Words of a matrix over GF(2) whose rows are packed into words
+ *
+ * This describes the storage of a Dense01Matrix, or of a submatrix of
+ * one which begins on a word-boundary, so that routines can work
+ * directly on the words of the rows without copying the matrix.
+ *
+ * The last word of each row may be shared with columns outside the
+ * matrix, so routines must only change the positions in lastMask ()
+ * of that word.
+ *
+ * \ingroup blas
+ */
+template <class Word, class Endianness>
+struct PackedRows
+{
+	/// First word of the first row
+	Word *begin;
+
+	/// Displacement in words from one row to the next
+	size_t disp;
+
+	size_t rows;
+	size_t cols;
+
+	/// Number of words covering each row
+	size_t words () const
+		{ return (cols + WordTraits<uint64>::bits - 1) >> WordTraits<uint64>::logof_size; }
+
+	/// First word of the ith row
+	Word *row (size_t i) const
+		{ return begin + i * disp; }
+
+	/// Positions of the last word of each row which belong to the matrix
+	uint64 lastMask () const
+		{ return (cols & WordTraits<uint64>::pos_mask) ? Endianness::mask_left (cols & WordTraits<uint64>::pos_mask) : ~0ULL; }
+};
+
+/** Get the words of a matrix of packed bits
+ *
+ * @param A Matrix
+ * @param W PackedRows-object to be filled in
+ * @returns true if the rows of A begin on word-boundaries, so that W
+ * could be filled in, false otherwise
+ */
+template <class It, class CIt, class Endianness>
+bool getPackedRows (Dense01Matrix<It, CIt, Endianness> &A, PackedRows<uint64, Endianness> &W)
+{
+	W.begin = (A.rowdim () == 0) ? NULL : &*A.rowBegin ()->word_begin ();
+	W.disp = A.disp ();
+	W.rows = A.rowdim ();
+	W.cols = A.coldim ();
+	return true;
+}
+
+template <class It, class CIt, class Endianness>
+bool getPackedRows (const Dense01Matrix<It, CIt, Endianness> &A, PackedRows<const uint64, Endianness> &W)
+{
+	W.begin = (A.rowdim () == 0) ? NULL : &*A.rowBegin ()->word_begin ();
+	W.disp = A.disp ();
+	W.rows = A.rowdim ();
+	W.cols = A.coldim ();
+	return true;
+}
+
+// Restrict the words of the parent of a submatrix to the submatrix
+template <class Matrix, class Word, class Endianness>
+bool restrictPackedRows (const Matrix &A, PackedRows<Word, Endianness> &W)
+{
+	if (A.startCol () & WordTraits<uint64>::pos_mask)
+		return false;
+
+	W.begin += A.startRow () * W.disp + (A.startCol () >> WordTraits<uint64>::logof_size);
+	W.rows = A.rowdim ();
+	W.cols = A.coldim ();
+	return true;
+}
+
+template <class Matrix, class AlignedTrait, class Trait, class Endianness>
+bool getPackedRows (Submatrix<Matrix, AlignedTrait, Trait> &A, PackedRows<uint64, Endianness> &W)
+	{ return getPackedRows (A.parent (), W) && restrictPackedRows (A, W); }
+
+template <class Matrix, class AlignedTrait, class Trait, class Endianness>
+bool getPackedRows (const Submatrix<Matrix, AlignedTrait, Trait> &A, PackedRows<const uint64, Endianness> &W)
+	{ return getPackedRows (A.parent (), W) && restrictPackedRows (A, W); }
+
+/** Windows of a few consecutive positions of a word
+ *
+ * The Method of the Four Russians looks up rows in tables by the
+ * entries in a window of a few columns. These read such a window as
+ * an integer, independently of the endianness.
+ */
+template <class Endianness>
+struct PackedWindow;
+
+template <class word>
+struct PackedWindow<LittleEndian<word> >
+{
+	/// Entries at positions pos, ..., pos + len - 1 of w, as an integer
+	static inline unsigned extract (word w, unsigned pos, unsigned len)
+		{ return (unsigned) (w >> pos) & ((1U << len) - 1); }
+
+	/// Bit of the integer from extract () which holds position pos + t; also the inverse
+	static inline unsigned index (unsigned t, unsigned len)
+		{ return t; }
+};
+
+template <class word>
+struct PackedWindow<BigEndian<word> >
+{
+	static inline unsigned extract (word w, unsigned pos, unsigned len)
+		{ return (unsigned) ((w << pos) >> (WordTraits<word>::bits - len)); }
+
+	static inline unsigned index (unsigned t, unsigned len)
+		{ return len - 1 - t; }
+};
+
+namespace BLAS3
+{
+
+template <>
+class _gemm<GF2, M4RMModule::Tag>
+{
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_impl (const GF2 &F, Modules &M, bool a, const Matrix1 &A, const Matrix2 &B, bool b, Matrix3 &C,
+				   MatrixStorageTypes::Generic, MatrixStorageTypes::Generic, MatrixStorageTypes::Generic)
+		{ return _gemm<GF2, M4RMModule::Tag::Parent>::op (F, M, a, A, B, b, C); }
+
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_impl (const GF2 &F, Modules &M, bool a, const Matrix1 &A, const Matrix2 &B, bool b, Matrix3 &C,
+				   MatrixStorageTypes::Dense01, MatrixStorageTypes::Dense01, MatrixStorageTypes::Dense01);
+
+	// Fill in the table of all sums of the rows first, ..., first
+	// + 7 of B, restricted to the given words, in Gray-code order
+	template <class Endianness>
+	static void make_table (uint64 *T, const PackedRows<const uint64, Endianness> &B, size_t first, size_t start, size_t words);
+
+	// Add AB to C
+	template <class Endianness>
+	static void addmul (M4RMModule &M, const PackedRows<const uint64, Endianness> &A,
+			    const PackedRows<const uint64, Endianness> &B, PackedRows<uint64, Endianness> &C);
+
+public:
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &op (const GF2 &F, Modules &M, bool a, const Matrix1 &A, const Matrix2 &B, bool b, Matrix3 &C)
+		{ return gemm_impl (F, M, a, A, B, b, C,
+				    typename Matrix1::StorageType (),
+				    typename Matrix2::StorageType (),
+				    typename Matrix3::StorageType ()); }
+};
+
+} // namespace BLAS3
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL3_M4RM_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,160 @@
+/* lela/blas/level3-m4rm.tcc
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Matrix-multiplication over GF(2) by the Method of the Four Russians
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL3_M4RM_TCC
+#define __BLAS_LEVEL3_M4RM_TCC
+
+#include <algorithm>
+
+#include "lela/blas/level3-m4rm.h"
+#include "lela/blas/level3-ll.h"
+
+namespace LELA
+{
+
+namespace BLAS3
+{
+
+template <class Endianness>
+void _gemm<GF2, M4RMModule::Tag>::make_table (uint64 *T, const PackedRows<const uint64, Endianness> &B, size_t first, size_t start, size_t words)
+{
+	const size_t entries = 1UL << M4RMModule::table_bits;
+	const size_t valid = std::min ((size_t) M4RMModule::table_bits, B.rows - first);
+	const bool last = (start + words == B.words ());
+	const uint64 mask = B.lastMask ();
+
+	std::fill (T, T + words, 0ULL);
+
+	// Each entry differs from the one before it in Gray-code order
+	// by exactly one row of B
+	for (size_t i = 1; i < entries; ++i) {
+		size_t g = i ^ (i >> 1), g_prev = (i - 1) ^ ((i - 1) >> 1);
+		unsigned bit = 0;
+
+		while ((g ^ g_prev) != (1UL << bit))
+			++bit;
+
+		unsigned pos = PackedWindow<Endianness>::index (bit, M4RMModule::table_bits);
+		uint64 *dest = T + g * words;
+		const uint64 *src = T + g_prev * words;
+
+		if (pos < valid) {
+			const uint64 *row = B.row (first + pos) + start;
+
+			for (size_t j = 0; j < words; ++j)
+				dest[j] = src[j] ^ row[j];
+
+			if (last)
+				dest[words - 1] = src[words - 1] ^ (row[words - 1] & mask);
+		} else
+			std::copy (src, src + words, dest);
+	}
+}
+
+template <class Endianness>
+void _gemm<GF2, M4RMModule::Tag>::addmul (M4RMModule &M, const PackedRows<const uint64, Endianness> &A,
+					   const PackedRows<const uint64, Endianness> &B, PackedRows<uint64, Endianness> &C)
+{
+	const size_t entries = 1UL << M4RMModule::table_bits;
+	const size_t tables_per_word = WordTraits<uint64>::bits / M4RMModule::table_bits;
+	const size_t stripe_words = M4RMModule::stripe_words;
+	const size_t A_words = A.words (), B_words = B.words ();
+	const uint64 A_mask = A.lastMask ();
+
+	const uint64 *sources[WordTraits<uint64>::bits / M4RMModule::table_bits];
+
+	M._tables.resize (tables_per_word * entries * stripe_words);
+
+	// Work on stripes of the columns of B and C so that the tables stay in cache
+	for (size_t start = 0; start < B_words; start += stripe_words) {
+		size_t words = std::min (stripe_words, B_words - start);
+
+		// Each word of the rows of A selects up to 64 rows of B, which
+		// are covered by tables_per_word tables
+		for (size_t w = 0; w < A_words; ++w) {
+			size_t first = w << WordTraits<uint64>::logof_size;
+			size_t num_tables = (std::min ((size_t) WordTraits<uint64>::bits, A.cols - first) + M4RMModule::table_bits - 1) / M4RMModule::table_bits;
+			uint64 mask = (w == A_words - 1) ? A_mask : ~0ULL;
+			size_t t;
+
+			for (t = 0; t < num_tables; ++t)
+				make_table (&M._tables[t * entries * words], B, first + t * M4RMModule::table_bits, start, words);
+
+			for (size_t r = 0; r < A.rows; ++r) {
+				uint64 a = A.row (r)[w] & mask;
+				size_t num_sources = 0;
+
+				if (a == 0)
+					continue;
+
+				for (t = 0; t < num_tables; ++t) {
+					unsigned idx = PackedWindow<Endianness>::extract (a, t * M4RMModule::table_bits, M4RMModule::table_bits);
+
+					if (idx != 0)
+						sources[num_sources++] = &M._tables[(t * entries + idx) * words];
+				}
+
+				M.kernels.add_rows (C.row (r) + start, sources, num_sources, words);
+			}
+		}
+	}
+}
+
+template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+Matrix3 &_gemm<GF2, M4RMModule::Tag>::gemm_impl (const GF2 &F, Modules &M, bool a, const Matrix1 &A, const Matrix2 &B, bool b, Matrix3 &C,
+						 MatrixStorageTypes::Dense01, MatrixStorageTypes::Dense01, MatrixStorageTypes::Dense01)
+{
+	lela_check (A.coldim () == B.rowdim ());
+	lela_check (A.rowdim () == C.rowdim ());
+	lela_check (B.coldim () == C.coldim ());
+
+	typedef typename Matrix3::ContainerType::Rep::Endianness Endianness;
+
+	PackedRows<const uint64, Endianness> A_words, B_words;
+	PackedRows<uint64, Endianness> C_words;
+
+	if (!getPackedRows (A, A_words) || !getPackedRows (B, B_words) || !getPackedRows (C, C_words))
+		return _gemm<GF2, M4RMModule::Tag::Parent>::op (F, M, a, A, B, b, C);
+
+	if (C.rowdim () == 0 || C.coldim () == 0)
+		return C;
+
+	if (!b) {
+		size_t words = C_words.words ();
+		uint64 mask = C_words.lastMask ();
+
+		for (size_t r = 0; r < C_words.rows; ++r) {
+			std::fill (C_words.row (r), C_words.row (r) + (words - 1), 0ULL);
+			C_words.row (r)[words - 1] &= ~mask;
+		}
+	}
+
+	if (!a || A.coldim () == 0)
+		return C;
+
+	addmul (M, A_words, B_words, C_words);
+
+	return C;
+}
+
+} // namespace BLAS3
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL3_M4RM_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -11,13 +11,14 @@
 #ifndef __BLAS_LEVEL3_MODULAR_H
 #define __BLAS_LEVEL3_MODULAR_H
 
-// Disable this entire module if we don't have BLAS
-#ifdef __LELA_BLAS_AVAILABLE
-
 #include "lela/ring/modular.h"
 #include "lela/blas/context.h"
 #include "lela/matrix/traits.h"
-#include "lela/blas/level3-ll.h"
+
+// The float- and double-versions hand off to BLAS, so disable them if we don't have it
+#ifdef __LELA_BLAS_AVAILABLE
+#  include "lela/blas/level3-ll.h"
+#endif // __LELA_BLAS_AVAILABLE
 
 namespace LELA
 {
@@ -25,6 +26,8 @@ namespace LELA
 namespace BLAS3
 {
 
+#ifdef __LELA_BLAS_AVAILABLE
+
 template <>
 class _gemm<Modular<float>, ZpModule<float>::Tag>
 {
@@ -46,6 +49,8 @@ public:
 				    typename Matrix3::StorageType ()); }
 };
 
+#endif // __LELA_BLAS_AVAILABLE
+
 template <>
 class _gemm<Modular<double>, ZpModule<double>::Tag>
 {
@@ -58,6 +63,12 @@ class _gemm<Modular<double>, ZpModule<double>::Tag>
 	static Matrix3 &gemm_impl (const Modular<double> &F, Modules &M, double a, const Matrix1 &A, const Matrix2 &B, double b, Matrix3 &C,
 				   MatrixStorageTypes::Dense, MatrixStorageTypes::Dense, MatrixStorageTypes::Dense);
 
+#ifdef __LELA_BLAS_AVAILABLE
+	// Multiply with BLAS on strips of block_size - 1 columns of A, reducing C after each
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_blas (const Modular<double> &F, Modules &M, double ainvb, const Matrix1 &A, const Matrix2 &B, Matrix3 &C);
+#endif // __LELA_BLAS_AVAILABLE
+
 public:
 	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
 	static Matrix3 &op (const Modular<double> &F, Modules &M, double a, const Matrix1 &A, const Matrix2 &B, double b, Matrix3 &C)
@@ -67,12 +78,35 @@ public:
 				    typename Matrix3::StorageType ()); }
 };
 
+#ifdef __LELA_UINT128
+
+template <>
+class _gemm<Modular<uint64>, ZpModule<uint64>::Tag>
+{
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_impl (const Modular<uint64> &F, Modules &M, uint64 a, const Matrix1 &A, const Matrix2 &B, uint64 b, Matrix3 &C,
+				   MatrixStorageTypes::Generic, MatrixStorageTypes::Generic, MatrixStorageTypes::Generic)
+		{ return _gemm<Modular<uint64>, ZpModule<uint64>::Tag::Parent>::op (F, M, a, A, B, b, C); }
+
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_impl (const Modular<uint64> &F, Modules &M, uint64 a, const Matrix1 &A, const Matrix2 &B, uint64 b, Matrix3 &C,
+				   MatrixStorageTypes::Dense, MatrixStorageTypes::Dense, MatrixStorageTypes::Dense);
+
+public:
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &op (const Modular<uint64> &F, Modules &M, uint64 a, const Matrix1 &A, const Matrix2 &B, uint64 b, Matrix3 &C)
+		{ return gemm_impl (F, M, a, A, B, b, C,
+				    typename Matrix1::StorageType (),
+				    typename Matrix2::StorageType (),
+				    typename Matrix3::StorageType ()); }
+};
+
+#endif // __LELA_UINT128
+
 } // namespace BLAS3
 
 } // namespace LELA
 
-#endif // __LELA_BLAS_AVAILABLE
-
 #endif // __BLAS_LEVEL3_MODULAR_H
 
 // Local Variables:
@@ -11,8 +11,7 @@
 #ifndef __BLAS_LEVEL3_MODULAR_TCC
 #define __BLAS_LEVEL3_MODULAR_TCC
 
-// Disable this entire module if we don't have BLAS
-#ifdef __LELA_BLAS_AVAILABLE
+#include <algorithm>
 
 #include "lela/blas/level3-modular.h"
 
@@ -22,6 +21,8 @@ namespace LELA
 namespace BLAS3
 {
 
+#ifdef __LELA_BLAS_AVAILABLE
+
 template <class Modules, class Matrix1, class Matrix2, class Matrix3>
 Matrix3 &_gemm<Modular<float>, typename ZpModule<float>::Tag>::gemm_impl
 	(const Modular<float> &F, Modules &M, float a, const Matrix1 &A, const Matrix2 &B, float b, Matrix3 &C,
@@ -73,25 +74,9 @@ Matrix3 &_gemm<Modular<float>, typename ZpModule<float>::Tag>::gemm_impl
 }
 
 template <class Modules, class Matrix1, class Matrix2, class Matrix3>
-Matrix3 &_gemm<Modular<double>, typename ZpModule<double>::Tag>::gemm_impl
-	(const Modular<double> &F, Modules &M, double a, const Matrix1 &A, const Matrix2 &B, double b, Matrix3 &C,
-	 MatrixStorageTypes::Dense, MatrixStorageTypes::Dense, MatrixStorageTypes::Dense)
+Matrix3 &_gemm<Modular<double>, typename ZpModule<double>::Tag>::gemm_blas
+	(const Modular<double> &F, Modules &M, double ainvb, const Matrix1 &A, const Matrix2 &B, Matrix3 &C)
 {
-	lela_check (A.coldim () == B.rowdim ());
-	lela_check (A.rowdim () == C.rowdim ());
-	lela_check (B.coldim () == C.coldim ());
-
-	double ainvb;
-
-	if (M.block_size == 1 || !F.div (ainvb, b, a))
-		return _gemm<Modular<double>, typename ZpModule<double>::Tag::Parent>::op (F, M, a, A, B, b, C);
-
-	if (F.isZero (a) || A.coldim () == 0)
-		return _scal<Modular<double>, typename ZpModule<double>::Tag>::op (F, M, b, C);
-
-	if (C.coldim () == 0)
-		return C;
-
 	TypeWrapperRing<double> Rp;
 
 	size_t k, first_block_end = A.coldim () % (M.block_size - 1);
@@ -119,15 +104,107 @@ Matrix3 &_gemm<Modular<double>, typename ZpModule<double>::Tag>::gemm_impl
 			ModularTraits<double>::reduce (*i_C, *i_C, F._modulus);
 	}
 
-	return _scal<Modular<double>, typename ZpModule<double>::Tag>::op (F, M, a, C);
+	return C;
 }
 
-} // namespace BLAS3
+#endif // __LELA_BLAS_AVAILABLE
 
-} // namespace LELA
+template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+Matrix3 &_gemm<Modular<double>, typename ZpModule<double>::Tag>::gemm_impl
+	(const Modular<double> &F, Modules &M, double a, const Matrix1 &A, const Matrix2 &B, double b, Matrix3 &C,
+	 MatrixStorageTypes::Dense, MatrixStorageTypes::Dense, MatrixStorageTypes::Dense)
+{
+	lela_check (A.coldim () == B.rowdim ());
+	lela_check (A.rowdim () == C.rowdim ());
+	lela_check (B.coldim () == C.coldim ());
+
+	if (F.isZero (a) || A.coldim () == 0)
+		return _scal<Modular<double>, typename ZpModule<double>::Tag>::op (F, M, b, C);
+
+	if (C.rowdim () == 0 || C.coldim () == 0)
+		return C;
 
+#ifdef __LELA_BLAS_AVAILABLE
+	if (M.use_blas) {
+		double ainvb;
+
+		if (M.block_size == 1 || !F.div (ainvb, b, a))
+			return _gemm<Modular<double>, typename ZpModule<double>::Tag::Parent>::op (F, M, a, A, B, b, C);
+
+		// C <- a (A B + a^-1 b C)
+		gemm_blas (F, M, ainvb, A, B, C);
+		return _scal<Modular<double>, typename ZpModule<double>::Tag>::op (F, M, a, C);
+	}
 #endif // __LELA_BLAS_AVAILABLE
 
+	M.gemm_kernel.gemm (A.rowdim (), B.coldim (), A.coldim (), a, &A[0][0], A.disp (), &B[0][0], B.disp (),
+			    b, &C[0][0], C.disp (), F._modulus, M.block_size);
+
+	return C;
+}
+
+#ifdef __LELA_UINT128
+
+template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+Matrix3 &_gemm<Modular<uint64>, ZpModule<uint64>::Tag>::gemm_impl
+	(const Modular<uint64> &F, Modules &M, uint64 a, const Matrix1 &A, const Matrix2 &B, uint64 b, Matrix3 &C,
+	 MatrixStorageTypes::Dense, MatrixStorageTypes::Dense, MatrixStorageTypes::Dense)
+{
+	lela_check (A.coldim () == B.rowdim ());
+	lela_check (A.rowdim () == C.rowdim ());
+	lela_check (B.coldim () == C.coldim ());
+
+	typename Matrix1::ConstRowIterator i_A;
+	typename Matrix3::RowIterator i_C;
+	typename Matrix1::ConstRow::const_iterator j_A;
+	typename Matrix2::ConstRow::const_iterator j_B;
+	typename Matrix3::Row::iterator j_C;
+	std::vector<uint128>::iterator l;
+
+	M._tmp.resize (C.coldim ());
+
+	// Each row of C is accumulated unreduced in M._tmp, which is
+	// reduced only after each block of M.block_size rows of B
+	for (i_A = A.rowBegin (), i_C = C.rowBegin (); i_A != A.rowEnd (); ++i_A, ++i_C) {
+		size_t k, count = 0;
+
+		std::fill (M._tmp.begin (), M._tmp.end (), 0);
+
+		for (j_A = i_A->begin (), k = 0; j_A != i_A->end (); ++j_A, ++k) {
+			if (*j_A == 0)
+				continue;
+
+			typename Matrix2::ConstRowIterator i_B = B.rowBegin () + k;
+
+			for (j_B = i_B->begin (), l = M._tmp.begin (); j_B != i_B->end (); ++j_B, ++l)
+				*l += (uint128) *j_A * (uint128) *j_B;
+
+			if (++count == M.block_size) {
+				for (l = M._tmp.begin (); l != M._tmp.end (); ++l)
+					*l %= F._modulus;
+
+				count = 0;
+			}
+		}
+
+		for (j_C = i_C->begin (), l = M._tmp.begin (); j_C != i_C->end (); ++j_C, ++l) {
+			uint64 at, bc;
+
+			F.mul (at, a, uint64 (*l % F._modulus));
+			F.mul (bc, b, *j_C);
+			F.add (*j_C, at, bc);
+		}
+	}
+
+	return C;
+}
+
+#endif // __LELA_UINT128
+
+} // namespace BLAS3
+
+} // namespace LELA
+
 #endif // __BLAS_LEVEL3_MODULAR_TCC
 
 // Local Variables:
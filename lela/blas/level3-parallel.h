@@ -0,0 +1,242 @@
+/* lela/blas/level3-parallel.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Module which spreads matrix-multiplication over several threads
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL3_PARALLEL_H
+#define __BLAS_LEVEL3_PARALLEL_H
+
+#include <vector>
+
+#include "lela/integer.h"
+#include "lela/util/thread.h"
+#include "lela/blas/context.h"
+#include "lela/blas/level3-ll.h"
+#include "lela/matrix/traits.h"
+#include "lela/vector/traits.h"
+
+namespace LELA
+{
+
+template <class Ring, class ParentModule>
+struct ParallelModuleTag { typedef typename ParentModule::Tag Parent; };
+
+/** Parallel module
+ *
+ * This module cuts the output of gemm into a grid of panels, one
+ * for each thread, and computes each panel with the parent-module on
+ * its own thread. Each thread works with its own copy of the
+ * Modules-object, so temporary storage in the parent-modules (e.g.
+ * ZpModule::_tmp) is never shared.
+ *
+ * Only products whose output is a dense matrix are parallelised; all
+ * others are passed to the parent.
+ *
+ * Modules below this one may report through the commentator, but
+ * what they report from a worker-thread is discarded. The module may
+ * appear above or below StrassenModule, e.g.
+ *
+ *   ParallelModule<Ring, StrassenModule<Ring, ZpModule<Element> > >
+ *
+ * computes each panel with Strassen-Winograd.
+ *
+ * It is not part of AllModules; choose it explicitly through the
+ * Modules-parameter of Context.
+ *
+ * \ingroup blas
+ */
+template <class Ring, class ParentModule>
+struct ParallelModule : public ParentModule
+{
+	typedef ParallelModuleTag<Ring, ParentModule> Tag;
+
+	/// Threads on which to compute the panels
+	ThreadGroup threads;
+
+	/// Smallest row- resp. column-dimension of a panel; smaller products are not split
+	size_t cutoff;
+
+	static const size_t default_cutoff = 128;
+
+	/** Constructor
+	 *
+	 * @param R Ring
+	 * @param num_threads Number of threads; 0 for one per available processor
+	 * @param _cutoff Smallest dimension of a panel
+	 */
+	ParallelModule (const Ring &R, size_t num_threads = 0, size_t _cutoff = default_cutoff)
+		: ParentModule (R), threads (num_threads), cutoff (_cutoff) {}
+};
+
+namespace BLAS3
+{
+
+template <class Ring, class ParentModule>
+class _gemm<Ring, ParallelModuleTag<Ring, ParentModule> >
+{
+	// Compute one panel C_sub <- a A_sub B_sub + b C_sub on its own copy of the modules
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	class PanelJob : public ThreadGroup::Job
+	{
+		const Ring &_F;
+		const Modules &_M;
+		const typename Ring::Element &_a, &_b;
+		const Matrix1 &_A;
+		const Matrix2 &_B;
+		Matrix3 &_C;
+		size_t _row, _col, _rows, _cols;
+
+	public:
+		PanelJob (const Ring &F, const Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B,
+			  const typename Ring::Element &b, Matrix3 &C, size_t row, size_t col, size_t rows, size_t cols)
+			: _F (F), _M (M), _a (a), _b (b), _A (A), _B (B), _C (C), _row (row), _col (col), _rows (rows), _cols (cols) {}
+
+		void run ()
+		{
+			Modules M (_M);
+
+			typename Matrix1::ConstAlignedSubmatrixType A_sub (_A, _row, 0, _rows, _A.coldim ());
+			typename Matrix2::ConstAlignedSubmatrixType B_sub (_B, 0, _col, _B.rowdim (), _cols);
+			typename Matrix3::AlignedSubmatrixType C_sub (_C, _row, _col, _rows, _cols);
+
+			_gemm<Ring, typename ParentModule::Tag>::op (_F, M, _a, A_sub, B_sub, _b, C_sub);
+		}
+	};
+
+	// Find the grid of p_r x p_c panels, p_r p_c <= p, with
+	// panels as nearly square as possible and no panel smaller
+	// than the cutoff; returns false if the product should not be
+	// split
+	static bool choose_grid (size_t m, size_t n, size_t p, size_t cutoff, size_t &p_r, size_t &p_c)
+	{
+		for (; p > 1; --p) {
+			bool found = false;
+			size_t best = 0;
+
+			for (size_t r = 1; r <= p; ++r) {
+				if (p % r != 0 || m / r < cutoff || n / (p / r) < cutoff)
+					continue;
+
+				size_t h = m / r, w = n / (p / r), d = (h > w) ? h - w : w - h;
+
+				if (!found || d < best) {
+					found = true;
+					best = d;
+					p_r = r;
+					p_c = p / r;
+				}
+			}
+
+			if (found)
+				return true;
+		}
+
+		return false;
+	}
+
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_parallel (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
+	{
+		lela_check (A.coldim () == B.rowdim ());
+		lela_check (A.rowdim () == C.rowdim ());
+		lela_check (B.coldim () == C.coldim ());
+
+		ParallelModule<Ring, ParentModule> &PM = (ParallelModule<Ring, ParentModule> &) M;
+
+		const size_t row_align = const_lcm<Matrix1::rowAlign, Matrix3::rowAlign>::val;
+		const size_t col_align = const_lcm<Matrix2::colAlign, Matrix3::colAlign>::val;
+
+		size_t p_r = 1, p_c = 1;
+
+		if (!choose_grid (C.rowdim (), C.coldim (), PM.threads.size (), std::max (PM.cutoff, std::max (row_align, col_align)), p_r, p_c))
+			return _gemm<Ring, typename ParentModule::Tag>::op (F, M, a, A, B, b, C);
+
+		std::vector<size_t> row_bounds (p_r + 1), col_bounds (p_c + 1);
+		size_t i, j;
+
+		for (i = 0; i < p_r; ++i)
+			row_bounds[i] = row_align * ((i * C.rowdim () / p_r) / row_align);
+
+		row_bounds[p_r] = C.rowdim ();
+
+		for (j = 0; j < p_c; ++j)
+			col_bounds[j] = col_align * ((j * C.coldim () / p_c) / col_align);
+
+		col_bounds[p_c] = C.coldim ();
+
+		typedef PanelJob<Modules, Matrix1, Matrix2, Matrix3> Job;
+
+		std::vector<Job> panels;
+		std::vector<ThreadGroup::Job *> jobs;
+
+		panels.reserve (p_r * p_c);
+
+		for (i = 0; i < p_r; ++i)
+			for (j = 0; j < p_c; ++j)
+				if (row_bounds[i + 1] > row_bounds[i] && col_bounds[j + 1] > col_bounds[j])
+					panels.push_back (Job (F, M, a, A, B, b, C, row_bounds[i], col_bounds[j],
+							       row_bounds[i + 1] - row_bounds[i], col_bounds[j + 1] - col_bounds[j]));
+
+		for (typename std::vector<Job>::iterator k = panels.begin (); k != panels.end (); ++k)
+			jobs.push_back (&*k);
+
+		PM.threads.run (jobs);
+
+		return C;
+	}
+
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+				   VectorRepresentationTypes::Generic)
+		{ return _gemm<Ring, typename ParentModule::Tag>::op (F, M, a, A, B, b, C); }
+
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+				   VectorRepresentationTypes::Dense)
+		{ return gemm_parallel (F, M, a, A, B, b, C); }
+
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+				   VectorRepresentationTypes::Dense01)
+		{ return gemm_parallel (F, M, a, A, B, b, C); }
+
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+				   MatrixIteratorTypes::Row)
+		{ return gemm_impl (F, M, a, A, B, b, C, typename VectorTraits<Ring, typename Matrix3::Row>::RepresentationType ()); }
+
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+				   MatrixIteratorTypes::Col)
+		{ return _gemm<Ring, typename ParentModule::Tag>::op (F, M, a, A, B, b, C); }
+
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+				   MatrixIteratorTypes::RowCol)
+		{ return gemm_impl (F, M, a, A, B, b, C, typename VectorTraits<Ring, typename Matrix3::Row>::RepresentationType ()); }
+
+public:
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &op (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
+		{ return gemm_impl (F, M, a, A, B, b, C, typename Matrix3::IteratorType ()); }
+};
+
+} // namespace BLAS3
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL3_PARALLEL_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
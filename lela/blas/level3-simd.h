@@ -0,0 +1,85 @@
+/* lela/blas/level3-simd.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Cache-blocked, register-tiled matrix-multiplication for Modular<double>
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL3_SIMD_H
+#define __BLAS_LEVEL3_SIMD_H
+
+#include <cstddef>
+
+#include "lela/blas/level1-simd.h"
+
+namespace LELA
+{
+
+/** Kernel for matrix-multiplication over Z/p with a floating-point element-type
+ *
+ * The kernel computes C <- alpha A B + beta C for row-major matrices whose
+ * entries are the representatives in [-p/2, p/2] which Modular<double>
+ * uses. It follows the usual scheme of an optimised BLAS: panels of A
+ * and B are packed into contiguous buffers which fit into the cache,
+ * and a micro-kernel computes a small tile of C in registers. The
+ * tile is reduced by the modulus in the registers after each block
+ * of block_size - 1 products and once more before it is stored, so C
+ * is never reduced in a separate pass. Likewise alpha is applied as A
+ * is packed and beta as each tile of C is first loaded.
+ *
+ * The portable version is always available, so the kernel is never
+ * NULL. On x86 processors with AVX2 and FMA a vectorised
+ * micro-kernel is used.
+ *
+ * \ingroup blas
+ */
+template <class Element>
+struct SIMDGemmKernel;
+
+template <>
+struct SIMDGemmKernel<double>
+{
+	/** Replace C by alpha A B + beta C, reduced by the modulus
+	 *
+	 * @param m Row-dimension of A and C
+	 * @param n Column-dimension of B and C
+	 * @param k Column-dimension of A and row-dimension of B
+	 * @param alpha Coefficient of A B, reduced by the modulus
+	 * @param A Pointer to first entry of A
+	 * @param lda Distance between rows of A
+	 * @param B Pointer to first entry of B
+	 * @param ldb Distance between rows of B
+	 * @param beta Coefficient of C, reduced by the modulus
+	 * @param C Pointer to first entry of C
+	 * @param ldc Distance between rows of C
+	 * @param modulus Modulus p
+	 * @param block_size Number of products which may be added to an entry before it must be reduced
+	 */
+	void (*gemm) (size_t m, size_t n, size_t k, double alpha, const double *A, size_t lda, const double *B, size_t ldb,
+		      double beta, double *C, size_t ldc, double modulus, size_t block_size);
+
+	/// Instruction-set used by the kernel
+	SIMDInstructionSet instruction_set;
+
+	/** Select the kernel
+	 *
+	 * @param limit Most recent instruction-set which may be used
+	 */
+	SIMDGemmKernel (SIMDInstructionSet limit = SIMD_AVX2);
+};
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL3_SIMD_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
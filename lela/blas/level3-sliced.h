@@ -0,0 +1,57 @@
+/* lela/blas/level3-sliced.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Level 3 BLAS for bit-sliced matrices over small prime fields
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL3_SLICED_H
+#define __BLAS_LEVEL3_SLICED_H
+
+#include "lela/util/debug.h"
+#include "lela/blas/context.h"
+#include "lela/blas/level1-sliced.h"
+#include "lela/blas/level3-ll.h"
+#include "lela/matrix/sliced.h"
+
+namespace LELA
+{
+
+namespace BLAS3
+{
+
+template <class Element, class ParentModule>
+class _gemm<Modular<Element>, SlicedModuleTag<Modular<Element>, ParentModule> >
+{
+public:
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &op (const Modular<Element> &F, Modules &M, const Element &a, const Matrix1 &A, const Matrix2 &B, const Element &b, Matrix3 &C)
+		{ return _gemm<Modular<Element>, typename ParentModule::Tag>::op (F, M, a, A, B, b, C); }
+
+	template <class Modules, size_t Planes, class Endianness>
+	static SlicedMatrix<Planes, Endianness> &op (const Modular<Element> &F, Modules &M, const Element &a,
+						     const SlicedMatrix<Planes, Endianness> &A,
+						     const SlicedMatrix<Planes, Endianness> &B,
+						     const Element &b,
+						     SlicedMatrix<Planes, Endianness> &C);
+};
+
+} // namespace BLAS3
+
+} // namespace LELA
+
+#include "lela/blas/level3-sliced.tcc"
+
+#endif // __BLAS_LEVEL3_SLICED_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,116 @@
+/* lela/blas/level3-sliced.tcc
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Level 3 BLAS for bit-sliced matrices over small prime fields
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL3_SLICED_TCC
+#define __BLAS_LEVEL3_SLICED_TCC
+
+#include <vector>
+#include <algorithm>
+
+#include "lela/blas/level3-sliced.h"
+
+namespace LELA
+{
+
+namespace BLAS3
+{
+
+// Each row of C is computed by first adding each row of B into one
+// of p - 1 accumulators according to the entry of A which multiplies
+// it, and then adding the accumulators, each multiplied by a times
+// its entry, to b times the row of C. Apart from the p - 1 products
+// with scalars per row, the product then takes only additions of
+// whole rows.
+
+template <class Element, class ParentModule>
+template <class Modules, size_t Planes, class Endianness>
+SlicedMatrix<Planes, Endianness> &_gemm<Modular<Element>, SlicedModuleTag<Modular<Element>, ParentModule> >::op
+	(const Modular<Element> &F, Modules &M, const Element &a,
+	 const SlicedMatrix<Planes, Endianness> &A,
+	 const SlicedMatrix<Planes, Endianness> &B,
+	 const Element &b,
+	 SlicedMatrix<Planes, Endianness> &C)
+{
+	typedef typename Endianness::word Word;
+	typedef SlicedMatrix<Planes, Endianness> Matrix;
+
+	lela_check (A.rowdim () == C.rowdim ());
+	lela_check (A.coldim () == B.rowdim ());
+	lela_check (B.coldim () == C.coldim ());
+
+	if (C.rowdim () == 0 || C.coldim () == 0)
+		return C;
+
+	SlicedArithmetic<Planes, Word> Z ((unsigned int) F._modulus);
+
+	const unsigned int p = Z.modulus ();
+	const unsigned int rep_a = sliced_rep (F, a), rep_b = sliced_rep (F, b);
+	const size_t blocks = C[0].word_size () / Planes;
+
+	std::vector<Word> S ((p - 1) * blocks * Planes);
+	std::vector<bool> used (p - 1);
+
+	typename Matrix::ConstRowIterator i_A = A.rowBegin ();
+	typename Matrix::RowIterator i_C = C.rowBegin ();
+
+	for (; i_C != C.rowEnd (); ++i_A, ++i_C) {
+		std::fill (S.begin (), S.end (), 0);
+		std::fill (used.begin (), used.end (), false);
+
+		typename Matrix::Row::const_word_iterator w = i_A->word_begin ();
+		size_t j = 0, k;
+		uint8 pos;
+
+		for (; w != i_A->word_end (); w += Planes, j += WordTraits<Word>::bits) {
+			Word nonzero = 0;
+
+			for (k = 0; k < Planes; ++k)
+				nonzero |= w[k];
+
+			if (nonzero == 0)
+				continue;
+
+			for (pos = 0; pos < WordTraits<Word>::bits; ++pos) {
+				if (nonzero & Endianness::e_j (pos)) {
+					unsigned int v = 0;
+
+					for (k = Planes; k-- > 0;)
+						v = (v << 1) | ((w[k] & Endianness::e_j (pos)) ? 1 : 0);
+
+					Z.addin (&S[(v - 1) * blocks * Planes], &*B[j + pos].word_begin (), blocks);
+					used[v - 1] = true;
+				}
+			}
+		}
+
+		Z.mulin (&*i_C->word_begin (), rep_b, blocks);
+
+		for (unsigned int v = 1; v < p; ++v)
+			if (used[v - 1])
+				Z.axpyin (&*i_C->word_begin (), (v * rep_a) % p, &S[(v - 1) * blocks * Planes], blocks);
+	}
+
+	return C;
+}
+
+} // namespace BLAS3
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL3_SLICED_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
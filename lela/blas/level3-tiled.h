@@ -0,0 +1,171 @@
+/* lela/blas/level3-tiled.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Level 3 BLAS for dense matrices stored in tiles
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL3_TILED_H
+#define __BLAS_LEVEL3_TILED_H
+
+#include "lela/util/debug.h"
+#include "lela/blas/context.h"
+#include "lela/blas/level3-ll.h"
+#include "lela/matrix/traits.h"
+#include "lela/matrix/tiled-dense.h"
+
+namespace LELA
+{
+
+template <class Ring, class ParentModule>
+struct TiledModuleTag { typedef typename ParentModule::Tag Parent; };
+
+/** Module for dense matrices stored in tiles
+ *
+ * This module implements the level 3 BLAS on @ref TiledDenseMatrix
+ * by looping over the tiles and passing each operation on tiles,
+ * which are ordinary DenseMatrix, to the full set of modules, so
+ * that the kernels of the ring for dense matrices do the actual
+ * work. Products and triangular solves are arranged so that each
+ * tile of the output is finished before the next one is begun. All
+ * other operations are passed to the parent.
+ *
+ * It is part of AllModules<Modular<Element> > and AllModules<GF2>.
+ *
+ * \ingroup blas
+ */
+template <class Ring, class ParentModule>
+struct TiledModule : public ParentModule
+{
+	typedef TiledModuleTag<Ring, ParentModule> Tag;
+
+	TiledModule (const Ring &R) : ParentModule (R) {}
+};
+
+namespace BLAS3
+{
+
+template <class Ring, class ParentModule>
+class _copy<Ring, TiledModuleTag<Ring, ParentModule> >
+{
+public:
+	template <class Modules, class Matrix1, class Matrix2>
+	static Matrix2 &op (const Ring &F, Modules &M, const Matrix1 &A, Matrix2 &B)
+		{ return _copy<Ring, typename ParentModule::Tag>::op (F, M, A, B); }
+
+	template <class Modules, class Matrix1, size_t R, size_t C>
+	static TiledDenseMatrix<typename Ring::Element, R, C> &op (const Ring &F, Modules &M, const Matrix1 &A, TiledDenseMatrix<typename Ring::Element, R, C> &B);
+
+	template <class Modules, class Matrix2, size_t R, size_t C>
+	static Matrix2 &op (const Ring &F, Modules &M, const TiledDenseMatrix<typename Ring::Element, R, C> &A, Matrix2 &B);
+
+	template <class Modules, size_t R1, size_t C1, size_t R2, size_t C2>
+	static TiledDenseMatrix<typename Ring::Element, R2, C2> &op (const Ring &F, Modules &M, const TiledDenseMatrix<typename Ring::Element, R1, C1> &A,
+								     TiledDenseMatrix<typename Ring::Element, R2, C2> &B);
+
+	template <class Modules, size_t R, size_t C>
+	static TiledDenseMatrix<typename Ring::Element, R, C> &op (const Ring &F, Modules &M, const TiledDenseMatrix<typename Ring::Element, R, C> &A,
+								   TiledDenseMatrix<typename Ring::Element, R, C> &B);
+};
+
+template <class Ring, class ParentModule>
+class _scal<Ring, TiledModuleTag<Ring, ParentModule> >
+{
+public:
+	template <class Modules, class Matrix>
+	static Matrix &op (const Ring &F, Modules &M, const typename Ring::Element &a, Matrix &A)
+		{ return _scal<Ring, typename ParentModule::Tag>::op (F, M, a, A); }
+
+	template <class Modules, size_t R, size_t C>
+	static TiledDenseMatrix<typename Ring::Element, R, C> &op (const Ring &F, Modules &M, const typename Ring::Element &a,
+								   TiledDenseMatrix<typename Ring::Element, R, C> &A);
+};
+
+template <class Ring, class ParentModule>
+class _axpy<Ring, TiledModuleTag<Ring, ParentModule> >
+{
+public:
+	template <class Modules, class Matrix1, class Matrix2>
+	static Matrix2 &op (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B)
+		{ return _axpy<Ring, typename ParentModule::Tag>::op (F, M, a, A, B); }
+
+	template <class Modules, size_t R, size_t C>
+	static TiledDenseMatrix<typename Ring::Element, R, C> &op (const Ring &F, Modules &M, const typename Ring::Element &a,
+								   const TiledDenseMatrix<typename Ring::Element, R, C> &A,
+								   TiledDenseMatrix<typename Ring::Element, R, C> &B);
+};
+
+template <class Ring, class ParentModule>
+class _gemm<Ring, TiledModuleTag<Ring, ParentModule> >
+{
+public:
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &op (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
+		{ return _gemm<Ring, typename ParentModule::Tag>::op (F, M, a, A, B, b, C); }
+
+	template <class Modules, size_t R, size_t K, size_t N>
+	static TiledDenseMatrix<typename Ring::Element, R, N> &op (const Ring &F, Modules &M, const typename Ring::Element &a,
+								   const TiledDenseMatrix<typename Ring::Element, R, K> &A,
+								   const TiledDenseMatrix<typename Ring::Element, K, N> &B,
+								   const typename Ring::Element &b,
+								   TiledDenseMatrix<typename Ring::Element, R, N> &C);
+};
+
+template <class Ring, class ParentModule>
+class _trsm<Ring, TiledModuleTag<Ring, ParentModule> >
+{
+public:
+	template <class Modules, class Matrix1, class Matrix2>
+	static Matrix2 &op (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne)
+		{ return _trsm<Ring, typename ParentModule::Tag>::op (F, M, a, A, B, type, diagIsOne); }
+
+	template <class Modules, size_t T, size_t C>
+	static TiledDenseMatrix<typename Ring::Element, T, C> &op (const Ring &F, Modules &M, const typename Ring::Element &a,
+								   const TiledDenseMatrix<typename Ring::Element, T, T> &A,
+								   TiledDenseMatrix<typename Ring::Element, T, C> &B,
+								   TriangularMatrixType type, bool diagIsOne);
+};
+
+template <class Ring, class ParentModule>
+class _equal<Ring, TiledModuleTag<Ring, ParentModule> >
+{
+public:
+	template <class Modules, class Matrix1, class Matrix2>
+	static bool op (const Ring &F, Modules &M, const Matrix1 &A, const Matrix2 &B)
+		{ return _equal<Ring, typename ParentModule::Tag>::op (F, M, A, B); }
+
+	template <class Modules, size_t R, size_t C>
+	static bool op (const Ring &F, Modules &M, const TiledDenseMatrix<typename Ring::Element, R, C> &A, const TiledDenseMatrix<typename Ring::Element, R, C> &B);
+};
+
+template <class Ring, class ParentModule>
+class _is_zero<Ring, TiledModuleTag<Ring, ParentModule> >
+{
+public:
+	template <class Modules, class Matrix>
+	static bool op (const Ring &F, Modules &M, const Matrix &A)
+		{ return _is_zero<Ring, typename ParentModule::Tag>::op (F, M, A); }
+
+	template <class Modules, size_t R, size_t C>
+	static bool op (const Ring &F, Modules &M, const TiledDenseMatrix<typename Ring::Element, R, C> &A);
+};
+
+} // namespace BLAS3
+
+} // namespace LELA
+
+#include "lela/blas/level3-tiled.tcc"
+
+#endif // __BLAS_LEVEL3_TILED_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,267 @@
+/* lela/blas/level3-tiled.tcc
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Level 3 BLAS for dense matrices stored in tiles
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL3_TILED_TCC
+#define __BLAS_LEVEL3_TILED_TCC
+
+#include <algorithm>
+
+#include "lela/blas/level3-tiled.h"
+
+namespace LELA
+{
+
+namespace BLAS3
+{
+
+template <class Ring, class ParentModule>
+template <class Modules, class Matrix1, size_t R, size_t C>
+TiledDenseMatrix<typename Ring::Element, R, C> &_copy<Ring, TiledModuleTag<Ring, ParentModule> >::op
+	(const Ring &F, Modules &M, const Matrix1 &A, TiledDenseMatrix<typename Ring::Element, R, C> &B)
+{
+	lela_check (A.rowdim () == B.rowdim ());
+	lela_check (A.coldim () == B.coldim ());
+
+	for (size_t I = 0; I < B.tileRowdim (); ++I) {
+		for (size_t J = 0; J < B.tileColdim (); ++J) {
+			typename TiledDenseMatrix<typename Ring::Element, R, C>::Tile &T = B.tile (I, J);
+			typename Matrix1::ConstSubmatrixType A_IJ (A, I * R, J * C, T.rowdim (), T.coldim ());
+
+			_copy<Ring, typename Modules::Tag>::op (F, M, A_IJ, T);
+		}
+	}
+
+	return B;
+}
+
+template <class Ring, class ParentModule>
+template <class Modules, class Matrix2, size_t R, size_t C>
+Matrix2 &_copy<Ring, TiledModuleTag<Ring, ParentModule> >::op
+	(const Ring &F, Modules &M, const TiledDenseMatrix<typename Ring::Element, R, C> &A, Matrix2 &B)
+{
+	lela_check (A.rowdim () == B.rowdim ());
+	lela_check (A.coldim () == B.coldim ());
+
+	for (size_t I = 0; I < A.tileRowdim (); ++I) {
+		for (size_t J = 0; J < A.tileColdim (); ++J) {
+			const typename TiledDenseMatrix<typename Ring::Element, R, C>::Tile &T = A.tile (I, J);
+			typename Matrix2::SubmatrixType B_IJ (B, I * R, J * C, T.rowdim (), T.coldim ());
+
+			_copy<Ring, typename Modules::Tag>::op (F, M, T, B_IJ);
+		}
+	}
+
+	return B;
+}
+
+template <class Ring, class ParentModule>
+template <class Modules, size_t R1, size_t C1, size_t R2, size_t C2>
+TiledDenseMatrix<typename Ring::Element, R2, C2> &_copy<Ring, TiledModuleTag<Ring, ParentModule> >::op
+	(const Ring &F, Modules &M, const TiledDenseMatrix<typename Ring::Element, R1, C1> &A, TiledDenseMatrix<typename Ring::Element, R2, C2> &B)
+{
+	lela_check (A.rowdim () == B.rowdim ());
+	lela_check (A.coldim () == B.coldim ());
+
+	typedef typename TiledDenseMatrix<typename Ring::Element, R1, C1>::Tile Tile1;
+	typedef typename TiledDenseMatrix<typename Ring::Element, R2, C2>::Tile Tile2;
+
+	// Each tile of B is covered by rectangular pieces of tiles of
+	// A, which are copied through submatrices of both
+	for (size_t I = 0; I < B.tileRowdim (); ++I) {
+		for (size_t J = 0; J < B.tileColdim (); ++J) {
+			Tile2 &T_B = B.tile (I, J);
+
+			size_t row_begin = I * R2, row_end = row_begin + T_B.rowdim ();
+			size_t col_begin = J * C2, col_end = col_begin + T_B.coldim ();
+
+			for (size_t i = row_begin; i < row_end; i = (i / R1 + 1) * R1) {
+				size_t rows = std::min ((i / R1 + 1) * R1, row_end) - i;
+
+				for (size_t j = col_begin; j < col_end; j = (j / C1 + 1) * C1) {
+					size_t cols = std::min ((j / C1 + 1) * C1, col_end) - j;
+
+					const Tile1 &T_A = A.tile (i / R1, j / C1);
+
+					typename Tile1::ConstSubmatrixType A_sub (T_A, i % R1, j % C1, rows, cols);
+					typename Tile2::SubmatrixType B_sub (T_B, i - row_begin, j - col_begin, rows, cols);
+
+					_copy<Ring, typename Modules::Tag>::op (F, M, A_sub, B_sub);
+				}
+			}
+		}
+	}
+
+	return B;
+}
+
+template <class Ring, class ParentModule>
+template <class Modules, size_t R, size_t C>
+TiledDenseMatrix<typename Ring::Element, R, C> &_copy<Ring, TiledModuleTag<Ring, ParentModule> >::op
+	(const Ring &F, Modules &M, const TiledDenseMatrix<typename Ring::Element, R, C> &A, TiledDenseMatrix<typename Ring::Element, R, C> &B)
+{
+	lela_check (A.rowdim () == B.rowdim ());
+	lela_check (A.coldim () == B.coldim ());
+
+	typename TiledDenseMatrix<typename Ring::Element, R, C>::ConstTileIterator i_A;
+	typename TiledDenseMatrix<typename Ring::Element, R, C>::TileIterator i_B;
+
+	for (i_A = A.tileBegin (), i_B = B.tileBegin (); i_A != A.tileEnd (); ++i_A, ++i_B)
+		_copy<Ring, typename Modules::Tag>::op (F, M, *i_A, *i_B);
+
+	return B;
+}
+
+template <class Ring, class ParentModule>
+template <class Modules, size_t R, size_t C>
+TiledDenseMatrix<typename Ring::Element, R, C> &_scal<Ring, TiledModuleTag<Ring, ParentModule> >::op
+	(const Ring &F, Modules &M, const typename Ring::Element &a, TiledDenseMatrix<typename Ring::Element, R, C> &A)
+{
+	typename TiledDenseMatrix<typename Ring::Element, R, C>::TileIterator i;
+
+	for (i = A.tileBegin (); i != A.tileEnd (); ++i)
+		_scal<Ring, typename Modules::Tag>::op (F, M, a, *i);
+
+	return A;
+}
+
+template <class Ring, class ParentModule>
+template <class Modules, size_t R, size_t C>
+TiledDenseMatrix<typename Ring::Element, R, C> &_axpy<Ring, TiledModuleTag<Ring, ParentModule> >::op
+	(const Ring &F, Modules &M, const typename Ring::Element &a,
+	 const TiledDenseMatrix<typename Ring::Element, R, C> &A, TiledDenseMatrix<typename Ring::Element, R, C> &B)
+{
+	lela_check (A.rowdim () == B.rowdim ());
+	lela_check (A.coldim () == B.coldim ());
+
+	typename TiledDenseMatrix<typename Ring::Element, R, C>::ConstTileIterator i_A;
+	typename TiledDenseMatrix<typename Ring::Element, R, C>::TileIterator i_B;
+
+	for (i_A = A.tileBegin (), i_B = B.tileBegin (); i_A != A.tileEnd (); ++i_A, ++i_B)
+		_axpy<Ring, typename Modules::Tag>::op (F, M, a, *i_A, *i_B);
+
+	return B;
+}
+
+// Each tile of C is computed completely, from the row of tiles of A
+// and the column of tiles of B, before going on to the next, so that
+// it stays in the cache. The first product scales C_IJ by b.
+
+template <class Ring, class ParentModule>
+template <class Modules, size_t R, size_t K, size_t N>
+TiledDenseMatrix<typename Ring::Element, R, N> &_gemm<Ring, TiledModuleTag<Ring, ParentModule> >::op
+	(const Ring &F, Modules &M, const typename Ring::Element &a,
+	 const TiledDenseMatrix<typename Ring::Element, R, K> &A,
+	 const TiledDenseMatrix<typename Ring::Element, K, N> &B,
+	 const typename Ring::Element &b,
+	 TiledDenseMatrix<typename Ring::Element, R, N> &C)
+{
+	lela_check (A.rowdim () == C.rowdim ());
+	lela_check (A.coldim () == B.rowdim ());
+	lela_check (B.coldim () == C.coldim ());
+
+	if (A.tileColdim () == 0 || F.isZero (a))
+		return _scal<Ring, typename Modules::Tag>::op (F, M, b, C);
+
+	for (size_t I = 0; I < C.tileRowdim (); ++I) {
+		for (size_t J = 0; J < C.tileColdim (); ++J) {
+			_gemm<Ring, typename Modules::Tag>::op (F, M, a, A.tile (I, 0), B.tile (0, J), b, C.tile (I, J));
+
+			for (size_t L = 1; L < A.tileColdim (); ++L)
+				_gemm<Ring, typename Modules::Tag>::op (F, M, a, A.tile (I, L), B.tile (L, J), F.one (), C.tile (I, J));
+		}
+	}
+
+	return C;
+}
+
+// Block-substitution over the rows of tiles of B, with the tiles on
+// the diagonal of A solved by the parent. The first product with a
+// solved row of tiles scales the current row of tiles by a, as in the
+// generic trsm.
+
+template <class Ring, class ParentModule>
+template <class Modules, size_t T, size_t C>
+TiledDenseMatrix<typename Ring::Element, T, C> &_trsm<Ring, TiledModuleTag<Ring, ParentModule> >::op
+	(const Ring &F, Modules &M, const typename Ring::Element &a,
+	 const TiledDenseMatrix<typename Ring::Element, T, T> &A,
+	 TiledDenseMatrix<typename Ring::Element, T, C> &B,
+	 TriangularMatrixType type, bool diagIsOne)
+{
+	lela_check (A.coldim () == B.rowdim ());
+	lela_check (A.rowdim () == B.rowdim ());
+
+	const size_t n = A.tileRowdim ();
+
+	if (n == 0)
+		return B;
+	else if (F.isZero (a))
+		return _scal<Ring, typename Modules::Tag>::op (F, M, a, B);
+
+	for (size_t s = 0; s < n; ++s) {
+		size_t I = (type == LowerTriangular) ? s : n - 1 - s;
+
+		for (size_t J = 0; J < B.tileColdim (); ++J) {
+			for (size_t t = 0; t < s; ++t) {
+				size_t L = (type == LowerTriangular) ? t : n - 1 - t;
+				_gemm<Ring, typename Modules::Tag>::op (F, M, F.minusOne (), A.tile (I, L), B.tile (L, J), (t == 0) ? a : F.one (), B.tile (I, J));
+			}
+
+			_trsm<Ring, typename Modules::Tag>::op (F, M, (s == 0) ? a : F.one (), A.tile (I, I), B.tile (I, J), type, diagIsOne);
+		}
+	}
+
+	return B;
+}
+
+template <class Ring, class ParentModule>
+template <class Modules, size_t R, size_t C>
+bool _equal<Ring, TiledModuleTag<Ring, ParentModule> >::op
+	(const Ring &F, Modules &M, const TiledDenseMatrix<typename Ring::Element, R, C> &A, const TiledDenseMatrix<typename Ring::Element, R, C> &B)
+{
+	lela_check (A.rowdim () == B.rowdim ());
+	lela_check (A.coldim () == B.coldim ());
+
+	typename TiledDenseMatrix<typename Ring::Element, R, C>::ConstTileIterator i_A, i_B;
+
+	for (i_A = A.tileBegin (), i_B = B.tileBegin (); i_A != A.tileEnd (); ++i_A, ++i_B)
+		if (!_equal<Ring, typename Modules::Tag>::op (F, M, *i_A, *i_B))
+			return false;
+
+	return true;
+}
+
+template <class Ring, class ParentModule>
+template <class Modules, size_t R, size_t C>
+bool _is_zero<Ring, TiledModuleTag<Ring, ParentModule> >::op
+	(const Ring &F, Modules &M, const TiledDenseMatrix<typename Ring::Element, R, C> &A)
+{
+	typename TiledDenseMatrix<typename Ring::Element, R, C>::ConstTileIterator i;
+
+	for (i = A.tileBegin (); i != A.tileEnd (); ++i)
+		if (!_is_zero<Ring, typename Modules::Tag>::op (F, M, *i))
+			return false;
+
+	return true;
+}
+
+} // namespace BLAS3
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL3_TILED_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
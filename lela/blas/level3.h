@@ -13,6 +13,7 @@
 
 #include "lela/blas/context.h"
 #include "lela/blas/level3-ll.h"
+#include "lela/util/profile.h"
 
 namespace LELA
 {
@@ -80,7 +81,32 @@ Matrix2 &axpy (Context<Ring, Modules> &ctx, const typename Ring::Element &a, con
 
 template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
 Matrix3 &gemm (Context<Ring, Modules> &ctx, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
-	{ return _gemm<Ring, typename Modules::Tag>::op (ctx.F, ctx.M, a, A, B, b, C); }
+{
+	LELA_PROFILE ("BLAS3::gemm");
+	return _gemm<Ring, typename Modules::Tag>::op (ctx.F, ctx.M, a, A, B, b, C);
+}
+
+/** General matrix-matrix multiply, C <- a AB + b C, which may overwrite A and B
+ *
+ * This is for callers which no longer need A and B. Where an
+ * implementation can use them as temporaries, e.g. Strassen-Winograd
+ * multiplication with dense square matrices, it needs less additional
+ * memory than gemm. The entries of A and B are undefined afterwards.
+ *
+ * @param a Ring::Element scalar a
+ * @param A Matrix A, whose entries are undefined afterwards
+ * @param B Matrix B, whose entries are undefined afterwards
+ * @param b Ring::Element scalar b
+ * @param C Matrix C, to be replaced by result of calculation
+ * @returns Reference to C
+ */
+
+template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
+Matrix3 &gemm_overwrite (Context<Ring, Modules> &ctx, const typename Ring::Element &a, Matrix1 &A, Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
+{
+	LELA_PROFILE ("BLAS3::gemm_overwrite");
+	return _gemm_overwrite<Ring, typename Modules::Tag>::op (ctx.F, ctx.M, a, A, B, b, C);
+}
 
 /** Triangular matrix-matrix multiply, B <- a AB, where A is triangular
  *
@@ -119,7 +145,10 @@ Matrix2 &trmm (Context<Ring, Modules> &ctx, const typename Ring::Element &a, con
 
 template <class Ring, class Modules, class Matrix1, class Matrix2>
 Matrix2 &trsm (Context<Ring, Modules> &ctx, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne)
-	{ return _trsm<Ring, typename Modules::Tag>::op (ctx.F, ctx.M, a, A, B, type, diagIsOne); }
+{
+	LELA_PROFILE ("BLAS3::trsm");
+	return _trsm<Ring, typename Modules::Tag>::op (ctx.F, ctx.M, a, A, B, type, diagIsOne);
+}
 
 /** Permute rows of A, A <- PA, where P is a permutation
  *
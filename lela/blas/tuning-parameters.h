@@ -0,0 +1,70 @@
+/* lela/blas/tuning-parameters.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Machine-dependent parameters for matrix-multiplication over the
+ * individual rings
+ *
+ * This file may be replaced by the output of util/autotune, which
+ * measures the parameters on the machine on which it runs.
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_TUNING_PARAMETERS_H
+#define __BLAS_TUNING_PARAMETERS_H
+
+#include "lela/blas/tuning.h"
+
+namespace LELA
+{
+
+template <>
+struct TuningParameters<GF2>
+{
+	static const size_t strassen_cutoff = 2048;
+	static const size_t block_size = 0;
+};
+
+template <>
+struct TuningParameters<Modular<uint8> >
+{
+	static const size_t strassen_cutoff = 2048;
+	static const size_t block_size = 0;
+};
+
+template <>
+struct TuningParameters<Modular<uint32> >
+{
+	static const size_t strassen_cutoff = 2048;
+	static const size_t block_size = 0;
+};
+
+template <>
+struct TuningParameters<Modular<float> >
+{
+	static const size_t strassen_cutoff = 2048;
+	static const size_t block_size = 0;
+};
+
+template <>
+struct TuningParameters<Modular<double> >
+{
+	static const size_t strassen_cutoff = 2048;
+	static const size_t block_size = 0;
+};
+
+} // namespace LELA
+
+#endif // __BLAS_TUNING_PARAMETERS_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,79 @@
+/* lela/blas/tuning.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Machine-dependent parameters for matrix-multiplication
+ *
+ * The parameters for the individual rings are in
+ * lela/blas/tuning-parameters.h.
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_TUNING_H
+#define __BLAS_TUNING_H
+
+#include <algorithm>
+
+#include "lela/integer.h"
+
+namespace LELA
+{
+
+// Forward-declarations
+class GF2;
+
+template <class _Element>
+class Modular;
+
+/** Machine-dependent parameters for a ring
+ *
+ * StrassenModule and ZpModule read these at construction. They may
+ * be overridden at run time through @ref Context::setStrassenCutoff
+ * and @ref Context::setBlockSize.
+ *
+ * \ingroup blas
+ */
+template <class Ring>
+struct TuningParameters
+{
+	/// Dimension below which Strassen-Winograd switches to classical multiplication
+	static const size_t strassen_cutoff = 2048;
+
+	/// Largest block_size ZpModule should use, regardless of arithmetic bounds; 0 for no limit
+	static const size_t block_size = 0;
+};
+
+/** Limit a block-size obtained from arithmetic bounds by one obtained
+ * from tuning
+ *
+ * @param bound Largest block-size permitted by the arithmetic; 0 for no limit
+ * @param tuned Block-size from tuning; 0 for no limit
+ * @returns Block-size to be used
+ */
+inline size_t limit_block_size (size_t bound, size_t tuned)
+{
+	if (tuned == 0)
+		return bound;
+	else if (bound == 0)
+		return tuned;
+	else
+		return std::min (bound, tuned);
+}
+
+} // namespace LELA
+
+#include "lela/blas/tuning-parameters.h"
+
+#endif // __BLAS_TUNING_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
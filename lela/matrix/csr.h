@@ -0,0 +1,356 @@
+/* lela/matrix/csr.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Sparse matrix in compressed-sparse-row format
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_MATRIX_CSR_H
+#define __LELA_MATRIX_CSR_H
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <cstddef>
+
+#include "lela/lela-config.h"
+#include "lela/integer.h"
+#include "lela/util/debug.h"
+#include "lela/vector/traits.h"
+#include "lela/vector/sparse.h"
+#include "lela/vector/stream.h"
+#include "lela/matrix/traits.h"
+#include "lela/matrix/raw-iterator.h"
+#include "lela/matrix/submatrix.h"
+#include "lela/matrix/sparse.h"
+
+namespace LELA
+{
+
+/** Sparse matrix in compressed-sparse-row format
+ *
+ * The column-indices of all nonzero entries are stored row after row
+ * in one array and the entries themselves in a second array of the
+ * same length. A third array of length rowdim () + 1 gives for each
+ * row the position in the first two at which the row begins, the
+ * last entry being the number of nonzero entries. Whereas each row
+ * of a @ref SparseMatrix is allocated on its own, this matrix needs
+ * only these three allocations, and a pass over its rows walks
+ * straight through memory.
+ *
+ * The rows are @ref ConstSparseVector views into the arrays. The
+ * entries of a row may be changed in place through them, but not its
+ * nonzero-structure, so the matrix may be input to any BLAS-routine
+ * but output only to BLAS3::copy and BLAS3::scal, which CSRModule
+ * implements. setEntry and eraseEntry must move all entries after the
+ * one changed, so larger matrices should rather be built with
+ * BLAS3::copy or from a VectorStream.
+ *
+ * See @ref MatrixArchetype for documentation on the interface
+ *
+ * @param Element Element type
+ *
+ * \ingroup matrix
+ */
+template <class _Element>
+class CSRMatrix
+{
+    public:
+
+	/// @name Storage
+	//@{
+
+	typedef std::vector<uint32> IndexVector;
+	typedef std::vector<_Element> ElementVector;
+	typedef std::vector<size_t> RowPointerVector;
+
+	//@}
+
+    protected:
+
+	template <class RowType, class ElementIterator>
+	class RowIteratorPT
+	{
+	public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef RowType value_type;
+		typedef RowType &reference;
+		typedef RowType *pointer;
+		typedef ptrdiff_t difference_type;
+		typedef size_t size_type;
+
+		RowIteratorPT () {}
+
+		RowIteratorPT (const size_t *row_ptr, const uint32 *idx, ElementIterator elt)
+			: _row_ptr (row_ptr), _idx (idx), _elt (elt) {}
+
+		RowIteratorPT (const RowIteratorPT &i)
+			: _row_ptr (i._row_ptr), _idx (i._idx), _elt (i._elt) {}
+
+		template <class R, class EIt>
+		RowIteratorPT (const RowIteratorPT<R, EIt> &i)
+			: _row_ptr (i._row_ptr), _idx (i._idx), _elt (i._elt) {}
+
+		RowIteratorPT &operator = (const RowIteratorPT &i)
+		{
+			_row_ptr = i._row_ptr;
+			_idx = i._idx;
+			_elt = i._elt;
+			return *this;
+		}
+
+		RowIteratorPT &operator ++ ()
+			{ ++_row_ptr; return *this; }
+
+		RowIteratorPT operator ++ (int)
+		{
+			RowIteratorPT tmp (*this);
+			++_row_ptr;
+			return tmp;
+		}
+
+		RowIteratorPT &operator -- ()
+			{ --_row_ptr; return *this; }
+
+		RowIteratorPT operator -- (int)
+		{
+			RowIteratorPT tmp (*this);
+			--_row_ptr;
+			return tmp;
+		}
+
+		RowIteratorPT operator + (difference_type i) const
+			{ return RowIteratorPT (_row_ptr + i, _idx, _elt); }
+
+		RowIteratorPT &operator += (difference_type i)
+			{ _row_ptr += i; return *this; }
+
+		RowIteratorPT operator - (difference_type i) const
+			{ return RowIteratorPT (_row_ptr - i, _idx, _elt); }
+
+		RowIteratorPT &operator -= (difference_type i)
+			{ _row_ptr -= i; return *this; }
+
+		template <class R, class EIt>
+		difference_type operator - (const RowIteratorPT<R, EIt> &c) const
+			{ return _row_ptr - c._row_ptr; }
+
+		value_type operator [] (difference_type i) const
+			{ return *(*this + i); }
+
+		reference operator * ()
+			{ _row = make_row (); return _row; }
+
+		value_type operator * () const
+			{ return make_row (); }
+
+		pointer operator -> ()
+			{ _row = make_row (); return &_row; }
+
+		template <class R, class EIt>
+		bool operator == (const RowIteratorPT<R, EIt> &c) const
+			{ return _row_ptr == c._row_ptr; }
+
+		template <class R, class EIt>
+		bool operator != (const RowIteratorPT<R, EIt> &c) const
+			{ return _row_ptr != c._row_ptr; }
+
+		template <class R, class EIt>
+		bool operator < (const RowIteratorPT<R, EIt> &c) const
+			{ return _row_ptr < c._row_ptr; }
+
+	private:
+		template <class R, class EIt>
+		friend class RowIteratorPT;
+
+		RowType make_row () const
+		{
+			const uint32 *idx_begin = _idx + _row_ptr[0], *idx_end = _idx + _row_ptr[1];
+			ElementIterator elt_begin = _elt + _row_ptr[0];
+
+			return RowType (idx_begin, idx_end, elt_begin);
+		}
+
+		const size_t *_row_ptr;
+		const uint32 *_idx;
+		ElementIterator _elt;
+		RowType _row;
+	};
+
+    public:
+
+	/// @name @ref MatrixArchetype interface
+	//@{
+
+	typedef _Element Element;
+	typedef CSRMatrix<Element> Self_t;
+	typedef ConstSparseVector<const uint32 *, Element *, const uint32 *, const Element *> Row;
+	typedef ConstSparseVector<const uint32 *, const Element *> ConstRow;
+	typedef MatrixIteratorTypes::Row IteratorType;
+	typedef MatrixStorageTypes::Generic StorageType;
+
+	typedef Submatrix<Self_t> SubmatrixType;
+	typedef Submatrix<const Self_t> ConstSubmatrixType;
+	typedef Submatrix<Self_t> AlignedSubmatrixType;
+	typedef Submatrix<const Self_t> ConstAlignedSubmatrixType;
+
+	static const size_t rowAlign = 1;
+	static const size_t colAlign = 1;
+
+	typedef SparseMatrix<Element> ContainerType;
+
+	CSRMatrix () : _row_ptr (1, 0), _m (0), _n (0), _ext_row_ptr (NULL), _ext_idx (NULL), _ext_elt (NULL) {}
+	CSRMatrix (size_t m, size_t n) : _row_ptr (m + 1, 0), _m (m), _n (n), _ext_row_ptr (NULL), _ext_idx (NULL), _ext_elt (NULL) {}
+
+	/** Construct from a stream of sparse vectors
+	 *
+	 * @param vs Stream whose vectors become the rows of the matrix
+	 */
+	template <class Vector>
+	CSRMatrix (VectorStream<Vector> &vs);
+
+	size_t rowdim () const { return _m; }
+	size_t coldim () const { return _n; }
+
+	void resize (size_t m, size_t n);
+
+	void setEntry (size_t i, size_t j, const Element &value);
+	void eraseEntry (size_t i, size_t j);
+	bool getEntry (Element &x, size_t i, size_t j) const;
+
+	typedef RowIteratorPT<Row, Element *> RowIterator;
+	typedef RowIteratorPT<ConstRow, const Element *> ConstRowIterator;
+
+	RowIterator      rowBegin ()       { return RowIterator (rowPointersBegin (), indicesBegin (), entriesBegin ()); }
+	RowIterator      rowEnd ()         { return RowIterator (rowPointersBegin () + _m, indicesBegin (), entriesBegin ()); }
+	ConstRowIterator rowBegin () const { return ConstRowIterator (rowPointersBegin (), indicesBegin (), entriesBegin ()); }
+	ConstRowIterator rowEnd () const   { return ConstRowIterator (rowPointersBegin () + _m, indicesBegin (), entriesBegin ()); }
+
+	typedef MatrixRawIterator<ConstRowIterator, VectorRepresentationTypes::Sparse> RawIterator;
+	typedef RawIterator ConstRawIterator;
+
+	ConstRawIterator rawBegin () const { return ConstRawIterator (rowBegin (), 0, rowEnd (), coldim ()); }
+	ConstRawIterator rawEnd () const   { return ConstRawIterator (rowEnd (), 0, rowEnd (), coldim ()); }
+
+	typedef MatrixRawIndexedIterator<ConstRowIterator, VectorRepresentationTypes::Sparse, false> RawIndexedIterator;
+	typedef RawIndexedIterator ConstRawIndexedIterator;
+
+	ConstRawIndexedIterator rawIndexedBegin() const { return ConstRawIndexedIterator (rowBegin (), 0, rowEnd (), coldim ()); }
+        ConstRawIndexedIterator rawIndexedEnd() const   { return ConstRawIndexedIterator (rowEnd (), rowdim (), rowEnd (), coldim ()); }
+
+	Row      operator [] (size_t i)       { return *(rowBegin () + i); }
+	ConstRow operator [] (size_t i) const { return *(rowBegin () + i); }
+
+	//@}
+
+	/// @name Additional interfaces
+	//@{
+
+	/** Construct a matrix on arrays in external memory
+	 *
+	 * The arrays are as those of indices (), entries (), and
+	 * rowPointers () but are not owned by the matrix, so they
+	 * must exist as long as the matrix does. This permits e.g. to
+	 * use a matrix in a file mapped into memory (see @ref
+	 * MappedMatrixFile) without copying it. The entries may be
+	 * changed but not the nonzero-structure, so the matrix may
+	 * not be resized and setEntry, eraseEntry, and BLAS3::copy
+	 * into it are not permitted.
+	 *
+	 * @param m Row-dimension
+	 * @param n Column-dimension
+	 * @param row_ptr Array of m + 1 positions at which the rows begin
+	 * @param idx Array of column-indices
+	 * @param elt Array of entries
+	 */
+	CSRMatrix (size_t m, size_t n, const size_t *row_ptr, const uint32 *idx, Element *elt)
+		: _m (m), _n (n), _ext_row_ptr (row_ptr), _ext_idx (idx), _ext_elt (elt) {}
+
+	/// True if the matrix is on arrays in external memory
+	bool isAttached () const { return _ext_row_ptr != NULL; }
+
+	/// Number of nonzero entries in the matrix
+	size_t size () const { return rowPointersBegin ()[_m]; }
+
+	/// @name Pointers to the arrays, which are valid whether or not the matrix is attached to external memory
+	//@{
+
+	const size_t *rowPointersBegin () const
+		{ return isAttached () ? _ext_row_ptr : &_row_ptr[0]; }
+
+	const uint32 *indicesBegin () const
+		{ return isAttached () ? _ext_idx : (_idx.empty () ? NULL : &_idx[0]); }
+
+	Element *entriesBegin ()
+		{ return isAttached () ? _ext_elt : (_elt.empty () ? NULL : &_elt[0]); }
+
+	const Element *entriesBegin () const
+		{ return isAttached () ? _ext_elt : (_elt.empty () ? NULL : &_elt[0]); }
+
+	//@}
+
+	/** Column-indices of the nonzero entries, row after row
+	 *
+	 * The arrays may be filled directly, e.g. by a routine which
+	 * builds the matrix; it is then the responsibility of the
+	 * caller that the indices within each row be strictly
+	 * increasing and less than coldim (), that indices () and
+	 * entries () have the same length, and that rowPointers ()
+	 * have rowdim () + 1 nondecreasing entries, starting at 0
+	 * and ending at size (). These arrays are empty if the matrix
+	 * is attached to external memory.
+	 */
+	IndexVector       &indices ()           { return _idx; }
+	const IndexVector &indices () const     { return _idx; }
+
+	/// Nonzero entries, in the same order as indices ()
+	ElementVector       &entries ()         { return _elt; }
+	const ElementVector &entries () const   { return _elt; }
+
+	/// Position in indices () and entries () at which each row begins
+	RowPointerVector       &rowPointers ()       { return _row_ptr; }
+	const RowPointerVector &rowPointers () const { return _row_ptr; }
+
+	/// Remove all entries, leaving the zero-matrix of the same dimensions
+	void clear ()
+	{
+		lela_check (!isAttached ());
+
+		_idx.clear ();
+		_elt.clear ();
+		std::fill (_row_ptr.begin (), _row_ptr.end (), 0);
+	}
+
+	//@}
+
+    protected:
+
+	RowPointerVector  _row_ptr;
+	IndexVector       _idx;
+	ElementVector     _elt;
+	size_t            _m;
+	size_t            _n;
+
+	const size_t     *_ext_row_ptr;
+	const uint32     *_ext_idx;
+	Element          *_ext_elt;
+};
+
+} // namespace LELA
+
+#include "lela/matrix/csr.tcc"
+
+#endif // __LELA_MATRIX_CSR_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,130 @@
+/* lela/matrix/csr.tcc
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Sparse matrix in compressed-sparse-row format
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_MATRIX_CSR_TCC
+#define __LELA_MATRIX_CSR_TCC
+
+#include <algorithm>
+
+#include "lela/util/debug.h"
+#include "lela/matrix/csr.h"
+
+namespace LELA
+{
+
+template <class Element>
+template <class Vector>
+CSRMatrix<Element>::CSRMatrix (VectorStream<Vector> &vs)
+	: _m (vs.size ()), _n (vs.dim ()), _ext_row_ptr (NULL), _ext_idx (NULL), _ext_elt (NULL)
+{
+	Vector v;
+
+	_row_ptr.reserve (_m + 1);
+	_row_ptr.push_back (0);
+
+	for (size_t i = 0; i < _m; ++i) {
+		vs >> v;
+
+		for (typename Vector::const_iterator j = v.begin (); j != v.end (); ++j) {
+			_idx.push_back (j->first);
+			_elt.push_back (j->second);
+		}
+
+		_row_ptr.push_back (_idx.size ());
+	}
+}
+
+template <class Element>
+void CSRMatrix<Element>::resize (size_t m, size_t n)
+{
+	lela_check (!isAttached ());
+
+	if (m < _m) {
+		_idx.resize (_row_ptr[m]);
+		_elt.resize (_row_ptr[m]);
+	}
+
+	_row_ptr.resize (m + 1, _idx.size ());
+	_m = m;
+	_n = n;
+}
+
+template <class Element>
+void CSRMatrix<Element>::setEntry (size_t i, size_t j, const Element &value)
+{
+	lela_check (!isAttached ());
+	lela_check (i < _m);
+	lela_check (j < _n);
+
+	typename IndexVector::iterator row_begin = _idx.begin () + _row_ptr[i];
+	typename IndexVector::iterator row_end = _idx.begin () + _row_ptr[i + 1];
+	typename IndexVector::iterator pos = std::lower_bound (row_begin, row_end, j);
+	size_t p = pos - _idx.begin ();
+
+	if (pos != row_end && *pos == j)
+		_elt[p] = value;
+	else {
+		_idx.insert (pos, j);
+		_elt.insert (_elt.begin () + p, value);
+
+		for (typename RowPointerVector::iterator k = _row_ptr.begin () + (i + 1); k != _row_ptr.end (); ++k)
+			++*k;
+	}
+}
+
+template <class Element>
+void CSRMatrix<Element>::eraseEntry (size_t i, size_t j)
+{
+	lela_check (!isAttached ());
+	lela_check (i < _m);
+
+	typename IndexVector::iterator row_begin = _idx.begin () + _row_ptr[i];
+	typename IndexVector::iterator row_end = _idx.begin () + _row_ptr[i + 1];
+	typename IndexVector::iterator pos = std::lower_bound (row_begin, row_end, j);
+
+	if (pos != row_end && *pos == j) {
+		_elt.erase (_elt.begin () + (pos - _idx.begin ()));
+		_idx.erase (pos);
+
+		for (typename RowPointerVector::iterator k = _row_ptr.begin () + (i + 1); k != _row_ptr.end (); ++k)
+			--*k;
+	}
+}
+
+template <class Element>
+bool CSRMatrix<Element>::getEntry (Element &x, size_t i, size_t j) const
+{
+	lela_check (i < _m);
+
+	const size_t *row_ptr = rowPointersBegin () + i;
+	const uint32 *row_begin = indicesBegin () + row_ptr[0];
+	const uint32 *row_end = indicesBegin () + row_ptr[1];
+	const uint32 *pos = std::lower_bound (row_begin, row_end, j);
+
+	if (pos == row_end || *pos != j)
+		return false;
+
+	x = entriesBegin ()[pos - indicesBegin ()];
+	return true;
+}
+
+} // namespace LELA
+
+#endif // __LELA_MATRIX_CSR_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
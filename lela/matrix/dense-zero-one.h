@@ -141,7 +141,7 @@ class Dense01Matrix
         typedef Dense01Matrix Self_t;
 	typedef typename std::iterator_traits<Iterator>::value_type word_type;
 	typedef MatrixIteratorTypes::Row IteratorType; 
-	typedef MatrixStorageTypes::Rows StorageType; 
+	typedef MatrixStorageTypes::Dense01 StorageType; 
 
 	typedef Submatrix<Self_t> SubmatrixType;
 	typedef Submatrix<const Self_t> ConstSubmatrixType;
@@ -338,6 +338,11 @@ class Dense01Matrix
 	ConstRow operator[] (size_t i) const
 		{ return ConstRow (_begin + _disp * i, _begin + _disp * i + (_cols >> WordTraits<word_type>::logof_size), _cols); }
 
+	/** Get the displacement in words from one row to the next
+	 */
+	size_t disp () const
+		{ return _disp; }
+
 	/** Compute column density
 	 */
 
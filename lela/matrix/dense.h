@@ -428,6 +428,21 @@ class DenseMatrix
 		  _rows (m), _cols (n), _disp (M._disp), _start_row (M._start_row + beg_row), _start_col (M._start_col + beg_col)
 		{ _ptr = &*_rep_begin; }
 
+	/** Construct a matrix on an array in external memory
+	 *
+	 * The matrix does not own the array, which must therefore
+	 * exist as long as the matrix does, e.g. a file mapped into
+	 * memory (see @ref MappedMatrixFile). The matrix may not be
+	 * resized.
+	 *
+	 * @param data Array of m * n entries, stored row after row
+	 * @param m row dimension
+	 * @param n column dimension
+	 */
+	DenseMatrix (Element *data, size_t m, size_t n)
+		: _rep_begin (data), _rep_end (data + m * n), _rows (m), _cols (n), _disp (n), _start_row (0), _start_col (0), _ptr (data)
+		{}
+
 	/** Get the displacement from one row to the next
 	 * @returns Number of words from one row to the next in memory
 	 */
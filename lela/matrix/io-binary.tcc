@@ -0,0 +1,439 @@
+/* lela/matrix/io-binary.tcc
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Support for reading and writing matrices in binary format
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_MATRIX_IO_BINARY_TCC
+#define __LELA_MATRIX_IO_BINARY_TCC
+
+#include <iostream>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cstring>
+
+#include "lela/util/error.h"
+#include "lela/blas/context.h"
+#include "lela/blas/level1.h"
+#include "lela/vector/traits.h"
+#include "lela/vector/sparse.h"
+#include "lela/matrix/io.h"
+
+namespace LELA
+{
+
+template <class Ring>
+bool MatrixReader<Ring>::isBinary (char *buf, std::streamsize n)
+{
+	// The line read stops at the newline at the end of the magic number
+	return n >= 7 && strncmp (buf, BinaryMatrixHeader::magic_number (), 7) == 0;
+}
+
+template <class Ring>
+template <class T>
+void MatrixReader<Ring>::readBinaryArray (std::istream &is, std::vector<T> &v, bool pad)
+{
+	uint64 size = v.size () * sizeof (T);
+
+	if (!v.empty ())
+		is.read ((char *) &v[0], size);
+
+	if (pad)
+		is.ignore (BinaryMatrixHeader::paddedSize (size) - size);
+
+	if (!is.good ())
+		throw InvalidMatrixInput ();
+}
+
+template <class Ring>
+void MatrixReader<Ring>::checkBinaryRowPointers (const BinaryMatrixHeader &header, const std::vector<uint64> &row_ptr, const std::vector<uint32> &idx)
+{
+	if (row_ptr.front () != 0 || row_ptr.back () != header.nnz)
+		throw InvalidMatrixInput ();
+
+	for (std::vector<uint64>::const_iterator i = row_ptr.begin () + 1; i != row_ptr.end (); ++i)
+		if (*i < *(i - 1))
+			throw InvalidMatrixInput ();
+
+	uint64 bits = 8 * header.element_width;
+	uint64 words = (header.representation == BinaryMatrixHeader::HYBRID) ? (header.coldim + bits - 1) / bits : header.coldim;
+
+	for (std::vector<uint32>::const_iterator i = idx.begin (); i != idx.end (); ++i)
+		if (*i >= words)
+			throw InvalidMatrixInput ();
+}
+
+template <class Ring>
+void MatrixReader<Ring>::readBinaryHeader (std::istream &is, BinaryMatrixHeader &header, bool gf2) const
+{
+	typedef typename Ring::Element Element;
+
+	is.read ((char *) &header, sizeof (BinaryMatrixHeader));
+
+	if (!is.good () || memcmp (header.magic, BinaryMatrixHeader::magic_number (), sizeof (header.magic)) != 0)
+		throw InvalidMatrixInput ();
+
+	if (header.version != BinaryMatrixHeader::current_version)
+		throw InvalidMatrixInput ();
+
+	if (gf2) {
+		if (header.ring != BinaryMatrixHeader::RING_GF2 || header.representation != BinaryMatrixHeader::HYBRID)
+			throw InvalidMatrixInput ();
+	} else {
+		if (!std::numeric_limits<Element>::is_specialized)
+			throw NotImplemented ();
+
+		uint32 ring = std::numeric_limits<Element>::is_integer ? BinaryMatrixHeader::RING_MODULAR : BinaryMatrixHeader::RING_MODULAR_FLOAT;
+
+		if (header.ring != ring || header.element_width != sizeof (Element))
+			throw InvalidMatrixInput ();
+
+		if (header.representation != BinaryMatrixHeader::DENSE && header.representation != BinaryMatrixHeader::SPARSE)
+			throw InvalidMatrixInput ();
+	}
+
+	integer c;
+	_F.characteristic (c);
+
+	if (c != (unsigned long) header.modulus)
+		throw InvalidMatrixInput ();
+}
+
+template <class Ring>
+template <class Matrix>
+std::istream &MatrixReader<Ring>::readBinaryRowsZp (std::istream &is, Matrix &A) const
+{
+	typedef typename Ring::Element Element;
+
+	BinaryMatrixHeader header;
+	readBinaryHeader (is, header, false);
+
+	A.resize (header.rowdim, header.coldim);
+
+	Context<Ring> ctx (_F);
+	typename Matrix::RowIterator i_A;
+
+	if (header.representation == BinaryMatrixHeader::DENSE) {
+		std::vector<Element> row (header.coldim);
+
+		for (i_A = A.rowBegin (); i_A != A.rowEnd (); ++i_A) {
+			readBinaryArray (is, row, false);
+
+			BLAS1::copy (ctx, row, *i_A);
+		}
+
+		uint64 size = header.rowdim * header.coldim * sizeof (Element);
+		is.ignore (BinaryMatrixHeader::paddedSize (size) - size);
+	} else {
+		std::vector<uint64> row_ptr (header.rowdim + 1);
+		std::vector<uint32> idx (header.nnz);
+		std::vector<Element> elt (header.nnz);
+
+		readBinaryArray (is, row_ptr);
+		readBinaryArray (is, idx);
+		readBinaryArray (is, elt);
+
+		checkBinaryRowPointers (header, row_ptr, idx);
+
+		std::vector<uint64>::const_iterator i_p = row_ptr.begin ();
+		std::vector<uint32>::const_iterator idx_begin, idx_end;
+		typename std::vector<Element>::const_iterator elt_begin;
+
+		for (i_A = A.rowBegin (); i_A != A.rowEnd (); ++i_A, ++i_p) {
+			idx_begin = idx.begin () + i_p[0];
+			idx_end = idx.begin () + i_p[1];
+			elt_begin = elt.begin () + i_p[0];
+
+			ConstSparseVector<std::vector<uint32>::const_iterator, typename std::vector<Element>::const_iterator> v (idx_begin, idx_end, elt_begin);
+
+			BLAS1::copy (ctx, v, *i_A);
+		}
+	}
+
+	return is;
+}
+
+template <class Ring>
+template <class Matrix>
+std::istream &MatrixReader<Ring>::readBinaryRowsGF2 (std::istream &is, Matrix &A) const
+{
+	typedef typename Vector<Ring>::Hybrid Hybrid;
+
+	BinaryMatrixHeader header;
+	readBinaryHeader (is, header, true);
+
+	if (header.element_width != sizeof (typename Hybrid::word_type))
+		throw InvalidMatrixInput ();
+
+	A.resize (header.rowdim, header.coldim);
+
+	std::vector<uint64> row_ptr (header.rowdim + 1);
+	std::vector<uint32> idx (header.nnz);
+	std::vector<typename Hybrid::word_type> elt (header.nnz);
+
+	readBinaryArray (is, row_ptr);
+	readBinaryArray (is, idx);
+	readBinaryArray (is, elt);
+
+	checkBinaryRowPointers (header, row_ptr, idx);
+
+	Context<Ring> ctx (_F);
+	Hybrid v;
+
+	std::vector<uint64>::const_iterator i_p = row_ptr.begin ();
+	typename Matrix::RowIterator i_A;
+
+	for (i_A = A.rowBegin (); i_A != A.rowEnd (); ++i_A, ++i_p) {
+		v.clear ();
+
+		for (uint64 k = i_p[0]; k < i_p[1]; ++k)
+			v.push_back (typename Hybrid::value_type (idx[k], elt[k]));
+
+		if (!v.empty ())
+			v.fix ();
+
+		BLAS1::copy (ctx, v, *i_A);
+	}
+
+	return is;
+}
+
+template <class Ring>
+std::istream &MatrixReader<Ring>::readBinary (std::istream &is, CSRMatrix<typename Ring::Element> &A) const
+{
+	typedef typename Ring::Element Element;
+
+	BinaryMatrixHeader header;
+	readBinaryHeader (is, header, false);
+
+	A.resize (header.rowdim, header.coldim);
+
+	if (header.representation == BinaryMatrixHeader::DENSE) {
+		std::vector<Element> row (header.coldim);
+
+		A.clear ();
+
+		for (size_t i = 0; i < header.rowdim; ++i) {
+			readBinaryArray (is, row, false);
+
+			for (size_t j = 0; j < row.size (); ++j) {
+				if (!_F.isZero (row[j])) {
+					A.indices ().push_back (j);
+					A.entries ().push_back (row[j]);
+				}
+			}
+
+			A.rowPointers ()[i + 1] = A.indices ().size ();
+		}
+
+		uint64 size = header.rowdim * header.coldim * sizeof (Element);
+		is.ignore (BinaryMatrixHeader::paddedSize (size) - size);
+	} else {
+		std::vector<uint64> row_ptr (header.rowdim + 1);
+
+		A.indices ().resize (header.nnz);
+		A.entries ().resize (header.nnz);
+
+		readBinaryArray (is, row_ptr);
+		readBinaryArray (is, A.indices ());
+		readBinaryArray (is, A.entries ());
+
+		checkBinaryRowPointers (header, row_ptr, A.indices ());
+
+		std::copy (row_ptr.begin (), row_ptr.end (), A.rowPointers ().begin ());
+	}
+
+	return is;
+}
+
+template <class Ring>
+void MatrixWriter<Ring>::writeBinaryPadding (std::ostream &os, uint64 size)
+{
+	static const char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+	os.write (zeros, BinaryMatrixHeader::paddedSize (size) - size);
+}
+
+template <class Ring>
+void MatrixWriter<Ring>::writeBinaryHeader (std::ostream &os, BinaryMatrixHeader &header, bool gf2) const
+{
+	typedef typename Ring::Element Element;
+
+	memcpy (header.magic, BinaryMatrixHeader::magic_number (), sizeof (header.magic));
+	header.version = BinaryMatrixHeader::current_version;
+
+	if (gf2)
+		header.ring = BinaryMatrixHeader::RING_GF2;
+	else {
+		if (!std::numeric_limits<Element>::is_specialized)
+			throw NotImplemented ();
+
+		header.ring = std::numeric_limits<Element>::is_integer ? BinaryMatrixHeader::RING_MODULAR : BinaryMatrixHeader::RING_MODULAR_FLOAT;
+		header.element_width = sizeof (Element);
+	}
+
+	integer c;
+	_F.characteristic (c);
+
+	if (!c.fits_ulong_p ())
+		throw NotImplemented ();
+
+	header.modulus = c.get_ui ();
+
+	os.write ((const char *) &header, sizeof (BinaryMatrixHeader));
+}
+
+template <class Ring>
+template <class Matrix>
+std::ostream &MatrixWriter<Ring>::writeBinaryRows (std::ostream &os, const Matrix &A, VectorRepresentationTypes::Dense) const
+{
+	BinaryMatrixHeader header;
+
+	header.rowdim = A.rowdim ();
+	header.coldim = A.coldim ();
+	header.nnz = header.rowdim * header.coldim;
+	header.representation = BinaryMatrixHeader::DENSE;
+
+	writeBinaryHeader (os, header, false);
+
+	std::vector<typename Ring::Element> row (A.coldim ());
+	typename Matrix::ConstRowIterator i_A;
+
+	for (i_A = A.rowBegin (); i_A != A.rowEnd (); ++i_A) {
+		std::copy (i_A->begin (), i_A->end (), row.begin ());
+		writeBinaryArray (os, row);
+	}
+
+	writeBinaryPadding (os, header.nnz * sizeof (typename Ring::Element));
+
+	return os;
+}
+
+template <class Ring>
+template <class Matrix>
+std::ostream &MatrixWriter<Ring>::writeBinaryRows (std::ostream &os, const Matrix &A, VectorRepresentationTypes::Sparse) const
+{
+	BinaryMatrixHeader header;
+
+	std::vector<uint64> row_ptr (A.rowdim () + 1, 0);
+	std::vector<uint64>::iterator i_p = row_ptr.begin ();
+	typename Matrix::ConstRowIterator i_A;
+
+	for (i_A = A.rowBegin (); i_A != A.rowEnd (); ++i_A, ++i_p)
+		i_p[1] = i_p[0] + i_A->size ();
+
+	header.rowdim = A.rowdim ();
+	header.coldim = A.coldim ();
+	header.nnz = row_ptr.back ();
+	header.representation = BinaryMatrixHeader::SPARSE;
+
+	writeBinaryHeader (os, header, false);
+	writeBinaryArray (os, row_ptr);
+
+	std::vector<uint32> idx;
+
+	for (i_A = A.rowBegin (); i_A != A.rowEnd (); ++i_A) {
+		idx.clear ();
+
+		for (typename Matrix::ConstRow::const_iterator j = i_A->begin (); j != i_A->end (); ++j)
+			idx.push_back (j->first);
+
+		writeBinaryArray (os, idx);
+	}
+
+	writeBinaryPadding (os, header.nnz * sizeof (uint32));
+
+	std::vector<typename Ring::Element> elt;
+
+	for (i_A = A.rowBegin (); i_A != A.rowEnd (); ++i_A) {
+		elt.clear ();
+
+		for (typename Matrix::ConstRow::const_iterator j = i_A->begin (); j != i_A->end (); ++j)
+			elt.push_back (j->second);
+
+		writeBinaryArray (os, elt);
+	}
+
+	writeBinaryPadding (os, header.nnz * sizeof (typename Ring::Element));
+
+	return os;
+}
+
+template <class Ring>
+template <class Matrix>
+std::ostream &MatrixWriter<Ring>::writeBinaryRowsGF2 (std::ostream &os, const Matrix &A) const
+{
+	typedef typename Vector<Ring>::Hybrid Hybrid;
+
+	BinaryMatrixHeader header;
+	Context<Ring> ctx (_F);
+	Hybrid v;
+
+	std::vector<uint64> row_ptr (A.rowdim () + 1, 0);
+	std::vector<uint64>::iterator i_p = row_ptr.begin ();
+	typename Matrix::ConstRowIterator i_A;
+
+	// Rows not already in hybrid format are converted anew in each pass, so as not to hold a copy of the matrix
+	for (i_A = A.rowBegin (); i_A != A.rowEnd (); ++i_A, ++i_p) {
+		BLAS1::copy (ctx, *i_A, v);
+		i_p[1] = i_p[0] + v.size ();
+	}
+
+	header.rowdim = A.rowdim ();
+	header.coldim = A.coldim ();
+	header.nnz = row_ptr.back ();
+	header.element_width = sizeof (typename Hybrid::word_type);
+	header.representation = BinaryMatrixHeader::HYBRID;
+
+	writeBinaryHeader (os, header, true);
+	writeBinaryArray (os, row_ptr);
+
+	std::vector<uint32> idx;
+
+	for (i_A = A.rowBegin (); i_A != A.rowEnd (); ++i_A) {
+		BLAS1::copy (ctx, *i_A, v);
+		idx.clear ();
+
+		for (typename Hybrid::const_iterator j = v.begin (); j != v.end (); ++j)
+			idx.push_back (j->first);
+
+		writeBinaryArray (os, idx);
+	}
+
+	writeBinaryPadding (os, header.nnz * sizeof (uint32));
+
+	std::vector<typename Hybrid::word_type> elt;
+
+	for (i_A = A.rowBegin (); i_A != A.rowEnd (); ++i_A) {
+		BLAS1::copy (ctx, *i_A, v);
+		elt.clear ();
+
+		for (typename Hybrid::const_iterator j = v.begin (); j != v.end (); ++j)
+			elt.push_back (j->second);
+
+		writeBinaryArray (os, elt);
+	}
+
+	writeBinaryPadding (os, header.nnz * sizeof (typename Hybrid::word_type));
+
+	return os;
+}
+
+} // namespace LELA
+
+#endif // __LELA_MATRIX_IO_BINARY_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
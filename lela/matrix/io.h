@@ -13,8 +13,11 @@
 #define __LELA_MATRIX_IO_H
 
 #include <iostream>
+#include <vector>
 
 #include "lela/lela-config.h"
+#include "lela/integer.h"
+#include "lela/util/error.h"
 
 #ifdef __LELA_HAVE_LIBPNG
 #  include <png.h>
@@ -26,6 +29,10 @@
 namespace LELA
 {
 
+// Forward-declaration
+template <class _Element>
+class CSRMatrix;
+
 /// @name Matrix I/O support
 ///
 /// \ingroup matrix
@@ -35,12 +42,58 @@ namespace LELA
 ///
 /// \ingroup matrix
 enum FileFormatTag {
-	FORMAT_DETECT, FORMAT_UNKNOWN, FORMAT_TURNER, FORMAT_ONE_BASED, FORMAT_DUMAS, FORMAT_MAPLE, FORMAT_MATLAB, FORMAT_SAGE, FORMAT_PRETTY,
+	FORMAT_DETECT, FORMAT_UNKNOWN, FORMAT_TURNER, FORMAT_ONE_BASED, FORMAT_DUMAS, FORMAT_MAPLE, FORMAT_MATLAB, FORMAT_SAGE, FORMAT_PRETTY, FORMAT_BINARY,
 #ifdef __LELA_HAVE_LIBPNG
 	FORMAT_PNG
 #endif // __LELA_HAVE_LIBPNG
 };
 
+/** Header of a matrix in FORMAT_BINARY
+ *
+ * The header is followed by the data of the matrix, each part of
+ * which begins at an offset from the beginning of the file which is a
+ * multiple of 8 bytes. If the representation is DENSE, the data are
+ * the rowdim * coldim entries, row after row. Otherwise they are the
+ * rowdim + 1 positions (uint64) at which the rows begin, then the nnz
+ * column-indices (uint32), and then the nnz entries, as in @ref
+ * CSRMatrix. For HYBRID, which stores matrices over GF(2), the
+ * indices are of 64-bit words and the entries are the words
+ * themselves, as in @ref HybridVector.
+ *
+ * All numbers are in the byte-order of the machine which wrote the
+ * file, so that the data may be used directly after mapping the file
+ * into memory (see @ref MappedMatrixFile).
+ *
+ * \ingroup matrix
+ */
+struct BinaryMatrixHeader
+{
+	/// Rings for which matrices may be stored
+	enum RingType { RING_MODULAR = 1, RING_MODULAR_FLOAT = 2, RING_GF2 = 3 };
+
+	/// Representations of the matrix
+	enum Representation { DENSE = 1, SPARSE = 2, HYBRID = 3 };
+
+	/// Magic number with which the file begins
+	static const char *magic_number () { return "LELABIN\n"; }
+
+	/// Version of the format described here
+	static const uint32 current_version = 1;
+
+	/// Size in bytes of a part of the data of the given size together with the padding after it
+	static uint64 paddedSize (uint64 size) { return (size + 7) & ~7ULL; }
+
+	char   magic[8];        ///< magic_number ()
+	uint32 version;         ///< current_version
+	uint32 ring;            ///< RingType
+	uint64 modulus;         ///< Characteristic of the ring
+	uint64 rowdim;          ///< Row-dimension of the matrix
+	uint64 coldim;          ///< Column-dimension of the matrix
+	uint64 nnz;             ///< Number of entries (words for HYBRID) stored
+	uint32 element_width;   ///< Size in bytes of an entry (word for HYBRID)
+	uint32 representation;  ///< Representation
+};
+
 /// Exception thrown when the data-format of a matrix for reading cannot be detected
 ///
 /// \ingroup matrix
@@ -90,12 +143,68 @@ private:
 	template <class Matrix>
 	std::istream &readPretty (std::istream &is, Matrix &A) const;
 
+	template <class Matrix>
+	std::istream &readBinary (std::istream &is, Matrix &A) const
+		{ return readBinarySpecialised (is, A, typename Matrix::IteratorType ()); }
+
+	std::istream &readBinary (std::istream &is, CSRMatrix<typename Ring::Element> &A) const;
+
+	void readBinaryHeader (std::istream &is, BinaryMatrixHeader &header, bool gf2) const;
+
+	template <class Matrix>
+	std::istream &readBinarySpecialised (std::istream &is, Matrix &A, MatrixIteratorTypes::Row) const
+		{ return readBinaryRows (is, A, typename VectorTraits<Ring, typename Matrix::Row>::RepresentationType ()); }
+
+	template <class Matrix>
+	std::istream &readBinarySpecialised (std::istream &is, Matrix &A, MatrixIteratorTypes::Col) const
+		{ throw NotImplemented (); }
+
+	template <class Matrix>
+	std::istream &readBinarySpecialised (std::istream &is, Matrix &A, MatrixIteratorTypes::RowCol) const
+		{ return readBinarySpecialised (is, A, MatrixIteratorTypes::Row ()); }
+
+	template <class Matrix>
+	std::istream &readBinaryRows (std::istream &is, Matrix &A, VectorRepresentationTypes::Dense) const
+		{ return readBinaryRowsZp (is, A); }
+
+	template <class Matrix>
+	std::istream &readBinaryRows (std::istream &is, Matrix &A, VectorRepresentationTypes::Sparse) const
+		{ return readBinaryRowsZp (is, A); }
+
+	template <class Matrix>
+	std::istream &readBinaryRows (std::istream &is, Matrix &A, VectorRepresentationTypes::Dense01) const
+		{ return readBinaryRowsGF2 (is, A); }
+
+	template <class Matrix>
+	std::istream &readBinaryRows (std::istream &is, Matrix &A, VectorRepresentationTypes::Sparse01) const
+		{ return readBinaryRowsGF2 (is, A); }
+
+	template <class Matrix>
+	std::istream &readBinaryRows (std::istream &is, Matrix &A, VectorRepresentationTypes::Hybrid01) const
+		{ return readBinaryRowsGF2 (is, A); }
+
+	template <class Matrix>
+	std::istream &readBinaryRowsZp (std::istream &is, Matrix &A) const;
+
+	template <class Matrix>
+	std::istream &readBinaryRowsGF2 (std::istream &is, Matrix &A) const;
+
+	template <class T>
+	static void readBinaryArray (std::istream &is, std::vector<T> &v, bool pad = true);
+
+	// Entries of type bool are stored only in the representation HYBRID
+	static void readBinaryArray (std::istream &is, std::vector<bool> &v, bool pad = true)
+		{ throw NotImplemented (); }
+
+	static void checkBinaryRowPointers (const BinaryMatrixHeader &header, const std::vector<uint64> &row_ptr, const std::vector<uint32> &idx);
+
 	static bool isDumas (char *buf, std::streamsize n);
 	static bool isTurner (char *buf, std::streamsize n);
 	static bool isMaple (char *buf, std::streamsize n);
 	static bool isMatlab (char *buf, std::streamsize n);
 	static bool isSage (char *buf, std::streamsize n);
 	static bool isPretty (char *buf, std::streamsize n);
+	static bool isBinary (char *buf, std::streamsize n);
 
 #ifdef __LELA_HAVE_LIBPNG
 	static const unsigned _png_sig_size = 8;
@@ -205,6 +314,55 @@ private:
 	template <class Matrix>
 	std::ostream &writePretty (std::ostream &os, const Matrix &A) const;
 
+	template <class Matrix>
+	std::ostream &writeBinary (std::ostream &os, const Matrix &A) const
+		{ return writeBinarySpecialised (os, A, typename Matrix::IteratorType ()); }
+
+	void writeBinaryHeader (std::ostream &os, BinaryMatrixHeader &header, bool gf2) const;
+
+	template <class Matrix>
+	std::ostream &writeBinarySpecialised (std::ostream &os, const Matrix &A, MatrixIteratorTypes::Row) const
+		{ return writeBinaryRows (os, A, typename VectorTraits<Ring, typename Matrix::Row>::RepresentationType ()); }
+
+	template <class Matrix>
+	std::ostream &writeBinarySpecialised (std::ostream &os, const Matrix &A, MatrixIteratorTypes::Col) const
+		{ throw NotImplemented (); }
+
+	template <class Matrix>
+	std::ostream &writeBinarySpecialised (std::ostream &os, const Matrix &A, MatrixIteratorTypes::RowCol) const
+		{ return writeBinarySpecialised (os, A, MatrixIteratorTypes::Row ()); }
+
+	template <class Matrix>
+	std::ostream &writeBinaryRows (std::ostream &os, const Matrix &A, VectorRepresentationTypes::Dense) const;
+
+	template <class Matrix>
+	std::ostream &writeBinaryRows (std::ostream &os, const Matrix &A, VectorRepresentationTypes::Sparse) const;
+
+	template <class Matrix>
+	std::ostream &writeBinaryRows (std::ostream &os, const Matrix &A, VectorRepresentationTypes::Dense01) const
+		{ return writeBinaryRowsGF2 (os, A); }
+
+	template <class Matrix>
+	std::ostream &writeBinaryRows (std::ostream &os, const Matrix &A, VectorRepresentationTypes::Sparse01) const
+		{ return writeBinaryRowsGF2 (os, A); }
+
+	template <class Matrix>
+	std::ostream &writeBinaryRows (std::ostream &os, const Matrix &A, VectorRepresentationTypes::Hybrid01) const
+		{ return writeBinaryRowsGF2 (os, A); }
+
+	template <class Matrix>
+	std::ostream &writeBinaryRowsGF2 (std::ostream &os, const Matrix &A) const;
+
+	template <class T>
+	static void writeBinaryArray (std::ostream &os, const std::vector<T> &v)
+		{ if (!v.empty ()) os.write ((const char *) &v[0], v.size () * sizeof (T)); }
+
+	// Entries of type bool are stored only in the representation HYBRID
+	static void writeBinaryArray (std::ostream &os, const std::vector<bool> &v)
+		{ throw NotImplemented (); }
+
+	static void writeBinaryPadding (std::ostream &os, uint64 size);
+
 #ifdef __LELA_HAVE_LIBPNG
 	static void PNGWriteData (png_structp png_ptr, png_bytep data, png_size_t length);
 	static void PNGFlush (png_structp png_ptr);
@@ -61,6 +61,9 @@ std::istream &MatrixReader<Ring>::read (std::istream &is, Matrix &A, FileFormatT
 	case FORMAT_PRETTY:
 		return readPretty (is, A);
 
+	case FORMAT_BINARY:
+		return readBinary (is, A);
+
 #ifdef __LELA_HAVE_LIBPNG
 	case FORMAT_PNG:
 		return readPNG (is, A);
@@ -146,7 +149,9 @@ FileFormatTag MatrixReader<Ring>::detectFormat (std::istream &is)
 
 	is.get (line, BUF_SIZE);
 
-	if (isDumas (line, BUF_SIZE))
+	if (isBinary (line, is.gcount ()))
+		format = FORMAT_BINARY;
+	else if (isDumas (line, BUF_SIZE))
 		format = FORMAT_DUMAS;
 	else if (isTurner (line, BUF_SIZE))
 		format = FORMAT_TURNER;
@@ -450,6 +455,10 @@ std::ostream &MatrixWriter<Ring>::write (std::ostream &os, const Matrix &A, File
 		return writePretty (os, A);
 		break;
 
+	case FORMAT_BINARY:
+		return writeBinary (os, A);
+		break;
+
 #ifdef __LELA_HAVE_LIBPNG
 	case FORMAT_PNG:
 		return writePNG (os, A);
@@ -661,6 +670,8 @@ std::ostream &MatrixWriter<Ring>::writePretty (std::ostream &os, const Matrix &A
 
 } // namespace LELA
 
+#include "lela/matrix/io-binary.tcc"
+
 #ifdef __LELA_HAVE_LIBPNG
 #  include "lela/matrix/io-png.tcc"
 #endif // __LELA_HAVE_LIBPNG
@@ -0,0 +1,177 @@
+/* lela/matrix/mapped-file.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Matrix in binary format mapped into memory
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_MATRIX_MAPPED_FILE_H
+#define __LELA_MATRIX_MAPPED_FILE_H
+
+#include <cstring>
+#include <limits>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "lela/integer.h"
+#include "lela/util/error.h"
+#include "lela/matrix/io.h"
+#include "lela/matrix/dense.h"
+#include "lela/matrix/csr.h"
+
+namespace LELA
+{
+
+/** Matrix-file in FORMAT_BINARY mapped into memory
+ *
+ * Rather than reading the matrix through a stream, this maps the file
+ * into memory and offers its data as a @ref DenseMatrix or @ref
+ * CSRMatrix on the mapped memory, so that loading a large matrix costs
+ * no more than the pages of it which are actually used. The mapping is
+ * private: changes to the entries of the matrices are not written back
+ * to the file.
+ *
+ * The matrices returned refer to the mapped memory, so they may not be
+ * used after this object is destroyed. Unlike @ref MatrixReader, this
+ * checks only the header, not the row-pointers and indices, since
+ * that would touch every page of the file.
+ *
+ * \ingroup matrix
+ */
+class MappedMatrixFile
+{
+    public:
+
+	/** Map the file with the given name into memory
+	 *
+	 * @param filename Name of the file
+	 * @throws InvalidMatrixInput if the file does not begin with a
+	 * valid header or is too short for the data which it declares
+	 */
+	MappedMatrixFile (const char *filename)
+		: _data (NULL), _size (0)
+	{
+		int fd = open (filename, O_RDONLY);
+
+		if (fd == -1)
+			throw LELAError ("Could not open matrix-file");
+
+		struct stat st;
+
+		if (fstat (fd, &st) == -1) {
+			close (fd);
+			throw LELAError ("Could not determine size of matrix-file");
+		}
+
+		_size = st.st_size;
+
+		if (_size < sizeof (BinaryMatrixHeader)) {
+			close (fd);
+			throw InvalidMatrixInput ();
+		}
+
+		void *data = mmap (NULL, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		close (fd);
+
+		if (data == MAP_FAILED)
+			throw LELAError ("Could not map matrix-file into memory");
+
+		_data = (char *) data;
+
+		if (memcmp (header ().magic, BinaryMatrixHeader::magic_number (), sizeof (header ().magic)) != 0
+		    || header ().version != BinaryMatrixHeader::current_version
+		    || _size < dataSize ()) {
+			munmap (_data, _size);
+			throw InvalidMatrixInput ();
+		}
+	}
+
+	~MappedMatrixFile ()
+		{ munmap (_data, _size); }
+
+	/// Header of the file
+	const BinaryMatrixHeader &header () const
+		{ return *(const BinaryMatrixHeader *) _data; }
+
+	/** Dense matrix on the mapped data
+	 *
+	 * @param Element Type of the entries, which must be that of the ring with which the file was written
+	 * @throws InvalidMatrixInput if the matrix in the file is not dense or has entries of a different size
+	 */
+	template <class Element>
+	DenseMatrix<Element> dense () const
+	{
+		if (header ().representation != BinaryMatrixHeader::DENSE || header ().element_width != sizeof (Element))
+			throw InvalidMatrixInput ();
+
+		return DenseMatrix<Element> ((Element *) (_data + sizeof (BinaryMatrixHeader)), header ().rowdim, header ().coldim);
+	}
+
+	/** Matrix in compressed-sparse-row format on the mapped data
+	 *
+	 * @param Element Type of the entries, which must be that of the ring with which the file was written
+	 * @throws InvalidMatrixInput if the matrix in the file is not sparse or has entries of a different size
+	 */
+	template <class Element>
+	CSRMatrix<Element> sparse () const
+	{
+		if (header ().representation != BinaryMatrixHeader::SPARSE || header ().element_width != sizeof (Element))
+			throw InvalidMatrixInput ();
+
+		// The row-pointers are stored as uint64
+		if (sizeof (size_t) != sizeof (uint64))
+			throw NotImplemented ();
+
+		const char *row_ptr = _data + sizeof (BinaryMatrixHeader);
+		const char *idx = row_ptr + BinaryMatrixHeader::paddedSize ((header ().rowdim + 1) * sizeof (uint64));
+		char *elt = _data + (idx - _data) + BinaryMatrixHeader::paddedSize (header ().nnz * sizeof (uint32));
+
+		return CSRMatrix<Element> (header ().rowdim, header ().coldim, (const size_t *) row_ptr, (const uint32 *) idx, (Element *) elt);
+	}
+
+    private:
+
+	// Not copyable
+	MappedMatrixFile (const MappedMatrixFile &);
+	MappedMatrixFile &operator = (const MappedMatrixFile &);
+
+	// Size of the file as declared by the header
+	uint64 dataSize () const
+	{
+		const BinaryMatrixHeader &h = header ();
+		uint64 size = sizeof (BinaryMatrixHeader);
+
+		if (h.representation == BinaryMatrixHeader::DENSE)
+			size += BinaryMatrixHeader::paddedSize (h.rowdim * h.coldim * h.element_width);
+		else
+			size += BinaryMatrixHeader::paddedSize ((h.rowdim + 1) * sizeof (uint64))
+				+ BinaryMatrixHeader::paddedSize (h.nnz * sizeof (uint32))
+				+ BinaryMatrixHeader::paddedSize (h.nnz * h.element_width);
+
+		return size;
+	}
+
+	char   *_data;
+	size_t  _size;
+};
+
+} // namespace LELA
+
+#endif // __LELA_MATRIX_MAPPED_FILE_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,176 @@
+/* lela/matrix/pooled-sparse.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Sparse matrix whose rows take their storage from a common pool
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_MATRIX_POOLED_SPARSE_H
+#define __LELA_MATRIX_POOLED_SPARSE_H
+
+#include <vector>
+
+#include "lela/util/pool-allocator.h"
+#include "lela/vector/sparse.h"
+#include "lela/vector/hybrid.h"
+#include "lela/vector/bit-iterator.h"
+#include "lela/matrix/sparse.h"
+
+namespace LELA
+{
+
+/** Row-types taking their storage from a @ref Pool
+ *
+ * Sparse gives sparse vectors, and over GF2 Hybrid gives hybrid 0-1
+ * vectors, whose index- and element-vectors use @ref PoolAllocator.
+ *
+ * \ingroup vector
+ */
+template <class Element>
+struct PooledVector
+{
+	typedef SparseVector<Element, std::vector<uint32, PoolAllocator<uint32> >, std::vector<Element, PoolAllocator<Element> > > Sparse;
+};
+
+template <>
+struct PooledVector<bool>
+{
+	typedef HybridVector<DefaultEndianness<uint64>, uint16, uint64,
+			     std::vector<uint16, PoolAllocator<uint16> >, std::vector<uint64, PoolAllocator<uint64> > > Hybrid;
+};
+
+/** Sparse matrix whose rows take their storage from a common pool
+ *
+ * This is a @ref SparseMatrix each of whose rows is constructed with
+ * a @ref PoolAllocator on a @ref Pool belonging to the matrix. When a
+ * row grows during elimination, its storage comes from the free lists
+ * of the pool rather than from malloc, and the storage it gives up is
+ * reused by the next row which needs a block of that size. This cuts
+ * the number of calls to malloc to a handful per slab.
+ *
+ * Because the pool keeps what it has once taken from the system, a
+ * matrix whose rows have grown and shrunk much may hold far more
+ * memory than its entries need. Calling compact moves all rows into a
+ * fresh pool, with storage just large enough for each row, and
+ * returns the old pool to the system.
+ *
+ * Rows may be swapped within the matrix, but not with rows of other
+ * matrices; use assignment for that. Temporaries of ContainerType are
+ * ordinary sparse matrices whose rows use operator new.
+ *
+ * @param Element Element type
+ * @param Row Vector type to use for rows of matrix, which must take a @ref PoolAllocator in its constructor
+ *
+ * \ingroup matrix
+ */
+template <class _Element, class _Row = typename PooledVector<_Element>::Sparse>
+class PooledSparseMatrix : public SparseMatrix<_Element, _Row>
+{
+    public:
+
+	typedef SparseMatrix<_Element, _Row> parent_type;
+	typedef _Element Element;
+	typedef _Row Row;
+	typedef typename parent_type::Rep Rep;
+	typedef typename parent_type::RowIterator RowIterator;
+	typedef PoolAllocator<Element> Allocator;
+
+	PooledSparseMatrix () : _pool (new Pool) {}
+
+	PooledSparseMatrix (size_t m, size_t n)
+		: _pool (new Pool)
+		{ resize (m, n); }
+
+	PooledSparseMatrix (VectorStream<Row> &vs)
+		: _pool (new Pool)
+	{
+		resize (vs.size (), vs.dim ());
+
+		for (RowIterator i = this->rowBegin (); i != this->rowEnd (); ++i)
+			vs >> *i;
+	}
+
+	PooledSparseMatrix (const PooledSparseMatrix &A)
+		: parent_type (), _pool (new Pool)
+		{ *this = A; }
+
+	~PooledSparseMatrix ()
+	{
+		this->_A.clear ();
+		delete _pool;
+	}
+
+	PooledSparseMatrix &operator = (const PooledSparseMatrix &A)
+	{
+		if (this != &A) {
+			resize (A.rowdim (), A.coldim ());
+
+			for (size_t i = 0; i < this->_A.size (); ++i)
+				this->_A[i] = A._A[i];
+		}
+
+		return *this;
+	}
+
+	/** Resize the matrix to the given dimensions
+	 *
+	 * New rows are empty and take their storage from the pool of
+	 * the matrix.
+	 */
+	void resize (size_t m, size_t n)
+	{
+		this->_A.resize (m, Row (Allocator (_pool)));
+		this->_m = m;
+		this->_n = n;
+	}
+
+	/** Move all rows into a fresh pool
+	 *
+	 * Each row gets storage for just its entries; the memory
+	 * which the old pool held, including that on its free lists,
+	 * is returned to the system. The slabs of the new pool are as
+	 * large as the storage the rows use now, so that all rows fit
+	 * into the first. Iterators and references into the rows are
+	 * invalidated.
+	 */
+	void compact ()
+	{
+		Pool *pool = new Pool (_pool->inUse ());
+
+		{
+			Rep A (this->_A.size (), Row (Allocator (pool)));
+
+			for (size_t i = 0; i < A.size (); ++i)
+				A[i] = this->_A[i];
+
+			this->_A.swap (A);
+		}
+
+		delete _pool;
+		_pool = pool;
+	}
+
+	/// The pool from which the rows take their storage, for statistics
+	const Pool &pool () const { return *_pool; }
+
+    protected:
+
+	Pool *_pool;
+};
+
+} // namespace LELA
+
+#endif // __LELA_MATRIX_POOLED_SPARSE_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,126 @@
+/* lela/matrix/sliced.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Dense bit-sliced matrices over small prime fields
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_MATRIX_SLICED_H
+#define __LELA_MATRIX_SLICED_H
+
+#include <vector>
+
+#include "lela/util/debug.h"
+#include "lela/matrix/traits.h"
+#include "lela/vector/sliced-vector.h"
+
+namespace LELA
+{
+
+/** Dense matrix over a small prime field, stored bit-sliced
+ *
+ * The matrix is stored as a vector of rows, each of which is a @ref
+ * SlicedVector, so that it takes Planes bits per entry. It converts
+ * to and from any other matrix with BLAS3::copy, and @ref
+ * SlicedModule implements BLAS3::gemm on it with whole words of the
+ * rows.
+ *
+ * @param Planes Number of bits of each entry
+ * @param Endianness Order of the entries in a word
+ *
+ * \ingroup matrix
+ */
+template <size_t _Planes, class _Endianness = DefaultEndianness<uint64> >
+class SlicedMatrix
+{
+    public:
+
+	typedef uint8 Element;
+	typedef SlicedVector<_Planes, _Endianness> Row;
+	typedef const Row ConstRow;
+	typedef std::vector<Row> Rep;
+	typedef SlicedMatrix<_Planes, _Endianness> Self_t;
+	typedef MatrixIteratorTypes::Row IteratorType;
+	typedef MatrixStorageTypes::Rows StorageType;
+	typedef Self_t ContainerType;
+
+	SlicedMatrix () : _m (0), _n (0) {}
+
+	SlicedMatrix (size_t m, size_t n) : _m (0), _n (0)
+		{ resize (m, n); }
+
+	size_t rowdim () const { return _m; }
+	size_t coldim () const { return _n; }
+
+	/** Resize the matrix to the given dimensions
+	 *
+	 * New entries are zero.
+	 */
+	void resize (size_t m, size_t n)
+	{
+		_A.resize (m);
+
+		for (typename Rep::iterator i = _A.begin (); i != _A.end (); ++i)
+			i->resize (n);
+
+		_m = m;
+		_n = n;
+	}
+
+	/** @name Access to entries
+	 *
+	 * Entries are given as their representatives in 0, ..., p -
+	 * 1, as in @ref SlicedVector, so only integral types may be
+	 * used; entries of Modular<float> and Modular<double> must be
+	 * translated with sliced_rep and sliced_element or copied
+	 * with BLAS3::copy.
+	 */
+	//@{
+
+	template <class T>
+	void setEntry (size_t i, size_t j, const T &a_ij)
+		{ _A[i][j] = a_ij; }
+
+	void eraseEntry (size_t i, size_t j)
+		{ _A[i][j] = (uint8) 0; }
+
+	template <class T>
+	bool getEntry (T &x, size_t i, size_t j) const
+		{ x = SlicedRawEntry<T>::value (_A[i][j]); return true; }
+
+	//@}
+
+	typedef typename Rep::iterator RowIterator;
+	typedef typename Rep::const_iterator ConstRowIterator;
+
+	RowIterator rowBegin () { return _A.begin (); }
+	RowIterator rowEnd () { return _A.end (); }
+	ConstRowIterator rowBegin () const { return _A.begin (); }
+	ConstRowIterator rowEnd () const { return _A.end (); }
+
+	Row &getRow (size_t i) { return _A[i]; }
+	Row &operator [] (size_t i) { return _A[i]; }
+	ConstRow &operator [] (size_t i) const { return _A[i]; }
+
+    protected:
+
+	Rep _A;
+	size_t _m, _n;
+};
+
+} // namespace LELA
+
+#endif // __LELA_MATRIX_SLICED_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
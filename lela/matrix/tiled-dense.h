@@ -0,0 +1,202 @@
+/* lela/matrix/tiled-dense.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Dense matrix stored in contiguous tiles
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_MATRIX_TILED_DENSE_H
+#define __LELA_MATRIX_TILED_DENSE_H
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+#include "lela/util/debug.h"
+#include "lela/matrix/traits.h"
+#include "lela/matrix/dense.h"
+
+namespace LELA
+{
+
+/** Default dimensions of the tiles of a @ref TiledDenseMatrix
+ *
+ * A tile of 64 x 64 entries of eight bytes fills 32 KB, the size of
+ * the L1-cache of most current processors, so that the three tiles
+ * involved in a product of tiles stay in the L2-cache. Over GF(2) a
+ * tile of 512 x 512 bits has the same size.
+ *
+ * \ingroup matrix
+ */
+template <class Element>
+struct DefaultTileSize
+{
+	static const size_t rows = 64;
+	static const size_t cols = 64;
+};
+
+template <>
+struct DefaultTileSize<bool>
+{
+	static const size_t rows = 512;
+	static const size_t cols = 512;
+};
+
+/** Dense matrix stored in tiles
+ *
+ * The matrix is divided into tiles of TileRows x TileCols entries,
+ * those in the last row and column of tiles being smaller if the
+ * dimensions of the matrix are not multiples of those of the
+ * tiles. Each tile is a @ref DenseMatrix with its own contiguous
+ * storage, so an algorithm which works on one tile at a time touches
+ * only a few pages of memory, and the tiles it reuses stay in the
+ * cache. Over GF(2) the tiles are packed DenseMatrix<bool>, and
+ * TileCols should be a multiple of the word-size.
+ *
+ * The matrix offers no row- or column-iterators, since its rows and
+ * columns are not contiguous; it is used rather through the tiles,
+ * which tile (I, J) and the tile-iterators give. @ref TiledModule,
+ * which is part of AllModules for Modular and GF2, implements
+ * BLAS3::copy to and from any other matrix and BLAS3::scal, axpy,
+ * gemm, trsm, equal and is_zero on tiled matrices tile by tile, with
+ * the kernels of the ring for DenseMatrix on each tile. A dense
+ * matrix is therefore converted with one BLAS3::copy, a large product
+ * or triangular solve done on the tiled matrices, and the result
+ * copied back.
+ *
+ * @param Element Element type
+ * @param TileRows Row-dimension of the tiles
+ * @param TileCols Column-dimension of the tiles
+ *
+ * \ingroup matrix
+ */
+template <class _Element, size_t _TileRows = DefaultTileSize<_Element>::rows, size_t _TileCols = DefaultTileSize<_Element>::cols>
+class TiledDenseMatrix
+{
+    public:
+
+	typedef _Element Element;
+	typedef MatrixIteratorTypes::Generic IteratorType;
+	typedef MatrixStorageTypes::Tiled StorageType;
+	typedef TiledDenseMatrix<_Element, _TileRows, _TileCols> Self_t;
+	typedef Self_t ContainerType;
+
+	/// Type of each tile
+	typedef DenseMatrix<Element> Tile;
+
+	static const size_t TileRows = _TileRows;
+	static const size_t TileCols = _TileCols;
+
+	/// Iterators over the tiles, row of tiles after row of tiles
+	typedef typename std::vector<Tile>::iterator TileIterator;
+	typedef typename std::vector<Tile>::const_iterator ConstTileIterator;
+
+	TiledDenseMatrix ()
+		: _rows (0), _cols (0), _tile_rows (0), _tile_cols (0)
+	{}
+
+	TiledDenseMatrix (size_t m, size_t n)
+		: _rows (0), _cols (0), _tile_rows (0), _tile_cols (0)
+		{ resize (m, n); }
+
+	TiledDenseMatrix (const TiledDenseMatrix &M)
+		: _rows (0), _cols (0), _tile_rows (0), _tile_cols (0)
+		{ *this = M; }
+
+	TiledDenseMatrix &operator = (const TiledDenseMatrix &M)
+	{
+		// The tiles are copied entry by entry since copies of a
+		// DenseMatrix<bool> share their storage
+		resize (M._rows, M._cols);
+
+		ConstTileIterator i;
+		TileIterator j;
+
+		for (i = M._tiles.begin (), j = _tiles.begin (); i != M._tiles.end (); ++i, ++j) {
+			typename Tile::ConstRowIterator i_row;
+			typename Tile::RowIterator j_row;
+
+			for (i_row = i->rowBegin (), j_row = j->rowBegin (); i_row != i->rowEnd (); ++i_row, ++j_row)
+				std::copy (i_row->begin (), i_row->end (), j_row->begin ());
+		}
+
+		return *this;
+	}
+
+	size_t rowdim () const { return _rows; }
+	size_t coldim () const { return _cols; }
+
+	/** Resize the matrix to the given dimensions
+	 *
+	 * The entries of the matrix are undefined afterwards.
+	 */
+	void resize (size_t m, size_t n)
+	{
+		_rows = m;
+		_cols = n;
+		_tile_rows = (m + TileRows - 1) / TileRows;
+		_tile_cols = (n + TileCols - 1) / TileCols;
+
+		// Each tile is resized in place rather than copied in,
+		// for the reason given in operator =
+		_tiles.clear ();
+		_tiles.resize (_tile_rows * _tile_cols);
+
+		for (size_t I = 0; I < _tile_rows; ++I)
+			for (size_t J = 0; J < _tile_cols; ++J)
+				_tiles[I * _tile_cols + J].resize (std::min (TileRows, m - I * TileRows), std::min (TileCols, n - J * TileCols));
+	}
+
+	void setEntry (size_t i, size_t j, const Element &a_ij)
+		{ tile (i / TileRows, j / TileCols).setEntry (i % TileRows, j % TileCols, a_ij); }
+
+	void eraseEntry (size_t i, size_t j)
+		{ tile (i / TileRows, j / TileCols).eraseEntry (i % TileRows, j % TileCols); }
+
+	bool getEntry (Element &x, size_t i, size_t j) const
+		{ return tile (i / TileRows, j / TileCols).getEntry (x, i % TileRows, j % TileCols); }
+
+	/// @name Tiles
+	//@{
+
+	/// Number of rows of tiles
+	size_t tileRowdim () const { return _tile_rows; }
+
+	/// Number of columns of tiles
+	size_t tileColdim () const { return _tile_cols; }
+
+	/// Tile in the I-th row and J-th column of tiles
+	Tile &tile (size_t I, size_t J) { return _tiles[I * _tile_cols + J]; }
+	const Tile &tile (size_t I, size_t J) const { return _tiles[I * _tile_cols + J]; }
+
+	TileIterator      tileBegin ()       { return _tiles.begin (); }
+	TileIterator      tileEnd ()         { return _tiles.end (); }
+	ConstTileIterator tileBegin () const { return _tiles.begin (); }
+	ConstTileIterator tileEnd () const   { return _tiles.end (); }
+
+	//@}
+
+    protected:
+
+	std::vector<Tile> _tiles;
+
+	size_t _rows, _cols;
+	size_t _tile_rows, _tile_cols;
+};
+
+} // namespace LELA
+
+#endif // __LELA_MATRIX_TILED_DENSE_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -54,6 +54,16 @@ namespace MatrixStorageTypes
 	 */
 	struct Rows : public Generic {};
 
+	/** Storage by rows of packed bits
+	 *
+	 * Dense01 means that the matrix is stored by rows as in Rows, where
+	 * each row is a dense vector over GF(2) packed into words, the
+	 * rows begin on word-boundaries, and the displacement from one row
+	 * to the next is constant. Routines may then work directly on the
+	 * words of the rows.
+	 */
+	struct Dense01 : public Rows {};
+
 	/** Dense storage
 	 *
 	 * Dense means that the matrix is stored as an array of elements. The
@@ -62,6 +72,16 @@ namespace MatrixStorageTypes
 	 */
 	struct Dense : public Generic {};
 
+	/** Dense storage in tiles
+	 *
+	 * Tiled means that the matrix is divided into tiles of fixed
+	 * size, each of which is a dense matrix stored contiguously, as
+	 * in @ref TiledDenseMatrix. The matrix should provide the method
+	 * tile (I, J) which gives the tile in the I-th row and J-th
+	 * column of tiles.
+	 */
+	struct Tiled : public Generic {};
+
 	/** Transposed dense storage
 	 *
 	 * DenseTranspose is similar to dense, but the matrix is stored in
@@ -197,6 +197,39 @@ public:
 		{ return random (a.ref ()); }
 };
 
+template <>
+class Modular<uint64>::RandIter
+{
+	MersenneTwister _r;
+	uint64 _size;
+	uint32 _seed;
+
+public:
+	typedef uint64 Element;
+
+	RandIter (const Modular<Element> &F, const integer &size = 0, const integer &seed = 0)
+		: _r (seed.get_ui ()), _size (size.get_ui ()), _seed (seed.get_ui ())
+	{
+		if ((_size == 0) || (_size > F._modulus))
+			_size = F._modulus;
+	}
+
+	RandIter (const Modular<Element>::RandIter &r)
+		: _r (r._r), _size (r._size), _seed (r._seed) {}
+
+	~RandIter () {}
+
+	RandIter &operator= (const RandIter &r)
+		{ _r = r._r; return *this; }
+
+	Element &random (Element &a) const
+		{ return a = _r.randomLongLong () % _size; }
+
+	template <class Iterator, class Accessor>
+	Element &random (Property<Iterator, Accessor> a) const
+		{ return random (a.ref ()); }
+};
+
 } // namespace LELA 
 
 #endif // __LELA_RANDITER_MODULAR_H
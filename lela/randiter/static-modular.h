@@ -0,0 +1,66 @@
+/* lela/randiter/static-modular.h
+ * Copyright 2011 Bradford Hovinen
+ *
+ * Written by Bradford Hovinen <hovinen@gmail.com>
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_RANDITER_STATIC_MODULAR_H
+#define __LELA_RANDITER_STATIC_MODULAR_H
+
+#include "lela/integer.h"
+#include "lela/ring/static-modular.h"
+#include "lela/randiter/mersenne-twister.h"
+#include "lela/util/property.h"
+
+namespace LELA
+{
+
+template <class Element, Element p>
+class StaticModular<Element, p>::RandIter
+{
+	MersenneTwister _r;
+	StaticModular<Element, p> _F;
+	Element _size;
+	Element _seed;
+
+public:
+	RandIter (const StaticModular<Element, p> &F, const integer &size = 0, const integer &seed = 0)
+		: _r (seed.get_ui ()), _F (F), _size (size.get_ui ()), _seed (seed.get_ui ())
+	{
+		if ((_size == 0) || (_size > F._modulus))
+			_size = F._modulus;
+	}
+
+	RandIter (const typename StaticModular<Element, p>::RandIter &r)
+		: _r (r._r), _F (r._F), _size (r._size), _seed (r._seed) {}
+
+	~RandIter () {}
+
+	RandIter &operator= (const RandIter &r)
+		{ _r = r._r; _F = r._F; _size = r._size; _seed = r._seed; return *this; }
+
+	Element &random (Element &a) const
+		{ return _F.init (a, (Element) _r.randomIntRange (0, _size)); }
+
+	template <class Iterator, class Accessor>
+	Element &random (Property<Iterator, Accessor> a) const
+		{ return random (a.ref ()); }
+};
+
+} // namespace LELA
+
+#endif // __LELA_RANDITER_STATIC_MODULAR_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -26,9 +26,13 @@
 #ifdef __LELA_HAVE_M4RI
 #  include "lela/matrix/m4ri-matrix.h"
 #else
+#  include <vector>
+#  include "lela/blas/level1-simd.h"
 #  include "lela/algorithms/strassen-winograd.h"
 #endif
 
+#include "lela/blas/level3-tiled.h"
+
 // Namespace in which all LELA code resides
 namespace LELA 
 {
@@ -327,21 +331,49 @@ struct M4RIModule : public GenericModule<GF2>
 };
 
 template <>
-struct AllModules<GF2> : public M4RIModule
+struct AllModules<GF2> : public TiledModule<GF2, M4RIModule>
 {
-	struct Tag { typedef M4RIModule::Tag Parent; };
+	struct Tag { typedef TiledModule<GF2, M4RIModule>::Tag Parent; };
 
-	AllModules (const GF2 &R) : M4RIModule (R) {}
+	AllModules (const GF2 &R) : TiledModule<GF2, M4RIModule> (R) {}
 };
 
 #else // !__LELA_HAVE_M4RI
 
+/** Module for dense matrices over GF(2) without libm4ri
+ *
+ * This module multiplies dense matrices by the Method of the Four
+ * Russians, working directly on the words of the rows. It applies to
+ * DenseMatrix<bool> and to its submatrices which begin on a
+ * word-boundary; everything else is passed to GenericModule.
+ *
+ * \ingroup blas
+ */
+struct M4RMModule : public GenericModule<GF2>
+{
+	struct Tag { typedef GenericModule<GF2>::Tag Parent; };
+
+	/// Number of rows combined in each table
+	static const unsigned int table_bits = 8;
+
+	/// Number of words of each row processed with one set of tables
+	static const size_t stripe_words = 16;
+
+	/// Kernel with which rows are added; may be replaced to select a different instruction-set
+	SIMDKernels<bool> kernels;
+
+	// Storage for the tables
+	std::vector<uint64> _tables;
+
+	M4RMModule (const GF2 &R) : GenericModule<GF2> (R) {}
+};
+
 template <>
-struct AllModules<GF2> : public StrassenModule<GF2, GenericModule<GF2> >
+struct AllModules<GF2> : public TiledModule<GF2, StrassenModule<GF2, M4RMModule> >
 {
-	struct Tag { typedef StrassenModule<GF2, GenericModule<GF2> >::Tag Parent; };
+	struct Tag { typedef TiledModule<GF2, StrassenModule<GF2, M4RMModule> >::Tag Parent; };
 
-	AllModules (const GF2 &R) : StrassenModule<GF2, GenericModule<GF2> > (R) {}
+	AllModules (const GF2 &R) : TiledModule<GF2, StrassenModule<GF2, M4RMModule> > (R) {}
 };
 
 #endif // __LELA_HAVE_M4RI
@@ -353,6 +385,8 @@ struct AllModules<GF2> : public StrassenModule<GF2, GenericModule<GF2> >
 
 #ifdef __LELA_HAVE_M4RI
 #  include "lela/blas/level3-m4ri.h"
+#else // !__LELA_HAVE_M4RI
+#  include "lela/blas/level3-m4rm.h"
 #endif // __LELA_HAVE_M4RI
 
 #include "lela/blas/level1-generic.h"
@@ -364,6 +398,8 @@ struct AllModules<GF2> : public StrassenModule<GF2, GenericModule<GF2> >
 
 #ifdef __LELA_HAVE_M4RI
 #  include "lela/blas/level3-m4ri.tcc"
+#else // !__LELA_HAVE_M4RI
+#  include "lela/blas/level3-m4rm.tcc"
 #endif // __LELA_HAVE_M4RI
 
 #include "lela/randiter/gf2.h"
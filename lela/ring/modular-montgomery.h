@@ -0,0 +1,425 @@
+/* lela/ring/modular-montgomery.h
+ * Copyright 2011 Bradford Hovinen
+ *
+ * Written by Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Integers modulo an odd n with Montgomery-reduction
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_RING_MODULAR_MONTGOMERY_H
+#define __LELA_RING_MODULAR_MONTGOMERY_H
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+#include "lela/lela-config.h"
+#include "lela/integer.h"
+#include "lela/util/debug.h"
+#include "lela/util/property.h"
+#include "lela/blas/context.h"
+#include "lela/algorithms/strassen-winograd.h"
+#include "lela/blas/level2-csr.h"
+#include "lela/ring/modular.h"
+
+namespace LELA
+{
+
+/** Traits for Montgomery-reduction
+ *
+ * This contains the word-sizes with which ModularMontgomery computes
+ * for the given element-type
+ *
+ * \ingroup ring
+ */
+template <class Element>
+struct MontgomeryTraits;
+
+template <>
+struct MontgomeryTraits<uint32>
+{
+	typedef uint32 Element;
+
+	/// Type holding a product of two elements
+	typedef uint64 FatElement;
+
+	/// Number of bits of Element; R = 2^bits
+	static const unsigned int bits = 32;
+};
+
+#ifdef __LELA_UINT128
+
+template <>
+struct MontgomeryTraits<uint64>
+{
+	typedef uint64 Element;
+
+	/// Type holding a product of two elements
+	typedef uint128 FatElement;
+
+	/// Number of bits of Element; R = 2^bits
+	static const unsigned int bits = 64;
+};
+
+#endif // __LELA_UINT128
+
+/** Integers modulo an odd n, with Montgomery-reduction
+ *
+ * This is a drop-in replacement for Modular<Element> for an odd
+ * modulus p < 2^(bits - 1), which never divides by the modulus in
+ * arithmetic. An element a is stored as aR mod p, where R = 2^bits,
+ * and products are reduced by Montgomery's method, which needs only
+ * multiplications by constants computed once in the constructor.
+ *
+ * The conversion to and from this representation happens only at the
+ * boundary, in init, convert, read, and write, so the representation
+ * is invisible to code which uses only the ring-interface. Code which
+ * looks at the entries directly (e.g. compares them to integers) sees
+ * aR mod p instead of a.
+ *
+ * The bound on p ensures that pR plus a sum of two products of
+ * elements does not overflow FatElement, which the reduction relies
+ * on.
+ *
+ * \ingroup ring
+ */
+template <class _Element>
+class ModularMontgomery
+{
+public:
+	typedef _Element Element;
+	typedef typename MontgomeryTraits<Element>::FatElement FatElement;
+
+	class RandIter;
+
+	/// The modulus p
+	Element _modulus;
+
+	/// -p^-1 mod R
+	Element _pinv;
+
+	/// R mod p, the representation of 1
+	Element _r1;
+
+	/// R^2 mod p; also the correction for an overflow of a FatElement-accumulator of products
+	Element _r2;
+
+	ModularMontgomery () {}
+
+	ModularMontgomery (unsigned long modulus)
+		{ init_modulus (modulus); }
+
+	ModularMontgomery (const integer &modulus)
+		{ init_modulus (modulus.get_ui ()); }
+
+	ModularMontgomery (const ModularMontgomery<Element> &F)
+		: _modulus (F._modulus), _pinv (F._pinv), _r1 (F._r1), _r2 (F._r2) {}
+
+	/// Return true if the given proposed modulus is valid, false otherwise
+	static bool valid_modulus (const integer &modulus)
+		{ return modulus > 2 && modulus < (integer (1) << (MontgomeryTraits<Element>::bits - 1)) && mpz_odd_p (modulus.get_mpz_t ()); }
+
+	integer &convert (integer &x, const Element &y) const { return x = from_montgomery (y); }
+	double &convert (double &x, const Element &y) const { return x = (double) from_montgomery (y); }
+	float &convert (float &x, const Element &y) const { return x = (float) from_montgomery (y); }
+
+	template <class Iterator, class Accessor, class T>
+	Element &init (Property<Iterator, Accessor> x, const T &y) const
+		{ return init (x.ref (), y); }
+
+	template <class T>
+	Element &init (Element &x, const T &y) const
+	{
+		integer t = integer (y) % integer (_modulus);
+
+		if (t < 0)
+			t += _modulus;
+
+		return x = to_montgomery ((Element) t.get_ui ());
+	}
+
+	Element &init (Element &x, Element y) const
+		{ return x = to_montgomery (y % _modulus); }
+
+	Element &init (Element &x, int y) const
+	{
+		long long t = (long long) y % (long long) _modulus;
+
+		if (t < 0)
+			t += _modulus;
+
+		return x = to_montgomery ((Element) t);
+	}
+
+	Element &init (Element &x, double y) const
+	{
+		double z = fmod (y, (double) _modulus);
+
+		if (z < 0)
+			z += _modulus;
+
+		return x = to_montgomery ((Element) (z + .5) % _modulus);
+	}
+
+	Element &init (Element &x, float y) const
+		{ return init (x, (double) y); }
+
+	Element &copy (Element &x, Element y) const
+		{ return x = y; }
+
+	template <class Iterator, class Accessor>
+	Element &copy (Property<Iterator, Accessor> x, Element y) const
+		{ return copy (x.ref (), y); }
+
+	integer &cardinality (integer &c) const { return c = _modulus; }
+	integer &characteristic (integer &c) const { return c = _modulus; }
+
+	bool areEqual (const Element &x, const Element &y) const { return x == y; }
+	bool isZero (const Element &x) const { return x == 0; }
+	bool isOne (const Element &x) const { return x == _r1; }
+
+	std::ostream &write (std::ostream &os) const { os << "ZZ/"; return ModularTraits<Element>::write (os, _modulus); }
+
+	std::istream &read (std::istream &is)
+	{
+		integer p;
+
+		is >> p;
+		init_modulus (p.get_ui ());
+
+		return is;
+	}
+
+	std::ostream &write (std::ostream &os, const Element &x) const { return ModularTraits<Element>::write (os, from_montgomery (x)); }
+
+	std::istream &read (std::istream &is, Element &x) const
+	{
+		integer tmp;
+
+		is >> tmp;
+		init (x, tmp);
+
+		return is;
+	}
+
+	size_t elementWidth () const
+		{ return ModularTraits<Element>::element_width (_modulus); }
+
+	Element &add (Element &x, const Element &y, const Element &z) const
+	{
+		x = y + z;
+		return ModularTraits<Element>::shift_down (x, _modulus);
+	}
+
+	Element &sub (Element &x, const Element &y, const Element &z) const
+	{
+		x = y + (_modulus - z);
+		return ModularTraits<Element>::shift_down (x, _modulus);
+	}
+
+	Element &mul (Element &x, const Element &y, const Element &z) const
+		{ return x = redc ((FatElement) y * (FatElement) z); }
+
+	bool div (Element &x, const Element &y, const Element &z) const
+	{
+		Element zinv;
+
+		if (!inv (zinv, z))
+			return false;
+
+		mul (x, y, zinv);
+		return true;
+	}
+
+	Element &neg (Element &x, const Element &y) const
+		{ return x = (y == 0) ? 0 : _modulus - y; }
+
+	bool inv (Element &x, const Element &y) const
+	{
+		typename ModularTraits<Element>::EEAElement a, b, gcd;
+
+		eea (gcd, a, from_montgomery (y), b, _modulus);
+
+		if (gcd != 1)
+			return false;
+
+		if (a < 0)
+			a += _modulus;
+
+		x = to_montgomery ((Element) a);
+		return true;
+	}
+
+	Element &axpy (Element &r, const Element &a, const Element &x, const Element &y) const
+		{ return r = redc ((FatElement) a * (FatElement) x + (FatElement) y * (FatElement) _r1); }
+
+	Element &addin (Element &x, const Element &y) const
+		{ return add (x, x, y); }
+
+	Element &subin (Element &x, const Element &y) const
+		{ return sub (x, x, y); }
+
+	Element &mulin (Element &x, const Element &y) const
+		{ return mul (x, x, y); }
+
+	template <class Iterator, class Accessor>
+	Element &mulin (Property<Iterator, Accessor> &x, const Element &y) const
+		{ return mulin (x.ref (), y); }
+
+	bool divin (Element &x, const Element &y) const
+		{ return div (x, x, y); }
+
+	Element &negin (Element &x) const
+		{ return neg (x, x); }
+
+	bool invin (Element &x) const
+		{ return inv (x, x); }
+
+	Element &axpyin (Element &r, const Element &a, const Element &x) const
+		{ return axpy (r, a, x, r); }
+
+	Element zero () const { return 0; }
+	Element one () const { return _r1; }
+	Element minusOne () const { return _modulus - _r1; }
+
+	/** Reduce a product of elements
+	 *
+	 * @param T Value less than pR
+	 * @returns TR^-1 mod p
+	 */
+	Element redc (FatElement T) const
+	{
+		Element m = (Element) T * _pinv;
+		Element t = (T + (FatElement) m * (FatElement) _modulus) >> MontgomeryTraits<Element>::bits;
+
+		return (t >= _modulus) ? t - _modulus : t;
+	}
+
+	/** Reduce an arbitrary FatElement, e.g. an accumulated sum of products
+	 *
+	 * A first step of Montgomery-reduction brings s below 2R, a
+	 * second below p, and a multiplication by R^2 undoes the extra
+	 * factor R^-1 of the second step.
+	 *
+	 * @param s Any value of FatElement
+	 * @returns sR^-1 mod p
+	 */
+	Element reduce (FatElement s) const
+	{
+		const unsigned int bits = MontgomeryTraits<Element>::bits;
+
+		Element m = (Element) s * _pinv;
+		FatElement v = (s >> bits) + (((FatElement) m * (FatElement) _modulus) >> bits) + ((Element) s != 0);
+
+		return redc ((FatElement) redc (v) * (FatElement) _r2);
+	}
+
+	/// Representation of the integer 0 <= a < p
+	Element to_montgomery (Element a) const
+		{ return redc ((FatElement) a * (FatElement) _r2); }
+
+	/// Integer 0 <= a < p represented by x
+	Element from_montgomery (Element x) const
+		{ return redc (x); }
+
+private:
+	void init_modulus (unsigned long modulus)
+	{
+		lela_check (valid_modulus (integer (modulus)));
+
+		_modulus = modulus;
+
+		// Newton-iteration for p^-1 mod R, doubling the number of
+		// correct bits from the three of p * p = 1 mod 8
+		Element pinv = _modulus;
+
+		for (int i = 0; i < 5; ++i)
+			pinv *= 2 - _modulus * pinv;
+
+		_pinv = -pinv;
+
+		_r1 = ((FatElement) 1 << MontgomeryTraits<Element>::bits) % _modulus;
+		_r2 = ((FatElement) _r1 * (FatElement) _r1) % _modulus;
+	}
+
+	// The extended Euclidean algoritm
+	typename ModularTraits<Element>::EEAElement &eea (typename ModularTraits<Element>::EEAElement &gcd,
+							  typename ModularTraits<Element>::EEAElement &a,
+							  typename ModularTraits<Element>::EEAElement x,
+							  typename ModularTraits<Element>::EEAElement &b,
+							  typename ModularTraits<Element>::EEAElement y) const
+	{
+		if (y == 0) {
+			gcd = x;
+			a = 1;
+			b = 0;
+		} else {
+			typename ModularTraits<Element>::EEAElement q = x / y, r = x % y;
+			eea (gcd, b, y, a, r);
+			b -= q * a;
+		}
+
+		return gcd;
+	}
+
+}; // class ModularMontgomery
+
+/** Module for Z/p with Montgomery-reduction
+ *
+ * Dot-products and matrix-vector-products accumulate the unreduced
+ * products in a FatElement, adding R^2 mod p whenever the accumulator
+ * overflows, and reduce only at the end with ModularMontgomery::reduce,
+ * so that they need no division at all.
+ *
+ * \ingroup blas
+ */
+template <class Element>
+struct MontgomeryModule : public GenericModule<ModularMontgomery<Element> >
+{
+	struct Tag { typedef typename GenericModule<ModularMontgomery<Element> >::Tag Parent; };
+
+	mutable std::vector<typename MontgomeryTraits<Element>::FatElement> _tmp;
+
+	MontgomeryModule (const ModularMontgomery<Element> &R) {}
+};
+
+template <class Element>
+struct AllModules<ModularMontgomery<Element> > : public CSRModule<ModularMontgomery<Element>, StrassenModule<ModularMontgomery<Element>, MontgomeryModule<Element> > >
+{
+	struct Tag { typedef typename CSRModule<ModularMontgomery<Element>, StrassenModule<ModularMontgomery<Element>, MontgomeryModule<Element> > >::Tag Parent; };
+
+	AllModules (const ModularMontgomery<Element> &R) : CSRModule<ModularMontgomery<Element>, StrassenModule<ModularMontgomery<Element>, MontgomeryModule<Element> > > (R) {}
+};
+
+} // namespace LELA
+
+#include "lela/blas/level1-montgomery.h"
+#include "lela/blas/level2-montgomery.h"
+
+#include "lela/blas/level1-generic.h"
+#include "lela/blas/level2-generic.h"
+#include "lela/blas/level3-generic.h"
+
+#include "lela/blas/level1-montgomery.tcc"
+#include "lela/blas/level2-montgomery.tcc"
+
+#include "lela/blas/level3-sw.h"
+#include "lela/blas/level3-csr.h"
+
+#include "lela/randiter/modular-montgomery.h"
+
+#endif // __LELA_RING_MODULAR_MONTGOMERY_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
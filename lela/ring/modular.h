@@ -26,6 +26,12 @@
 #include "lela/util/debug.h"
 #include "lela/util/property.h"
 #include "lela/blas/context.h"
+#include "lela/blas/tuning.h"
+#include "lela/blas/level1-simd.h"
+#include "lela/blas/level3-simd.h"
+#include "lela/blas/level2-csr.h"
+#include "lela/blas/level3-tiled.h"
+#include "lela/blas/level3-sliced.h"
 #include "lela/randiter/nonzero.h"
 #include "lela/algorithms/strassen-winograd.h"
 #include "lela/ring/type-wrapper.h"
@@ -244,6 +250,55 @@ struct ModularTraits<uint32>
 		{ return v; }
 };
 
+#ifdef __LELA_UINT128
+
+// Specialisation for uint64; only available if the compiler has a
+// 128-bit type, which holds products and sums of products
+template <>
+struct ModularTraits<uint64>
+{
+	typedef uint64 Element;
+	typedef uint128 FatElement;
+	typedef uint128 DoubleFatElement;
+	typedef int64 EEAElement;
+	static bool valid_modulus (const integer &modulus) { return modulus < (integer (1) << 63); }
+	template <class FE>
+	static Element &reduce (Element &r, const FE &a, Element m) 
+		{ integer t = (integer) a % (integer) m; if (t < 0) t += m; return r = t.get_ui (); }
+	static Element &reduce (Element &r, FatElement a, Element m) 
+		{ return r = a % m; }
+	static DoubleFatElement &reduce (DoubleFatElement &r, DoubleFatElement a, Element m) 
+		{ return r = a % m; }
+	static Element &reduce (Element &r, int a, Element m) 
+		{ long long t = (long long) a % (long long) m; shift_up (t, m); return r = t; }
+	static Element &init_modulus (Element &elt, integer x)
+		{ elt = x.get_ui (); return elt; }
+	static std::ostream &write (std::ostream &os, const Element &x)
+		{ return os << x; }
+	static size_t element_width (Element modulus)
+		{ return (size_t) ceil (log (double (modulus)) / M_LN10); }
+	template <class T>
+	static T &shift_up (T &v, uint64 modulus)
+		{ if (v < 0) v += modulus; return v; }
+	template <class T>
+	static T &shift_down (T &v, uint64 modulus)
+		{ if ((FatElement) v >= (FatElement) modulus) v -= modulus; return v; }
+	template <class T>
+	static T &neg (T &v, const Element &modulus)
+		{ v = modulus - v; return valid_rep (v, modulus); }
+	template <class T>
+	static T &sub (T &v, const Element &y, const Element &modulus)
+		{ v += modulus - y; return valid_rep (v, modulus); }
+	template <class T>
+	static T &valid_rep (T &v, const Element &modulus)
+		{ return shift_down (v, modulus); }
+	template <class T>
+	static T &positive_rep (T &v, const Element &modulus)
+		{ return v; }
+};
+
+#endif // __LELA_UINT128
+
 // Specialisation for float
 template <>
 struct ModularTraits<float>
@@ -567,7 +622,10 @@ struct ZpModule : public GenericModule<Modular<Element> >
 		typedef typename AllModules<TypeWrapperRing<Element> >::Tag TWParent;
 	};
 
-	/// Number of times a product of two elements can be added before it is necessary to reduce by the modulus; 0 for unlimited
+	/// Number of times a product of two elements can be added before it is necessary to reduce by the modulus
+	size_t max_block_size;
+
+	/// Number of products actually accumulated before reducing; at most max_block_size but possibly less for better use of the cache
 	size_t block_size;
 
 	/// Modules for the switch over to TypeWrapperRing
@@ -576,9 +634,13 @@ struct ZpModule : public GenericModule<Modular<Element> >
 	mutable std::vector<typename ModularTraits<Element>::DoubleFatElement> _tmp;
 
 	ZpModule (const Modular<Element> &R)
-		: block_size (((typename ModularTraits<Element>::DoubleFatElement) -1LL) / ((R._modulus - 1) * (R._modulus - 1))),
+		: max_block_size (((typename ModularTraits<Element>::DoubleFatElement) -1LL) / ((R._modulus - 1) * (R._modulus - 1))),
+		  block_size (limit_block_size (max_block_size, TuningParameters<Modular<Element> >::block_size)),
 		  TWM (TypeWrapperRing<Element> ())
 		{}
+
+	void setBlockSize (size_t s) { block_size = limit_block_size (max_block_size, s); }
+	size_t blockSize () const { return block_size; }
 };
 
 template <>
@@ -625,6 +687,40 @@ private:
 	}
 };
 
+#ifdef __LELA_UINT128
+
+template <>
+struct ZpModule<uint64> : public GenericModule<Modular<uint64> >
+{
+	struct Tag { typedef GenericModule<Modular<uint64> >::Tag Parent; };
+
+	/// Number of products of two elements which can be added to a reduced element before it is necessary to reduce by the modulus
+	size_t max_block_size;
+
+	/// Number of products actually accumulated before reducing; at most max_block_size but possibly less for better use of the cache
+	size_t block_size;
+
+	mutable std::vector<ModularTraits<uint64>::DoubleFatElement> _tmp;
+
+	ZpModule (const Modular<uint64> &R)
+		: max_block_size (init_max_block_size (R._modulus)),
+		  block_size (limit_block_size (max_block_size, TuningParameters<Modular<uint64> >::block_size))
+		{}
+
+	void setBlockSize (size_t s) { block_size = limit_block_size (max_block_size, s); }
+	size_t blockSize () const { return block_size; }
+
+private:
+	static size_t init_max_block_size (uint64 modulus)
+	{
+		uint128 b = ((uint128) -1 - (modulus - 1)) / ((uint128) (modulus - 1) * (uint128) (modulus - 1));
+
+		return (b > (uint128) (size_t) -1) ? (size_t) -1 : (size_t) b;
+	}
+};
+
+#endif // __LELA_UINT128
+
 template <>
 struct ZpModule<float> : public GenericModule<Modular<float> >
 {
@@ -634,7 +730,10 @@ struct ZpModule<float> : public GenericModule<Modular<float> >
 		typedef AllModules<TypeWrapperRing<float> >::Tag TWParent;
 	};
 
-	/// Number of times a product of two elements can be added before it is necessary to reduce by the modulus; 0 for unlimited
+	/// Number of times a product of two elements can be added before it is necessary to reduce by the modulus
+	size_t max_block_size;
+
+	/// Number of products actually accumulated before reducing; at most max_block_size but possibly less for better use of the cache
 	size_t block_size;
 
 	/// Modules for the switch over to TypeWrapperRing
@@ -643,8 +742,12 @@ struct ZpModule<float> : public GenericModule<Modular<float> >
 	mutable std::vector<ModularTraits<float>::DoubleFatElement> _tmp;
 
 	ZpModule (const Modular<float> &R)
-		: block_size (floor (float (1 << FLOAT_MANTISSA) / ((R._modulus - 1) * (R._modulus - 1)))),
+		: max_block_size (floor (float (1 << FLOAT_MANTISSA) / ((R._modulus - 1) * (R._modulus - 1)))),
+		  block_size (limit_block_size (max_block_size, TuningParameters<Modular<float> >::block_size)),
 		  TWM (TypeWrapperRing<float> ()) {}
+
+	void setBlockSize (size_t s) { block_size = limit_block_size (max_block_size, s); }
+	size_t blockSize () const { return block_size; }
 };
 
 template <>
@@ -656,25 +759,39 @@ struct ZpModule<double> : public GenericModule<Modular<double> >
 		typedef AllModules<TypeWrapperRing<double> >::Tag TWParent;
 	};
 
-	/// Number of times a product of two elements can be added before it is necessary to reduce by the modulus; 0 for unlimited
+	/// Number of times a product of two elements can be added before it is necessary to reduce by the modulus
+	size_t max_block_size;
+
+	/// Number of products actually accumulated before reducing; at most max_block_size but possibly less for better use of the cache
 	size_t block_size;
 
 	/// Modules for the switch over to TypeWrapperRing
 	AllModules<TypeWrapperRing<double> > TWM;
 
+	/// Kernel for multiplication of dense matrices
+	SIMDGemmKernel<double> gemm_kernel;
+
+	/// Multiply dense matrices with BLAS rather than gemm_kernel; ignored if LELA is built without BLAS
+	bool use_blas;
+
 	mutable std::vector<ModularTraits<double>::DoubleFatElement> _tmp;
 
 	ZpModule (const Modular<double> &R)
-		: block_size (floor (double (1ULL << DOUBLE_MANTISSA) / ((R._modulus - 1) * (R._modulus - 1)))),
-		  TWM (TypeWrapperRing<double> ()) {}
+		: max_block_size (floor (double (1ULL << DOUBLE_MANTISSA) / ((R._modulus - 1) * (R._modulus - 1)))),
+		  block_size (limit_block_size (max_block_size, TuningParameters<Modular<double> >::block_size)),
+		  TWM (TypeWrapperRing<double> ()),
+		  use_blas (true) {}
+
+	void setBlockSize (size_t s) { block_size = limit_block_size (max_block_size, s); }
+	size_t blockSize () const { return block_size; }
 };
 
 template <class Element>
-struct AllModules<Modular<Element> > : public StrassenModule<Modular<Element>, ZpModule<Element> >
+struct AllModules<Modular<Element> > : public SlicedModule<Modular<Element>, TiledModule<Modular<Element>, CSRModule<Modular<Element>, StrassenModule<Modular<Element>, SIMDModule<Modular<Element>, ZpModule<Element> > > > > >
 {
-	struct Tag { typedef typename StrassenModule<Modular<Element>, ZpModule<Element> >::Tag Parent; };
+	struct Tag { typedef typename SlicedModule<Modular<Element>, TiledModule<Modular<Element>, CSRModule<Modular<Element>, StrassenModule<Modular<Element>, SIMDModule<Modular<Element>, ZpModule<Element> > > > > >::Tag Parent; };
 
-	AllModules (const Modular<Element> &R) : StrassenModule<Modular<Element>, ZpModule<Element> > (R) {}
+	AllModules (const Modular<Element> &R) : SlicedModule<Modular<Element>, TiledModule<Modular<Element>, CSRModule<Modular<Element>, StrassenModule<Modular<Element>, SIMDModule<Modular<Element>, ZpModule<Element> > > > > > (R) {}
 };
 
 } // namespace LELA
@@ -692,6 +809,7 @@ struct AllModules<Modular<Element> > : public StrassenModule<Modular<Element>, Z
 #include "lela/blas/level3-modular.tcc"
 
 #include "lela/blas/level3-sw.h"
+#include "lela/blas/level3-csr.h"
 
 #include "lela/randiter/modular.h"
 
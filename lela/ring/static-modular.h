@@ -0,0 +1,307 @@
+/* lela/ring/static-modular.h
+ * Copyright 2011 Bradford Hovinen
+ *
+ * Written by Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Integers modulo a modulus fixed at compile-time
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_RING_STATIC_MODULAR_H
+#define __LELA_RING_STATIC_MODULAR_H
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+#include "lela/lela-config.h"
+#include "lela/integer.h"
+#include "lela/util/debug.h"
+#include "lela/util/error.h"
+#include "lela/util/property.h"
+#include "lela/blas/context.h"
+#include "lela/algorithms/strassen-winograd.h"
+#include "lela/blas/level2-csr.h"
+#include "lela/ring/modular.h"
+
+namespace LELA
+{
+
+/** Integers modulo a modulus p fixed at compile-time
+ *
+ * This has the same interface as Modular<Element> but takes the
+ * modulus as a template-parameter, so that the compiler sees it as a
+ * constant and replaces each reduction by a multiplication and
+ * shift. It is meant for computations which always use the same few
+ * primes, e.g. StaticModular<uint16, 65521> or StaticModular<uint32,
+ * 2147483647U>.
+ *
+ * Element must be one of the integral types for which ModularTraits
+ * is specialised (uint8, uint16, uint32).
+ *
+ * \ingroup ring
+ */
+template <class _Element, _Element p>
+class StaticModular
+{
+public:
+	typedef _Element Element;
+	typedef typename ModularTraits<Element>::FatElement FatElement;
+
+	class RandIter;
+
+	/// The modulus p
+	static const Element _modulus = p;
+
+	StaticModular () {}
+
+	/// Constructor for code which constructs rings from a modulus; throws LELAError if the modulus is not p
+	StaticModular (const integer &modulus)
+	{
+		if (modulus != integer (p))
+			throw LELAError ("Modulus of StaticModular must be its template-parameter p");
+	}
+
+	StaticModular (const StaticModular<Element, p> &F) {}
+
+	integer &convert (integer &x, const Element &y) const { return x = y; }
+	double &convert (double &x, const Element &y) const { return x = (double) y; }
+	float &convert (float &x, const Element &y) const { return x = (float) y; }
+
+	template <class Iterator, class Accessor, class T>
+	Element &init (Property<Iterator, Accessor> x, const T &y) const
+		{ return init (x.ref (), y); }
+
+	template <class T>
+	Element &init (Element &x, const T &y) const
+		{ return ModularTraits<Element>::reduce (x, y, _modulus); }
+
+	Element &init (Element &x, Element y) const
+		{ return x = y % _modulus; }
+
+	Element &init (Element &x, double y) const
+	{
+		double z = fmod (y, (double) _modulus);
+		ModularTraits<Element>::shift_up (z, _modulus);
+		return x = (Element) (z + .5);
+	}
+
+	Element &init (Element &x, float y) const
+		{ return init (x, (double) y); }
+
+	Element &copy (Element &x, Element y) const
+		{ return x = y; }
+
+	template <class Iterator, class Accessor>
+	Element &copy (Property<Iterator, Accessor> x, Element y) const
+		{ return copy (x.ref (), y); }
+
+	integer &cardinality (integer &c) const { return c = _modulus; }
+	integer &characteristic (integer &c) const { return c = _modulus; }
+
+	bool areEqual (const Element &x, const Element &y) const { return x == y; }
+	bool isZero (const Element &x) const { return x == 0; }
+	bool isOne (const Element &x) const { return x == 1; }
+
+	std::ostream &write (std::ostream &os) const { os << "ZZ/"; return ModularTraits<Element>::write (os, _modulus); }
+
+	std::istream &read (std::istream &is)
+	{
+		integer modulus;
+
+		is >> modulus;
+
+		if (modulus != integer (p))
+			throw LELAError ("Modulus read does not match that of StaticModular");
+
+		return is;
+	}
+
+	std::ostream &write (std::ostream &os, const Element &x) const { return ModularTraits<Element>::write (os, x); }
+
+	std::istream &read (std::istream &is, Element &x) const
+	{
+		integer tmp;
+
+		is >> tmp;
+		init (x, tmp);
+
+		return is;
+	}
+
+	size_t elementWidth () const
+		{ return ModularTraits<Element>::element_width (_modulus); }
+
+	Element &add (Element &x, const Element &y, const Element &z) const
+	{
+		FatElement t = (FatElement) y + (FatElement) z;
+		return x = (t >= _modulus) ? t - _modulus : t;
+	}
+
+	Element &sub (Element &x, const Element &y, const Element &z) const
+	{
+		FatElement t = (FatElement) y + (FatElement) (_modulus - z);
+		return x = (t >= _modulus) ? t - _modulus : t;
+	}
+
+	Element &mul (Element &x, const Element &y, const Element &z) const
+		{ return x = ((FatElement) y * (FatElement) z) % _modulus; }
+
+	bool div (Element &x, const Element &y, const Element &z) const
+	{
+		Element zinv;
+
+		if (!inv (zinv, z))
+			return false;
+
+		mul (x, y, zinv);
+		return true;
+	}
+
+	Element &neg (Element &x, const Element &y) const
+		{ return x = (y == 0) ? 0 : _modulus - y; }
+
+	bool inv (Element &x, const Element &y) const
+	{
+		typename ModularTraits<Element>::EEAElement a, b, gcd;
+
+		eea (gcd, a, y, b, _modulus);
+
+		if (gcd != 1)
+			return false;
+
+		if (a < 0)
+			a += _modulus;
+
+		x = a;
+		return true;
+	}
+
+	Element &axpy (Element &r, const Element &a, const Element &x, const Element &y) const
+		{ return r = ((FatElement) a * (FatElement) x + (FatElement) y) % _modulus; }
+
+	Element &addin (Element &x, const Element &y) const
+		{ return add (x, x, y); }
+
+	Element &subin (Element &x, const Element &y) const
+		{ return sub (x, x, y); }
+
+	Element &mulin (Element &x, const Element &y) const
+		{ return mul (x, x, y); }
+
+	template <class Iterator, class Accessor>
+	Element &mulin (Property<Iterator, Accessor> &x, const Element &y) const
+		{ return mulin (x.ref (), y); }
+
+	bool divin (Element &x, const Element &y) const
+		{ return div (x, x, y); }
+
+	Element &negin (Element &x) const
+		{ return neg (x, x); }
+
+	bool invin (Element &x) const
+		{ return inv (x, x); }
+
+	Element &axpyin (Element &r, const Element &a, const Element &x) const
+		{ return axpy (r, a, x, r); }
+
+	Element zero () const { return 0; }
+	Element one () const { return 1; }
+	Element minusOne () const { return _modulus - 1; }
+
+private:
+	// The extended Euclidean algoritm
+	typename ModularTraits<Element>::EEAElement &eea (typename ModularTraits<Element>::EEAElement &gcd,
+							  typename ModularTraits<Element>::EEAElement &a,
+							  typename ModularTraits<Element>::EEAElement x,
+							  typename ModularTraits<Element>::EEAElement &b,
+							  typename ModularTraits<Element>::EEAElement y) const
+	{
+		if (y == 0) {
+			gcd = x;
+			a = 1;
+			b = 0;
+		} else {
+			typename ModularTraits<Element>::EEAElement q = x / y, r = x % y;
+			eea (gcd, b, y, a, r);
+			b -= q * a;
+		}
+
+		return gcd;
+	}
+
+}; // class StaticModular
+
+template <class Element, Element p>
+const Element StaticModular<Element, p>::_modulus;
+
+/** Module for Z/p with a modulus fixed at compile-time
+ *
+ * Dot-products and matrix-vector-products accumulate unreduced
+ * products in a DoubleFatElement and reduce after each block of
+ * block_size products. Both block_size and the modulus are
+ * compile-time constants, so the inner loops have a fixed trip-count
+ * and each reduction is a multiplication and shift.
+ *
+ * \ingroup blas
+ */
+template <class Element, Element p>
+struct StaticZpModule : public GenericModule<StaticModular<Element, p> >
+{
+	struct Tag { typedef typename GenericModule<StaticModular<Element, p> >::Tag Parent; };
+
+	typedef typename ModularTraits<Element>::DoubleFatElement DoubleFatElement;
+
+	/// Number of products of two elements which can be added to a reduced element before it is necessary to reduce by the modulus
+	static const DoubleFatElement block_size = ((DoubleFatElement) -1 - (DoubleFatElement) (p - 1)) / ((DoubleFatElement) (p - 1) * (DoubleFatElement) (p - 1));
+
+	mutable std::vector<DoubleFatElement> _tmp;
+
+	StaticZpModule (const StaticModular<Element, p> &R) {}
+
+	/// The block-size is fixed by the modulus and cannot be changed
+	size_t blockSize () const { return block_size; }
+};
+
+template <class Element, Element p>
+const typename StaticZpModule<Element, p>::DoubleFatElement StaticZpModule<Element, p>::block_size;
+
+template <class Element, Element p>
+struct AllModules<StaticModular<Element, p> > : public CSRModule<StaticModular<Element, p>, StrassenModule<StaticModular<Element, p>, StaticZpModule<Element, p> > >
+{
+	struct Tag { typedef typename CSRModule<StaticModular<Element, p>, StrassenModule<StaticModular<Element, p>, StaticZpModule<Element, p> > >::Tag Parent; };
+
+	AllModules (const StaticModular<Element, p> &R) : CSRModule<StaticModular<Element, p>, StrassenModule<StaticModular<Element, p>, StaticZpModule<Element, p> > > (R) {}
+};
+
+} // namespace LELA
+
+#include "lela/blas/level1-static-modular.h"
+#include "lela/blas/level2-static-modular.h"
+
+#include "lela/blas/level1-generic.h"
+#include "lela/blas/level2-generic.h"
+#include "lela/blas/level3-generic.h"
+
+#include "lela/blas/level1-static-modular.tcc"
+#include "lela/blas/level2-static-modular.tcc"
+
+#include "lela/blas/level3-sw.h"
+#include "lela/blas/level3-csr.h"
+
+#include "lela/randiter/static-modular.h"
+
+#endif // __LELA_RING_STATIC_MODULAR_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -14,10 +14,9 @@
 #ifndef __LELA_SOLUTIONS_ECHELON_FORM_GF2_H
 #define __LELA_SOLUTIONS_ECHELON_FORM_GF2_H
 
-// No point specialising if we aren't using libm4ri
 #ifdef __LELA_HAVE_M4RI
-
-#include <m4ri/m4ri.h>
+#  include <m4ri/m4ri.h>
+#endif // __LELA_HAVE_M4RI
 
 #include "lela/util/commentator.h"
 #include "lela/ring/gf2.h"
@@ -25,36 +24,76 @@
 #include "lela/algorithms/elimination.h"
 #include "lela/algorithms/gauss-jordan.h"
 #include "lela/algorithms/faugere-lachartre.h"
-#include "lela/matrix/m4ri-matrix.h"
+#ifdef __LELA_HAVE_M4RI
+#  include "lela/matrix/m4ri-matrix.h"
+#else
+#  include "lela/algorithms/m4ri-elimination.h"
+#endif // __LELA_HAVE_M4RI
 #include "lela/blas/level1.h"
 #include "lela/blas/level3.h"
 
 namespace LELA
 {
 
-// Specialisation of EchelonForm to GF2 to take advantage of M4RI-routines
+// Specialisation of EchelonForm to GF2 to take advantage of
+// M4RI-routines, or of the native Method of the Four Russians if LELA
+// is configured without libm4ri
 template <>
 class EchelonForm<GF2, AllModules<GF2> >
 {
 	Context<GF2, AllModules<GF2> > &_ctx;
 	Elimination<GF2, AllModules<GF2> > _elim;
 	GaussJordan<GF2, AllModules<GF2> > _GJ;
+#ifndef __LELA_HAVE_M4RI
+	M4RIElimination<AllModules<GF2> > _M4RI;
+#endif // !__LELA_HAVE_M4RI
 
 	DenseMatrix<bool> _L;
-	GaussJordan<GF2, AllModules<GF2> >::Permutation _P;
+	GaussJordan<GF2, AllModules<GF2> >::Permutation _P, _Q;
 
 	// Map pointers to matrices to computed ranks
 	std::map<const void *, size_t> _rank_table;
 
+	// Replace the output of GaussJordan::pluq in A by the
+	// row-echelon form UQ; see EchelonForm::echelonFormFromPLUQ
+	void echelonFormFromPLUQ (DenseMatrix<bool> &A, size_t rank, bool reduced)
+	{
+		DenseMatrix<bool>::SubmatrixType U_11 (A, 0, 0, rank, rank);
+		DenseMatrix<bool>::SubmatrixType U_12 (A, 0, rank, rank, A.coldim () - rank);
+		DenseMatrix<bool>::SubmatrixType A_2 (A, rank, 0, A.rowdim () - rank, A.coldim ());
+		DenseMatrix<bool>::SubmatrixType::RowIterator i;
+		size_t k;
+
+		if (reduced) {
+			BLAS3::trsm (_ctx, _ctx.F.one (), U_11, U_12, UpperTriangular, false);
+			BLAS3::scal (_ctx, _ctx.F.zero (), U_11);
+
+			for (k = 0; k < rank; ++k)
+				U_11.setEntry (k, k, _ctx.F.one ());
+		} else {
+			for (i = U_11.rowBegin (), k = 0; i != U_11.rowEnd (); ++i, ++k) {
+				VectorTraits<GF2, DenseMatrix<bool>::SubmatrixType::Row>::SubvectorType L_k (*i, 0, k);
+				BLAS1::scal (_ctx, _ctx.F.zero (), L_k);
+			}
+		}
+
+		BLAS3::scal (_ctx, _ctx.F.zero (), A_2);
+		BLAS3::permute_cols (_ctx, _Q.begin (), _Q.end (), A);
+	}
+
 public:
-	enum Method { METHOD_UNKNOWN, METHOD_STANDARD_GJ, METHOD_ASYMPTOTICALLY_FAST_GJ, METHOD_M4RI, METHOD_FAUGERE_LACHARTRE };
+	enum Method { METHOD_UNKNOWN, METHOD_STANDARD_GJ, METHOD_ASYMPTOTICALLY_FAST_GJ, METHOD_M4RI, METHOD_FAUGERE_LACHARTRE, METHOD_PLUQ };
 
+#ifdef __LELA_HAVE_M4RI
 	EchelonForm (Context<GF2, AllModules<GF2> > &ctx) : _ctx (ctx), _elim (ctx), _GJ (ctx) {}
+#else
+	EchelonForm (Context<GF2, AllModules<GF2> > &ctx) : _ctx (ctx), _elim (ctx), _GJ (ctx), _M4RI (ctx) {}
+#endif // __LELA_HAVE_M4RI
 
 	template <class Matrix>
 	Matrix &echelonize (Matrix &A, bool reduced = false, Method method = METHOD_STANDARD_GJ)
 	{
-		static const char *method_names[] = { "unknown", "standard", "recursive", "M4RI", "Faugère-Lachartre" };
+		static const char *method_names[] = { "unknown", "standard", "recursive", "M4RI", "Faugère-Lachartre", "recursive PLUQ" };
 
 		std::ostringstream str;
 		str << "Row-echelon form (method: " << method_names[method] << ")" << std::ends;
@@ -96,7 +135,7 @@ public:
 	// Specialisation for M4RI-matrices
 	DenseMatrix<bool> &echelonize (DenseMatrix<bool> &A, bool reduced = false, Method method = METHOD_M4RI)
 	{
-		static const char *method_names[] = { "unknown", "standard", "recursive", "M4RI", "Faugère-Lachartre" };
+		static const char *method_names[] = { "unknown", "standard", "recursive", "M4RI", "Faugère-Lachartre", "recursive PLUQ" };
 
 		std::ostringstream str;
 		str << "Row-echelon form (method: " << method_names[method] << ")" << std::ends;
@@ -130,7 +169,12 @@ public:
 			break;
 
 		case METHOD_M4RI:
+#ifdef __LELA_HAVE_M4RI
 			mzd_echelonize_pluq (A._rep, reduced ? 1 : 0);
+#else
+			_M4RI.echelonize (A, _P, rank, reduced);
+			_rank_table[&A] = rank;
+#endif // __LELA_HAVE_M4RI
 			break;
 
 		case METHOD_FAUGERE_LACHARTRE:
@@ -142,6 +186,12 @@ public:
 				throw LELAError ("Only reduced row-echelon form is available with Faugère-Lachartre");
 			break;
 
+		case METHOD_PLUQ:
+			_GJ.pluq (A, _P, _Q, rank, d);
+			echelonFormFromPLUQ (A, rank, reduced);
+			_rank_table[&A] = rank;
+			break;
+
 		default:
 			throw LELAError ("Invalid method for choice of matrix");
 		}
@@ -183,8 +233,6 @@ public:
 
 } // namespace LELA
 
-#endif // __LELA_HAVE_M4RI
-
 #endif // __LELA_SOLUTIONS_ECHELON_FORM_GF2_H
 
 // Local Variables:
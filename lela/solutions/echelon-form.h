@@ -36,13 +36,41 @@ class EchelonForm
 	GaussJordan<Ring, Modules> GJ;
 
 	DenseMatrix<typename Ring::Element> L;
-	typename GaussJordan<Ring, Modules>::Permutation P;
+	typename GaussJordan<Ring, Modules>::Permutation P, Q;
 
 	// Map pointers to matrices to computed ranks
 	std::map<const void *, size_t> _rank_table;
 
+	// Replace the output of GaussJordan::pluq in A by the
+	// row-echelon form UQ, using that the PLUQ-decomposition reveals
+	// the column rank profile
+	void echelonFormFromPLUQ (DenseMatrix<typename Ring::Element> &A, size_t rank, bool reduced)
+	{
+		typename DenseMatrix<typename Ring::Element>::SubmatrixType U_11 (A, 0, 0, rank, rank);
+		typename DenseMatrix<typename Ring::Element>::SubmatrixType U_12 (A, 0, rank, rank, A.coldim () - rank);
+		typename DenseMatrix<typename Ring::Element>::SubmatrixType A_2 (A, rank, 0, A.rowdim () - rank, A.coldim ());
+		typename DenseMatrix<typename Ring::Element>::SubmatrixType::RowIterator i;
+		size_t k;
+
+		if (reduced) {
+			BLAS3::trsm (_ctx, _ctx.F.one (), U_11, U_12, UpperTriangular, false);
+			BLAS3::scal (_ctx, _ctx.F.zero (), U_11);
+
+			for (k = 0; k < rank; ++k)
+				U_11.setEntry (k, k, _ctx.F.one ());
+		} else {
+			for (i = U_11.rowBegin (), k = 0; i != U_11.rowEnd (); ++i, ++k) {
+				typename VectorTraits<Ring, typename DenseMatrix<typename Ring::Element>::SubmatrixType::Row>::SubvectorType L_k (*i, 0, k);
+				BLAS1::scal (_ctx, _ctx.F.zero (), L_k);
+			}
+		}
+
+		BLAS3::scal (_ctx, _ctx.F.zero (), A_2);
+		BLAS3::permute_cols (_ctx, Q.begin (), Q.end (), A);
+	}
+
 public:
-	enum Method { METHOD_UNKNOWN, METHOD_STANDARD_GJ, METHOD_ASYMPTOTICALLY_FAST_GJ, METHOD_FAUGERE_LACHARTRE };
+	enum Method { METHOD_UNKNOWN, METHOD_STANDARD_GJ, METHOD_ASYMPTOTICALLY_FAST_GJ, METHOD_FAUGERE_LACHARTRE, METHOD_PLUQ };
 
 	/** Constructor
 	 *
@@ -60,7 +88,7 @@ public:
 	template <class Matrix>
 	Matrix &echelonize (Matrix &A, bool reduced = false, Method method = METHOD_STANDARD_GJ)
 	{
-		static const char *method_names[] = { "unknown", "standard", "recursive", "Faugère-Lachartre" };
+		static const char *method_names[] = { "unknown", "standard", "recursive", "Faugère-Lachartre", "recursive PLUQ" };
 
 		std::ostringstream str;
 		str << "Row-echelon form (method: " << method_names[method] << ")" << std::ends;
@@ -102,7 +130,7 @@ public:
 	// Specialisation for dense matrices
 	DenseMatrix<typename Ring::Element> &echelonize (DenseMatrix<typename Ring::Element> &A, bool reduced = false, Method method = METHOD_ASYMPTOTICALLY_FAST_GJ)
 	{
-		static const char *method_names[] = { "unknown", "standard", "recursive", "Faugère-Lachartre" };
+		static const char *method_names[] = { "unknown", "standard", "recursive", "Faugère-Lachartre", "recursive PLUQ" };
 
 		std::ostringstream str;
 		str << "Row-echelon form (method: " << method_names[method] << ")" << std::ends;
@@ -142,6 +170,11 @@ public:
 				throw LELAError ("Only reduced row-echelon form is available with Faugère-Lachartre");
 			break;
 
+		case METHOD_PLUQ:
+			GJ.pluq (A, P, Q, rank, d);
+			echelonFormFromPLUQ (A, rank, reduced);
+			break;
+
 		default:
 			throw LELAError ("Invalid method for choice of matrix");
 		}
@@ -0,0 +1,505 @@
+/* lela/solutions/multimodular.h
+ * Copyright 2011 Bradford Hovinen
+ *
+ * Written by Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Rank, determinant, and echelon-form over Z and Q by computing
+ * modulo several word-size primes
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_SOLUTIONS_MULTIMODULAR_H
+#define __LELA_SOLUTIONS_MULTIMODULAR_H
+
+#include <vector>
+
+#include "lela/integer.h"
+#include "lela/ring/integers.h"
+#include "lela/ring/rationals.h"
+#include "lela/ring/modular.h"
+#include "lela/blas/context.h"
+#include "lela/algorithms/elimination.h"
+#include "lela/solutions/echelon-form.h"
+#include "lela/matrix/dense.h"
+#include "lela/util/commentator.h"
+#include "lela/util/thread.h"
+#include "lela/util/error.h"
+
+namespace LELA
+{
+
+/** Traits for moving between a ring of characteristic zero and its
+ * images modulo word-size primes
+ *
+ * \ingroup solutions
+ */
+template <class Ring>
+struct MultimodularTraits;
+
+template <>
+struct MultimodularTraits<Integers>
+{
+	typedef Integers Ring;
+	typedef Integers::Element Element;
+
+	/// Reduce a modulo the modulus of F; always succeeds
+	static bool reduce (uint32 &x, const Modular<uint32> &F, const Integers &R, const Element &a)
+		{ x = mpz_fdiv_ui (a.get_mpz_t (), F._modulus); return true; }
+
+	/// Recover x from its residue a modulo M, assuming |x| < M/2; always succeeds
+	static bool reconstruct (Element &x, const Integers &R, const integer &a, const integer &M)
+	{
+		if (a > M / 2)
+			x = a - M;
+		else
+			x = a;
+
+		return true;
+	}
+};
+
+template <>
+struct MultimodularTraits<Rationals>
+{
+	typedef Rationals Ring;
+	typedef Rationals::Element Element;
+
+	/// Reduce a modulo the modulus of F; fails if the modulus divides the denominator of a
+	static bool reduce (uint32 &x, const Modular<uint32> &F, const Rationals &R, const Element &a)
+	{
+		integer num, den;
+
+		R.get_num (num, a);
+		R.get_den (den, a);
+
+		return F.div (x, mpz_fdiv_ui (num.get_mpz_t (), F._modulus), mpz_fdiv_ui (den.get_mpz_t (), F._modulus));
+	}
+
+	/** Recover x = n/d from its residue a modulo M by rational
+	 * reconstruction, assuming |n|, d <= sqrt (M/2)
+	 *
+	 * @returns true if such n/d exists, false otherwise
+	 */
+	static bool reconstruct (Element &x, const Rationals &R, const integer &a, const integer &M)
+	{
+		integer bound, r0 = M, r1 = a, t0 = 0, t1 = 1, q, tmp;
+
+		mpz_sqrt (bound.get_mpz_t (), integer (M / 2).get_mpz_t ());
+
+		// Extended Euclidean algorithm on M and a, stopped at
+		// the first remainder within the bound
+		while (r1 > bound) {
+			q = r0 / r1;
+			tmp = r0 - q * r1; r0 = r1; r1 = tmp;
+			tmp = t0 - q * t1; t0 = t1; t1 = tmp;
+		}
+
+		if (abs (t1) > bound)
+			return false;
+
+		mpz_gcd (tmp.get_mpz_t (), r1.get_mpz_t (), t1.get_mpz_t ());
+
+		if (tmp != 1)
+			return false;
+
+		R.init (x, r1, t1);
+
+		return true;
+	}
+};
+
+/** Solution for computing the rank, determinant, and reduced
+ * row-echelon form of a matrix over Integers or Rationals by
+ * multimodular reduction
+ *
+ * The input is reduced modulo word-size primes, counting down from
+ * 2^31 - 1, and the computation is done over Modular<uint32> by
+ * EchelonForm and Elimination, one prime per job on a ThreadGroup.
+ * The results are then combined by the Chinese remainder theorem and
+ * lifted to Z or Q by symmetric resp. rational reconstruction.
+ *
+ * There is no a priori bound on the number of primes: the
+ * computation stops as soon as the reconstruction agrees with the
+ * images modulo the next few primes. So the result is correct only
+ * with high probability, as is the rank, which is taken to be the
+ * largest rank modulo any of the primes.
+ *
+ * For the echelon-form, images whose pivot-columns differ from the
+ * best seen so far come from unlucky primes and are discarded.
+ * Primes dividing a denominator of the input are skipped.
+ *
+ * \ingroup solutions
+ */
+template <class Ring, class Modules = AllModules<Ring> >
+class Multimodular
+{
+public:
+	/** Constructor
+	 *
+	 * @param ctx Context over which the input is defined
+	 * @param num_threads Number of primes to handle at once; 0 means one per available processor
+	 * @param checks Number of consecutive primes with which the reconstruction must agree before it is accepted; at least 1
+	 */
+	Multimodular (Context<Ring, Modules> &ctx, size_t num_threads = 0, size_t checks = 1)
+		: _ctx (ctx), _threads (num_threads), _checks (checks)
+	{
+		// Without a check no prime is ever computed, so there
+		// would be nothing to reconstruct
+		if (checks < 1)
+			throw LELAError ("Multimodular needs at least one check");
+	}
+
+	/** Determine the rank of a matrix
+	 *
+	 * @param A Input matrix
+	 * @returns rank
+	 */
+	template <class Matrix>
+	size_t rank (const Matrix &A)
+	{
+		commentator.start ("Rank (multimodular)", __FUNCTION__);
+
+		std::vector<typename MultimodularTraits<Rationals>::Element> values;
+		std::vector<size_t> profile;
+
+		lift<MultimodularTraits<Rationals> > (_Q, A, MODE_RANK, values, profile);
+
+		commentator.stop (MSG_DONE);
+
+		return profile.size ();
+	}
+
+	/** Compute the determinant of a square matrix
+	 *
+	 * @param d Ring-element into which to store the determinant
+	 * @param A Input matrix
+	 * @returns Reference to d
+	 */
+	template <class Matrix>
+	typename Ring::Element &det (typename Ring::Element &d, const Matrix &A)
+	{
+		lela_check (A.rowdim () == A.coldim ());
+
+		commentator.start ("Determinant (multimodular)", __FUNCTION__);
+
+		std::vector<typename Ring::Element> values;
+		std::vector<size_t> profile;
+
+		lift<MultimodularTraits<Ring> > (_ctx.F, A, MODE_DETERMINANT, values, profile);
+
+		d = values[0];
+
+		commentator.stop (MSG_DONE);
+
+		return d;
+	}
+
+	/** Compute the reduced row-echelon form of a matrix
+	 *
+	 * @param E Matrix over Rationals into which to store the
+	 * reduced row-echelon form; must have the same dimensions as A
+	 * @param A Input matrix
+	 * @param rank Integer into which to store the rank of A
+	 * @returns Reference to E
+	 */
+	template <class Matrix>
+	DenseMatrix<Rationals::Element> &echelonize_reduced (DenseMatrix<Rationals::Element> &E, const Matrix &A, size_t &rank)
+	{
+		lela_check (E.rowdim () == A.rowdim ());
+		lela_check (E.coldim () == A.coldim ());
+
+		commentator.start ("Reduced row-echelon form (multimodular)", __FUNCTION__);
+
+		std::vector<Rationals::Element> values;
+		std::vector<size_t> profile;
+
+		lift<MultimodularTraits<Rationals> > (_Q, A, MODE_ECHELON_FORM, values, profile);
+
+		rank = profile.size ();
+
+		DenseMatrix<Rationals::Element>::RowIterator i_E;
+		DenseMatrix<Rationals::Element>::Row::iterator j_E;
+		std::vector<Rationals::Element>::const_iterator v = values.begin ();
+		size_t i;
+
+		for (i_E = E.rowBegin (), i = 0; i_E != E.rowEnd (); ++i_E, ++i)
+			for (j_E = i_E->begin (); j_E != i_E->end (); ++j_E)
+				_Q.copy (*j_E, _Q.zero ());
+
+		for (i_E = E.rowBegin (), i = 0; i < rank; ++i_E, ++i)
+			for (j_E = i_E->begin (); j_E != i_E->end (); ++j_E, ++v)
+				*j_E = *v;
+
+		commentator.stop (MSG_DONE);
+
+		return E;
+	}
+
+private:
+	enum Mode { MODE_RANK, MODE_DETERMINANT, MODE_ECHELON_FORM };
+
+	// Result of a computation modulo one prime
+	struct Image
+	{
+		uint32 p;
+
+		// False if p divides a denominator of the input
+		bool valid;
+
+		// Pivot-columns of the echelon-form
+		std::vector<size_t> profile;
+
+		// Values to be lifted: the determinant or the entries of
+		// the nonzero rows of the reduced echelon-form
+		std::vector<uint32> values;
+	};
+
+	template <class Matrix>
+	class PrimeJob : public ThreadGroup::Job
+	{
+		const Ring &_R;
+		const Matrix &_A;
+		Mode _mode;
+		Image &_image;
+
+	public:
+		PrimeJob (const Ring &R, const Matrix &A, Mode mode, Image &image)
+			: _R (R), _A (A), _mode (mode), _image (image) {}
+
+		void run ()
+		{
+			Modular<uint32> F (_image.p);
+			Context<Modular<uint32> > ctx (F);
+			DenseMatrix<uint32> Ap (_A.rowdim (), _A.coldim ());
+
+			_image.profile.clear ();
+			_image.values.clear ();
+			_image.valid = reduceMatrix (F, Ap);
+
+			if (!_image.valid)
+				return;
+
+			if (_mode == MODE_DETERMINANT) {
+				Elimination<Modular<uint32> > elim (ctx);
+				Elimination<Modular<uint32> >::Permutation P;
+				Elimination<Modular<uint32> >::Permutation::const_iterator t;
+				size_t rank;
+				uint32 d;
+
+				elim.echelonize (Ap, P, rank, d, false);
+
+				if (rank < Ap.rowdim ())
+					d = 0;
+
+				for (t = P.begin (); t != P.end (); ++t)
+					if (t->first != t->second)
+						F.negin (d);
+
+				_image.values.push_back (d);
+			} else {
+				EchelonForm<Modular<uint32> > EF (ctx);
+				DenseMatrix<uint32>::RowIterator i;
+				DenseMatrix<uint32>::Row::iterator j;
+				uint32 a;
+
+				EF.echelonize (Ap, _mode == MODE_ECHELON_FORM);
+
+				for (i = Ap.rowBegin (); i != Ap.rowEnd (); ++i) {
+					for (j = i->begin (); j != i->end () && *j == 0; ++j);
+
+					if (j == i->end ())
+						break;
+
+					_image.profile.push_back (j - i->begin ());
+
+					// Only the echelon-form with unit pivots is
+					// unique, so normalise the row before lifting it
+					if (_mode == MODE_ECHELON_FORM) {
+						F.inv (a, *j);
+						BLAS1::scal (ctx, a, *i);
+						_image.values.insert (_image.values.end (), i->begin (), i->end ());
+					}
+				}
+			}
+		}
+
+	private:
+		bool reduceMatrix (const Modular<uint32> &F, DenseMatrix<uint32> &Ap)
+		{
+			typename Matrix::ConstRawIterator r_A;
+			typename Matrix::ConstRawIndexedIterator i_A;
+			uint32 x;
+
+			for (i_A = _A.rawIndexedBegin (), r_A = _A.rawBegin (); i_A != _A.rawIndexedEnd (); ++i_A, ++r_A) {
+				if (!MultimodularTraits<Ring>::reduce (x, F, _R, *r_A))
+					return false;
+
+				Ap.setEntry (i_A->first, i_A->second, x);
+			}
+
+			return true;
+		}
+	};
+
+	Context<Ring, Modules> &_ctx;
+	Rationals _Q;
+	ThreadGroup _threads;
+	size_t _checks;
+
+	// Next word-size prime below p
+	static uint32 previousPrime (uint32 p)
+	{
+		integer q;
+
+		do {
+			p -= 2;
+			q = p;
+		} while (!mpz_probab_prime_p (q.get_mpz_t (), 25));
+
+		return p;
+	}
+
+	// Return 1 if the pivots profile1 come from a lucky prime and
+	// profile2 from an unlucky one, -1 if the other way around,
+	// and 0 if they are equal. A matrix has only more pivots
+	// and pivots further to the left than its reductions.
+	static int compareProfiles (const std::vector<size_t> &profile1, const std::vector<size_t> &profile2)
+	{
+		if (profile1.size () != profile2.size ())
+			return (profile1.size () > profile2.size ()) ? 1 : -1;
+
+		for (size_t k = 0; k < profile1.size (); ++k)
+			if (profile1[k] != profile2[k])
+				return (profile1[k] < profile2[k]) ? 1 : -1;
+
+		return 0;
+	}
+
+	// Determine whether the candidate-result agrees with the given image
+	template <class Traits>
+	static bool agrees (const typename Traits::Ring &S, const std::vector<typename Traits::Element> &result, const Image &image)
+	{
+		Modular<uint32> F (image.p);
+		uint32 x;
+
+		for (size_t k = 0; k < result.size (); ++k)
+			if (!Traits::reduce (x, F, S, result[k]) || x != image.values[k])
+				return false;
+
+		return true;
+	}
+
+	// Combine the residues X modulo M with the image modulo p by
+	// the Chinese remainder theorem
+	static void combine (std::vector<integer> &X, integer &M, const Image &image)
+	{
+		Modular<uint32> F (image.p);
+		uint32 Minv = mpz_fdiv_ui (M.get_mpz_t (), image.p), x, t;
+
+		F.invin (Minv);
+
+		for (size_t k = 0; k < X.size (); ++k) {
+			x = mpz_fdiv_ui (X[k].get_mpz_t (), image.p);
+			F.sub (t, image.values[k], x);
+			F.mulin (t, Minv);
+			X[k] += M * t;
+		}
+
+		M *= image.p;
+	}
+
+	// Compute the images of A modulo further primes until the
+	// reconstruction over S of the combined images is confirmed
+	// by _checks further primes
+	template <class Traits, class Matrix>
+	void lift (const typename Traits::Ring &S, const Matrix &A, Mode mode, std::vector<typename Traits::Element> &result, std::vector<size_t> &profile)
+	{
+		std::vector<Image> images (_threads.size ());
+		std::vector<PrimeJob<Matrix> > prime_jobs;
+		std::vector<ThreadGroup::Job *> jobs;
+		typename std::vector<Image>::iterator image;
+
+		std::vector<integer> X;
+		integer M;
+		uint32 p = 2147483647U + 2U;
+		size_t num_primes = 0, num_bad_primes = 0, confirmations = 0;
+		bool have_image = false, have_candidate = false;
+
+		prime_jobs.reserve (images.size ());
+
+		for (image = images.begin (); image != images.end (); ++image) {
+			prime_jobs.push_back (PrimeJob<Matrix> (_ctx.F, A, mode, *image));
+			jobs.push_back (&prime_jobs.back ());
+		}
+
+		while (confirmations < _checks) {
+			for (image = images.begin (); image != images.end (); ++image)
+				image->p = p = previousPrime (p);
+
+			_threads.run (jobs);
+
+			for (image = images.begin (); image != images.end () && confirmations < _checks; ++image) {
+				++num_primes;
+
+				if (!image->valid) {
+					++num_bad_primes;
+					continue;
+				}
+
+				if (have_image) {
+					int c = compareProfiles (image->profile, profile);
+
+					if (c < 0) {
+						++num_bad_primes;
+						continue;
+					} else if (c > 0)
+						have_image = have_candidate = false;
+				}
+
+				if (!have_image) {
+					profile = image->profile;
+					X.assign (image->values.size (), integer (0));
+					M = 1;
+					confirmations = 0;
+					have_image = true;
+				}
+
+				if (have_candidate && agrees<Traits> (S, result, *image))
+					++confirmations;
+				else {
+					combine (X, M, *image);
+					have_candidate = false;
+					confirmations = 0;
+				}
+			}
+
+			if (have_image && !have_candidate) {
+				result.resize (X.size ());
+				have_candidate = true;
+
+				for (size_t k = 0; k < X.size () && have_candidate; ++k)
+					have_candidate = Traits::reconstruct (result[k], S, X[k], M);
+			}
+		}
+
+		commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+			<< "Used " << num_primes << " primes, of which " << num_bad_primes << " were unlucky" << std::endl;
+	}
+};
+
+} // namespace LELA
+
+#endif // __LELA_SOLUTIONS_MULTIMODULAR_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -27,6 +27,7 @@
 #include <cstring>
 
 #include "lela/util/timer.h"
+#include "lela/util/thread.h"
 
 #ifndef MAX
 #  define MAX(a,b) (((a) > (b)) ? (a) : (b))
@@ -237,6 +238,17 @@ public:
 	 */
 	void indent (std::ostream &stream) const;
 
+	/** Report the counters of the profiler
+	 *
+	 * Writes the call-count, total and self time, and bytes
+	 * allocated of each activity marked with LELA_PROFILE, summed
+	 * over all threads. See @ref Profiler.
+	 *
+	 * @param level Level of detail of the message
+	 * @param msg_class Type of message
+	 */
+	void reportProfile (long level = LEVEL_IMPORTANT, const char *msg_class = TIMING_MEASURE);
+
 	//@} Reporting facilities
 
 	/** @name Activity stack restoration
@@ -423,7 +435,7 @@ public:
 	 * @return true if stream is the null stream; false otherwise
 	 */
 	bool isNullStream (const std::ostream &str) 
-		{ return &str == &cnull; }
+		{ return &str == &cnull || &str == ThreadGroup::workerNullStream (); }
 
 	/** Set output stream for brief report
 	 * @param stream Output stream
@@ -753,6 +765,7 @@ public:
 
 	inline std::ostream &report (long , const char *) { return cnull; }
 	inline void indent (std::ostream &) {}
+	inline void reportProfile (long = LEVEL_IMPORTANT, const char * = TIMING_MEASURE) {}
 
 	enum OutputFormat
 		{ OUTPUT_CONSOLE, OUTPUT_PIPE };
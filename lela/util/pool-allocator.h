@@ -0,0 +1,294 @@
+/* lela/util/pool-allocator.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Written by Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Slab-allocator with size-class free lists for row-storage
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_UTIL_POOL_ALLOCATOR_H
+#define __LELA_UTIL_POOL_ALLOCATOR_H
+
+#include <vector>
+#include <new>
+#include <cstddef>
+
+namespace LELA
+{
+
+/** Pool of memory for the rows of one matrix
+ *
+ * The pool takes memory from the system in large slabs and hands it
+ * out in blocks whose sizes are powers of two, from 16 bytes up to
+ * max_block bytes. A freed block goes onto the free list of its size
+ * and is handed out again at the next request of that size, so a row
+ * which grows and shrinks, as the rows of a matrix under sparse
+ * elimination do, reuses the blocks which other rows have given up
+ * rather than going back to malloc. Requests larger than max_block go
+ * directly to operator new.
+ *
+ * Memory in the slabs is only returned to the system when the pool is
+ * destroyed or released. Blocks of one size cannot serve requests of
+ * another, so a long computation may leave much memory on the free
+ * lists; @ref PooledSparseMatrix::compact moves the rows of a matrix
+ * to a fresh pool to give it back.
+ *
+ * A pool is not thread-safe, and may not be copied.
+ *
+ * \ingroup util
+ */
+class Pool
+{
+public:
+	/// Number of size-classes
+	static const size_t classes = 13;
+
+	/// Size of the smallest block
+	static const size_t min_block = 16;
+
+	/// Size of the largest block taken from a slab
+	static const size_t max_block = min_block << (classes - 1);
+
+	/// Default size of a slab
+	static const size_t default_slab_size = 1 << 18;
+
+	/** Construct an empty pool
+	 *
+	 * @param slab_size Size in bytes of each slab taken from the system
+	 */
+	Pool (size_t slab_size = default_slab_size)
+		: _slab_size (slab_size < max_block ? max_block : slab_size), _cur (NULL), _end (NULL),
+		  _held (0), _in_use (0), _allocations (0), _system_allocations (0)
+	{
+		for (size_t c = 0; c < classes; ++c)
+			_free[c] = NULL;
+	}
+
+	~Pool () { release (); }
+
+	/** Allocate a block of at least the given size
+	 *
+	 * @param bytes Size in bytes
+	 * @returns Pointer to the block, aligned for any type
+	 */
+	void *allocate (size_t bytes)
+	{
+		++_allocations;
+
+		if (bytes > max_block) {
+			++_system_allocations;
+			_held += bytes;
+			_in_use += bytes;
+			return ::operator new (bytes);
+		}
+
+		size_t c = sizeClass (bytes), size = min_block << c;
+
+		_in_use += size;
+
+		if (_free[c] != NULL) {
+			FreeBlock *b = _free[c];
+			_free[c] = b->next;
+			return b;
+		}
+
+		if (_cur + size > _end)
+			newSlab ();
+
+		void *p = _cur;
+		_cur += size;
+		return p;
+	}
+
+	/** Return a block to the pool
+	 *
+	 * @param p Pointer given by allocate
+	 * @param bytes Size in bytes with which the block was allocated
+	 */
+	void deallocate (void *p, size_t bytes)
+	{
+		if (bytes > max_block) {
+			_held -= bytes;
+			_in_use -= bytes;
+			::operator delete (p);
+			return;
+		}
+
+		size_t c = sizeClass (bytes);
+		FreeBlock *b = static_cast<FreeBlock *> (p);
+
+		_in_use -= min_block << c;
+		b->next = _free[c];
+		_free[c] = b;
+	}
+
+	/** Return all memory of the pool to the system
+	 *
+	 * Blocks larger than max_block are not tracked and must have
+	 * been deallocated before; blocks from the slabs become invalid.
+	 */
+	void release ()
+	{
+		for (std::vector<char *>::iterator i = _slabs.begin (); i != _slabs.end (); ++i)
+			::operator delete (*i);
+
+		_slabs.clear ();
+
+		for (size_t c = 0; c < classes; ++c)
+			_free[c] = NULL;
+
+		_cur = _end = NULL;
+		_held = _in_use = 0;
+	}
+
+	/// Number of bytes which the pool has taken from the system and not returned
+	size_t held () const { return _held; }
+
+	/// Number of bytes in blocks handed out and not yet returned
+	size_t inUse () const { return _in_use; }
+
+	/// Number of calls to allocate since construction
+	size_t allocations () const { return _allocations; }
+
+	/// Number of times the pool has gone to the system for memory since construction
+	size_t systemAllocations () const { return _system_allocations; }
+
+private:
+	struct FreeBlock { FreeBlock *next; };
+
+	Pool (const Pool &);
+	Pool &operator = (const Pool &);
+
+	static size_t sizeClass (size_t bytes)
+	{
+		size_t c = 0;
+
+		while ((min_block << c) < bytes)
+			++c;
+
+		return c;
+	}
+
+	// The rest of the current slab is cut into the largest blocks
+	// which fit and put on the free lists, so that no memory of
+	// the slab is lost
+	void newSlab ()
+	{
+		size_t c = classes;
+
+		while (c-- > 0) {
+			while (_cur + (min_block << c) <= _end) {
+				FreeBlock *b = reinterpret_cast<FreeBlock *> (_cur);
+				b->next = _free[c];
+				_free[c] = b;
+				_cur += min_block << c;
+			}
+		}
+
+		_cur = static_cast<char *> (::operator new (_slab_size));
+		_end = _cur + _slab_size;
+		_slabs.push_back (_cur);
+		_held += _slab_size;
+		++_system_allocations;
+	}
+
+	std::vector<char *> _slabs;
+	FreeBlock *_free[classes];
+	size_t _slab_size;
+	char *_cur, *_end;
+	size_t _held, _in_use, _allocations, _system_allocations;
+};
+
+/** Standard allocator taking its memory from a @ref Pool
+ *
+ * The allocator holds a pointer to the pool, which must outlive all
+ * containers using it. An allocator without a pool, which is what the
+ * default-constructor gives, takes its memory from operator new, so
+ * that containers with this allocator may also be used on their own.
+ *
+ * Two allocators are equal if they use the same pool. Containers with
+ * different pools must not swap their contents.
+ *
+ * \ingroup util
+ */
+template <class T>
+class PoolAllocator
+{
+public:
+	typedef T value_type;
+	typedef T *pointer;
+	typedef const T *const_pointer;
+	typedef T &reference;
+	typedef const T &const_reference;
+	typedef size_t size_type;
+	typedef ptrdiff_t difference_type;
+
+	template <class U>
+	struct rebind { typedef PoolAllocator<U> other; };
+
+	PoolAllocator () : _pool (NULL) {}
+
+	explicit PoolAllocator (Pool *pool) : _pool (pool) {}
+
+	template <class U>
+	PoolAllocator (const PoolAllocator<U> &a) : _pool (a.pool ()) {}
+
+	pointer address (reference x) const { return &x; }
+	const_pointer address (const_reference x) const { return &x; }
+
+	pointer allocate (size_type n, const void * = 0)
+	{
+		if (n > max_size ())
+			throw std::bad_alloc ();
+
+		if (_pool == NULL)
+			return static_cast<pointer> (::operator new (n * sizeof (T)));
+		else
+			return static_cast<pointer> (_pool->allocate (n * sizeof (T)));
+	}
+
+	void deallocate (pointer p, size_type n)
+	{
+		if (_pool == NULL)
+			::operator delete (p);
+		else
+			_pool->deallocate (p, n * sizeof (T));
+	}
+
+	size_type max_size () const { return size_type (-1) / sizeof (T); }
+
+	void construct (pointer p, const T &x) { new (p) T (x); }
+	void destroy (pointer p) { p->~T (); }
+
+	/// The pool from which the allocator takes its memory, or NULL
+	Pool *pool () const { return _pool; }
+
+private:
+	Pool *_pool;
+};
+
+template <class T, class U>
+inline bool operator == (const PoolAllocator<T> &a, const PoolAllocator<U> &b)
+	{ return a.pool () == b.pool (); }
+
+template <class T, class U>
+inline bool operator != (const PoolAllocator<T> &a, const PoolAllocator<U> &b)
+	{ return a.pool () != b.pool (); }
+
+} // namespace LELA
+
+#endif // __LELA_UTIL_POOL_ALLOCATOR_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
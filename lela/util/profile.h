@@ -0,0 +1,203 @@
+/* lela/util/profile.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Written by Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Low-overhead per-thread profiling of activities
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_UTIL_PROFILE_H
+#define __LELA_UTIL_PROFILE_H
+
+#include <map>
+#include <string>
+#include <iostream>
+#include <cstddef>
+
+#include "lela/lela-config.h"
+
+namespace LELA
+{
+
+/** Measurements for one activity
+ *
+ * \ingroup util
+ */
+struct ProfileCounter
+{
+	/// Number of times the activity was entered
+	unsigned long calls;
+
+	/// Total real time spent in the activity, in seconds
+	double total;
+
+	/// Part of total spent in activities nested in this one
+	double children;
+
+	/// Bytes allocated with operator new while this was the innermost activity
+	size_t bytes;
+
+	ProfileCounter () : calls (0), total (0.0), children (0.0), bytes (0) {}
+
+	/// Real time spent in the activity itself, in seconds
+	double self () const { return total - children; }
+};
+
+class ProfileScope;
+
+/** Counters of one thread
+ *
+ * Only the owning thread writes to these, so no locking is needed to
+ * update them. Activities are keyed by the address of their name,
+ * which must therefore be a string-constant.
+ */
+struct ProfileThreadData
+{
+	std::map<const char *, ProfileCounter> counters;
+	ProfileScope *current;
+
+	ProfileThreadData () : current (NULL) {}
+};
+
+/** Profiler for activities in hot code
+ *
+ * Unlike the commentator, which formats messages and maintains one
+ * stack of activities for the whole program, this keeps a separate set
+ * of counters for each thread, so that entering and leaving an
+ * activity costs two reads of the clock and a lookup in a small
+ * map. The counters of all threads are combined by name only when a
+ * summary is requested.
+ *
+ * Activities are marked with @ref LELA_PROFILE, which expands to
+ * nothing unless LELA was configured with --enable-profile, so that
+ * the instrumentation costs nothing otherwise. With profiling enabled,
+ * operator new is replaced as well, so that the bytes allocated in
+ * each activity are counted.
+ *
+ * Summaries read the counters of other threads without
+ * synchronisation, so they should only be requested when no other
+ * thread is inside a profiled activity, e.g. after @ref
+ * ThreadGroup::run has returned. The summary is written through the
+ * commentator with @ref Commentator::reportProfile.
+ *
+ * \ingroup util
+ */
+class Profiler
+{
+public:
+	/// Counters of all threads, combined by name of activity
+	typedef std::map<std::string, ProfileCounter> Summary;
+
+	/** Combine the counters of all threads
+	 *
+	 * @param summary Summary into which to add the counters
+	 */
+	static void summarize (Summary &summary);
+
+	/** Write a table of the counters of all threads
+	 *
+	 * @param os Stream to which to write
+	 * @returns Reference to os
+	 */
+	static std::ostream &write (std::ostream &os);
+
+	/** Reset the counters of all threads
+	 *
+	 * This must not be called while any thread is inside a
+	 * profiled activity.
+	 */
+	static void clear ();
+
+	/** Attribute allocated memory to the innermost activity of the calling thread
+	 *
+	 * @param bytes Number of bytes allocated
+	 */
+	static void countBytes (size_t bytes);
+
+	/// Whether LELA was built with profiling enabled
+	static bool enabled ();
+
+private:
+	friend class ProfileScope;
+
+	// Counters of the calling thread, created on first use
+	static ProfileThreadData &threadData ();
+
+	// Current real time in seconds
+	static double now ();
+};
+
+/** Activity to be profiled, from construction to destruction
+ *
+ * This is normally not used directly, but through @ref LELA_PROFILE.
+ *
+ * \ingroup util
+ */
+class ProfileScope
+{
+public:
+	/** Enter an activity
+	 *
+	 * @param name Name of the activity, which must be a string-constant
+	 */
+	ProfileScope (const char *name)
+		: _data (Profiler::threadData ()), _parent (_data.current)
+	{
+		_counter = &_data.counters[name];
+		_data.current = this;
+		_start = Profiler::now ();
+	}
+
+	~ProfileScope ()
+	{
+		double elapsed = Profiler::now () - _start;
+
+		++_counter->calls;
+		_counter->total += elapsed;
+
+		if (_parent != NULL)
+			_parent->_counter->children += elapsed;
+
+		_data.current = _parent;
+	}
+
+private:
+	friend class Profiler;
+
+	ProfileScope (const ProfileScope &);
+	ProfileScope &operator = (const ProfileScope &);
+
+	ProfileThreadData &_data;
+	ProfileScope *_parent;
+	ProfileCounter *_counter;
+	double _start;
+};
+
+} // namespace LELA
+
+/** \def LELA_PROFILE(name)
+ * Profile the rest of the enclosing block as the activity with the
+ * given name, which must be a string-constant. At most one may be used
+ * per block. Expands to nothing unless profiling is enabled.
+ */
+#ifdef __LELA_ENABLE_PROFILE
+#  define LELA_PROFILE(name) LELA::ProfileScope __lela_profile_scope (name)
+#else
+#  define LELA_PROFILE(name)
+#endif
+
+#endif // __LELA_UTIL_PROFILE_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
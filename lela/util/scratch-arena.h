@@ -0,0 +1,162 @@
+/* lela/util/scratch-arena.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Written by Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Reusable workspace for recursive matrix-algorithms
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_UTIL_SCRATCH_ARENA_H
+#define __LELA_UTIL_SCRATCH_ARENA_H
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+namespace LELA
+{
+
+/** Workspace for recursive matrix-algorithms
+ *
+ * A recursive algorithm such as Strassen-Winograd needs a few
+ * temporary matrices on each level of the recursion. Rather than
+ * constructing them at each call, it asks the arena for one
+ * workspace-matrix per level and takes its temporaries as submatrices
+ * of that. The workspace of each level is kept from one call to the
+ * next, so once a product of a given size has been computed, further
+ * products of at most that size allocate nothing.
+ *
+ * Sizes are measured in entries of the workspace-matrices. A limit
+ * on the total may be set; a request which would exceed it is refused,
+ * and the algorithm should then fall back to a method which needs no
+ * workspace.
+ *
+ * Copying an arena copies its limit but not its workspace, so copies
+ * of a module made for worker-threads never share workspace.
+ *
+ * \ingroup util
+ */
+class ScratchArena
+{
+	struct Level
+	{
+		virtual ~Level () {}
+	};
+
+	template <class Matrix>
+	struct MatrixLevel : public Level
+	{
+		Matrix W;
+
+		MatrixLevel (size_t rows, size_t cols) : W (rows, cols) {}
+	};
+
+	std::vector<Level *> _levels;
+	std::vector<size_t> _sizes;
+	size_t _size, _peak, _limit, _allocations;
+
+public:
+	ScratchArena () : _size (0), _peak (0), _limit (0), _allocations (0) {}
+
+	ScratchArena (const ScratchArena &arena) : _size (0), _peak (0), _limit (arena._limit), _allocations (0) {}
+
+	~ScratchArena () { release (); }
+
+	ScratchArena &operator = (const ScratchArena &arena)
+		{ release (); _limit = arena._limit; return *this; }
+
+	/** Get the workspace for one level of the recursion
+	 *
+	 * The workspace is replaced if the one kept for this level is
+	 * smaller than requested or of another type; the replacement
+	 * is large enough for both the old and the new request. Its
+	 * entries are whatever was left there by earlier use.
+	 *
+	 * @param level Level of the recursion, 0 at the top
+	 * @param rows Smallest row-dimension of the workspace
+	 * @param cols Smallest column-dimension of the workspace
+	 * @returns Pointer to the workspace, or NULL if allocating it would exceed the limit
+	 */
+	template <class Matrix>
+	Matrix *workspace (size_t level, size_t rows, size_t cols)
+	{
+		if (level >= _levels.size ()) {
+			_levels.resize (level + 1, NULL);
+			_sizes.resize (level + 1, 0);
+		}
+
+		MatrixLevel<Matrix> *l = dynamic_cast<MatrixLevel<Matrix> *> (_levels[level]);
+
+		if (l != NULL) {
+			if (l->W.rowdim () >= rows && l->W.coldim () >= cols)
+				return &l->W;
+
+			rows = std::max (rows, l->W.rowdim ());
+			cols = std::max (cols, l->W.coldim ());
+		}
+
+		if (_limit > 0 && _size - _sizes[level] + rows * cols > _limit)
+			return NULL;
+
+		delete _levels[level];
+		_size -= _sizes[level];
+
+		_levels[level] = l = new MatrixLevel<Matrix> (rows, cols);
+		_sizes[level] = rows * cols;
+		_size += rows * cols;
+		_peak = std::max (_peak, _size);
+		++_allocations;
+
+		return &l->W;
+	}
+
+	/** Free all workspace */
+	void release ()
+	{
+		for (std::vector<Level *>::iterator i = _levels.begin (); i != _levels.end (); ++i)
+			delete *i;
+
+		_levels.clear ();
+		_sizes.clear ();
+		_size = 0;
+	}
+
+	/** Number of entries of workspace currently held */
+	size_t size () const { return _size; }
+
+	/** Largest number of entries of workspace held at once since construction or the last call to resetPeak */
+	size_t peak () const { return _peak; }
+
+	/** Number of workspace-matrices allocated since construction */
+	size_t allocations () const { return _allocations; }
+
+	/** Restart the measurement of the peak from the current size */
+	void resetPeak () { _peak = _size; }
+
+	/** Largest number of entries of workspace which may be held at once; 0 for no limit */
+	size_t limit () const { return _limit; }
+
+	/** Set the largest number of entries of workspace which may be held at once; 0 for no limit
+	 *
+	 * Workspace already held is not freed; call release for that.
+	 */
+	void setLimit (size_t limit) { _limit = limit; }
+};
+
+} // namespace LELA
+
+#endif // __LELA_UTIL_SCRATCH_ARENA_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
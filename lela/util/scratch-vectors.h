@@ -0,0 +1,122 @@
+/* lela/util/scratch-vectors.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Written by Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Reusable temporary vectors for vector-operations
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_UTIL_SCRATCH_VECTORS_H
+#define __LELA_UTIL_SCRATCH_VECTORS_H
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+namespace LELA
+{
+
+/** Temporary vectors kept from one operation to the next
+ *
+ * Operations such as axpy on sparse vectors merge their inputs into
+ * a temporary vector and then exchange it with the output. Rather
+ * than constructing the temporary at each call, they take it from
+ * here, one vector of each type. After the exchange the temporary
+ * holds the old storage of the output, which the next call reuses, so
+ * that once the vectors have reached their final sizes no call
+ * allocates memory.
+ *
+ * Copying the object does not copy the vectors, so copies of a module
+ * made for worker-threads never share them.
+ *
+ * \ingroup util
+ */
+class ScratchVectors
+{
+	struct Slot
+	{
+		virtual ~Slot () {}
+	};
+
+	template <class Vector>
+	struct VectorSlot : public Slot
+	{
+		Vector v;
+	};
+
+	// The address of id identifies the type of the vector
+	template <class Vector>
+	struct Key
+	{
+		static char id;
+	};
+
+	std::vector<std::pair<const void *, Slot *> > _slots;
+	size_t _allocations;
+
+public:
+	ScratchVectors () : _allocations (0) {}
+
+	ScratchVectors (const ScratchVectors &) : _allocations (0) {}
+
+	~ScratchVectors () { release (); }
+
+	ScratchVectors &operator = (const ScratchVectors &)
+		{ release (); return *this; }
+
+	/** Get the temporary vector of the given type
+	 *
+	 * The vector is constructed with its default-constructor at
+	 * the first request. Its contents are whatever was left there
+	 * by earlier use; the caller should clear it. The reference
+	 * stays valid until release is called.
+	 */
+	template <class Vector>
+	Vector &get ()
+	{
+		const void *key = &Key<Vector>::id;
+
+		for (std::vector<std::pair<const void *, Slot *> >::iterator i = _slots.begin (); i != _slots.end (); ++i)
+			if (i->first == key)
+				return static_cast<VectorSlot<Vector> *> (i->second)->v;
+
+		VectorSlot<Vector> *s = new VectorSlot<Vector>;
+		_slots.push_back (std::pair<const void *, Slot *> (key, s));
+		++_allocations;
+
+		return s->v;
+	}
+
+	/** Free all vectors */
+	void release ()
+	{
+		for (std::vector<std::pair<const void *, Slot *> >::iterator i = _slots.begin (); i != _slots.end (); ++i)
+			delete i->second;
+
+		_slots.clear ();
+	}
+
+	/** Number of vectors constructed since construction */
+	size_t allocations () const { return _allocations; }
+};
+
+template <class Vector>
+char ScratchVectors::Key<Vector>::id;
+
+} // namespace LELA
+
+#endif // __LELA_UTIL_SCRATCH_VECTORS_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -268,6 +268,14 @@ public:
 	void clearVerticalBlocks ()
 		{ _vert_blocks.clear (); }
 
+	/** Get the blocks which divide the matrix horizontally */
+	const std::vector<Block> &horizontalBlocks () const
+		{ return _horiz_blocks; }
+
+	/** Get the blocks which divide the matrix vertically */
+	const std::vector<Block> &verticalBlocks () const
+		{ return _vert_blocks; }
+
 	/** Add a horizontal block with the given source so that the
 	 * total row-dimension matches what is requested.
 	 *
@@ -0,0 +1,107 @@
+/* lela/util/thread.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Written by Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Minimal support for running independent jobs on several threads
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_UTIL_THREAD_H
+#define __LELA_UTIL_THREAD_H
+
+#include <vector>
+#include <iosfwd>
+#include <cstddef>
+
+namespace LELA
+{
+
+/** Group of worker-threads
+ *
+ * This class runs a list of independent jobs on a fixed number of
+ * worker-threads and blocks until all of them have completed. Each
+ * worker takes the next unstarted job from the list until the list is
+ * exhausted, so jobs of uneven size are balanced automatically.
+ *
+ * If LELA was built without support for POSIX-threads, the jobs are
+ * run one after another in the calling thread.
+ *
+ * The commentator ignores all calls made from a worker-thread, so
+ * jobs may freely use code which reports through it, but nothing they
+ * report is shown.
+ *
+ * \ingroup util
+ */
+class ThreadGroup
+{
+public:
+	/** Unit of work to be run by a ThreadGroup */
+	class Job
+	{
+	public:
+		virtual ~Job () {}
+
+		/** Do the work. This is invoked exactly once from some worker-thread. */
+		virtual void run () = 0;
+	};
+
+	/** Construct a thread-group
+	 *
+	 * @param num_threads Maximum number of threads to run at
+	 * once; 0 means one per available processor
+	 */
+	ThreadGroup (size_t num_threads = 0);
+
+	/** Run the given jobs and wait until all have finished
+	 *
+	 * If any job throws an exception, the remaining jobs are
+	 * still run and a LELAError is thrown once all threads have
+	 * been joined.
+	 *
+	 * @param jobs Vector of pointers to jobs; ownership stays with the caller
+	 */
+	void run (const std::vector<Job *> &jobs);
+
+	/** Number of threads this group runs at once */
+	size_t size () const { return _num_threads; }
+
+	/** Number of processors currently online, or 1 if this cannot be determined */
+	static size_t availableProcessors ();
+
+	/** Determine whether the calling thread is running jobs for
+	 * a ThreadGroup with more than one thread
+	 *
+	 * This includes the thread which called run, while it takes
+	 * part in the work.
+	 */
+	static bool inWorker ();
+
+	/** Stream without buffer belonging to the calling
+	 * worker-thread, or NULL if inWorker () is false
+	 *
+	 * Output to the stream fails silently. Each worker has its
+	 * own, so that the workers never share its error-state.
+	 */
+	static std::ostream *workerNullStream ();
+
+private:
+	size_t _num_threads;
+};
+
+} // namespace LELA
+
+#endif // __LELA_UTIL_THREAD_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -40,6 +40,9 @@ struct WordTraits {
 	static const Word all_ones;
 
 	static inline bool ParallelParity (Word t);
+
+	/// Number of bits set in t
+	static inline unsigned int Popcount (Word t);
 };
 
 /** Specialisation for 8-bit words */
@@ -57,6 +60,12 @@ struct WordTraits<uint8> {
 		t &= 0xf;
 		return bool( (0x6996 >> t) & 0x1);
 	}
+
+	static inline unsigned int Popcount (Word t) {
+		t = t - ((t >> 1) & 0x55);
+		t = (t & 0x33) + ((t >> 2) & 0x33);
+		return (t + (t >> 4)) & 0x0f;
+	}
 };
 
 /** Specialisation for int */
@@ -77,6 +86,13 @@ struct WordTraits<unsigned int> {
 		t &= 0xf;
 		return bool( (0x6996 >> t) & 0x1);
 	}
+
+	static inline unsigned int Popcount (Word t) {
+		t = t - ((t >> 1) & 0x55555555U);
+		t = (t & 0x33333333U) + ((t >> 2) & 0x33333333U);
+		t = (t + (t >> 4)) & 0x0f0f0f0fU;
+		return (unsigned int) ((t * 0x01010101U) >> 24);
+	}
 };
 #elif __LELA_SIZEOF_INT == 8
 template <>
@@ -96,6 +112,13 @@ struct WordTraits<unsigned int> {
 		t &= 0xf;
 		return bool( (0x6996 >> t) & 0x1);
 	}
+
+	static inline unsigned int Popcount (Word t) {
+		t = t - ((t >> 1) & 0x5555555555555555ULL);
+		t = (t & 0x3333333333333333ULL) + ((t >> 2) & 0x3333333333333333ULL);
+		t = (t + (t >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+		return (unsigned int) ((t * 0x0101010101010101ULL) >> 56);
+	}
 };
 #endif // __LELA_SIZEOF_INT
 
@@ -117,6 +140,13 @@ struct WordTraits<unsigned long> {
 		t &= 0xf;
 		return bool( (0x6996 >> t) & 0x1);
 	}
+
+	static inline unsigned int Popcount (Word t) {
+		t = t - ((t >> 1) & 0x55555555U);
+		t = (t & 0x33333333U) + ((t >> 2) & 0x33333333U);
+		t = (t + (t >> 4)) & 0x0f0f0f0fU;
+		return (unsigned int) ((t * 0x01010101U) >> 24);
+	}
 };
 #elif __LELA_SIZEOF_LONG == 8
 template <>
@@ -136,6 +166,13 @@ struct WordTraits<unsigned long> {
 		t &= 0xf;
 		return bool( (0x6996 >> t) & 0x1);
 	}
+
+	static inline unsigned int Popcount (Word t) {
+		t = t - ((t >> 1) & 0x5555555555555555ULL);
+		t = (t & 0x3333333333333333ULL) + ((t >> 2) & 0x3333333333333333ULL);
+		t = (t + (t >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+		return (unsigned int) ((t * 0x0101010101010101ULL) >> 56);
+	}
 };
 #endif
 
@@ -158,6 +195,13 @@ struct WordTraits<unsigned long long> {
 		t &= 0xf;
 		return bool( (0x6996 >> t) & 0x1);
 	}
+
+	static inline unsigned int Popcount (Word t) {
+		t = t - ((t >> 1) & 0x5555555555555555ULL);
+		t = (t & 0x3333333333333333ULL) + ((t >> 2) & 0x3333333333333333ULL);
+		t = (t + (t >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+		return (unsigned int) ((t * 0x0101010101010101ULL) >> 56);
+	}
 };
 #elif __LELA_SIZEOF_LONG_LONG == 16
 template <>
@@ -178,6 +222,15 @@ struct WordTraits<unsigned long long> {
 		t &= 0xf;
 		return bool( (0x6996 >> t) & 0x1);
 	}
+
+	static inline unsigned int Popcount (Word t) {
+		unsigned int c = 0;
+
+		for (; t != 0; t &= t - 1)
+			++c;
+
+		return c;
+	}
 };
 #endif
 
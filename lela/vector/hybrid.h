@@ -26,13 +26,16 @@ struct HybridSubvectorWordAlignedTag;
  * This is a canonical implementation of the hybrid 0-1
  * vector-representation-type.
  *
+ * The vectors holding the indices and words may be given, e.g. to
+ * take their storage from a @ref Pool.
+ *
  * \ingroup vector
  */
-template <class _Endianness, class IndexType, class WordType>
-class HybridVector : public SparseVector<WordType, std::vector<IndexType>, std::vector<WordType> >
+template <class _Endianness, class IndexType, class WordType, class IndexVector = std::vector<IndexType>, class WordVector = std::vector<WordType> >
+class HybridVector : public SparseVector<WordType, IndexVector, WordVector>
 {
 public:
-	typedef SparseVector<WordType, std::vector<IndexType>, std::vector<WordType> > parent_type;
+	typedef SparseVector<WordType, IndexVector, WordVector> parent_type;
 
 	typedef VectorRepresentationTypes::Hybrid01 RepresentationType; 
 	typedef VectorStorageTypes::Transformed StorageType;
@@ -56,10 +59,14 @@ public:
 
 	HybridVector ()
 		{ init_vectors (); }
+
+	explicit HybridVector (const typename WordVector::allocator_type &a)
+		: parent_type (a)
+		{ init_vectors (); }
 		
 	template <class IV, class EV>
 	HybridVector (IV &iv, EV &ev)
-		: SparseVector<WordType, std::vector<IndexType>, std::vector<WordType> > (iv, ev)
+		: parent_type (iv, ev)
 	{
 		parent_type::_idx.insert (parent_type::_idx.begin (), iv.front () - 1);
 		parent_type::_elt.insert (parent_type::_elt.begin (), 0ULL);
@@ -69,7 +76,7 @@ public:
 
 	template <class IIt, class EIt>
 	HybridVector (IIt idx_begin, IIt idx_end, EIt elt_begin)
-		: SparseVector<WordType, std::vector<IndexType>, std::vector<WordType> > (idx_begin, idx_end, elt_begin)
+		: parent_type (idx_begin, idx_end, elt_begin)
 	{
 		parent_type::_idx.insert (parent_type::_idx.begin (), *idx_begin - 1);
 		parent_type::_elt.insert (parent_type::_elt.begin (), 0ULL);
@@ -161,8 +168,8 @@ namespace std
 {
 
 // Specialisation of std::swap to sparse vectors
-template <class Endianness, class IndexType, class WordType>
-void swap (LELA::HybridVector<Endianness, IndexType, WordType> &v1, LELA::HybridVector<Endianness, IndexType, WordType> &v2)
+template <class Endianness, class IndexType, class WordType, class IndexVector, class WordVector>
+void swap (LELA::HybridVector<Endianness, IndexType, WordType, IndexVector, WordVector> &v1, LELA::HybridVector<Endianness, IndexType, WordType, IndexVector, WordVector> &v2)
 	{ v1.swap (v2); }
 
 } // namespace std
@@ -0,0 +1,339 @@
+/* lela/vector/sliced-vector.h
+ * Copyright 2011 Bradford Hovinen <hovinen@gmail.com>
+ *
+ * Dense bit-sliced vectors over small prime fields
+ *
+ * -------------------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_VECTOR_SLICED_VECTOR_H
+#define __LELA_VECTOR_SLICED_VECTOR_H
+
+#include <iterator>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#include "lela/integer.h"
+#include "lela/vector/traits.h"
+#include "lela/vector/bit-iterator.h"
+
+namespace LELA
+{
+
+template <class word_iterator, class Endianness, size_t Planes>
+class SlicedVectorIterator;
+
+/** Raw entries of a @ref SlicedVector given as values of type T
+ *
+ * The entries of a sliced vector are the representatives 0, ..., p -
+ * 1, which only the integral types share with the ring. The elements
+ * of Modular<float> and Modular<double> lie in the symmetric range
+ * about zero and must be translated with sliced_rep and
+ * sliced_element, which know the modulus, so this does not compile
+ * for a floating-point type T.
+ */
+template <class T>
+struct SlicedRawEntry
+{
+	typedef char integral_types_only[std::numeric_limits<T>::is_integer ? 1 : -1];
+
+	static uint8 rep (T v) { return (uint8) v; }
+	static T value (uint8 v) { return (T) v; }
+};
+
+/** Reference to an entry of a @ref SlicedVector
+ *
+ * It holds an iterator to the first word of the block containing the
+ * entry and the position of the entry in the words of the block. If
+ * word_iterator is a const-iterator, the entry may only be read.
+ *
+ * The entry is read and written as its representative in 0, ..., p -
+ * 1; only integral values may be assigned (see @ref SlicedRawEntry).
+ */
+template <class word_iterator, class _Endianness, size_t Planes>
+class SlicedVectorReference
+{
+    public:
+	typedef _Endianness Endianness;
+	typedef typename std::iterator_traits<word_iterator>::value_type word_type;
+
+	SlicedVectorReference (word_iterator block, uint8 position)
+		: _block (block), _pos (position) {}
+
+	template <class Iterator>
+	SlicedVectorReference (const SlicedVectorReference<Iterator, Endianness, Planes> &r)
+		: _block (r._block), _pos (r._pos) {}
+
+	SlicedVectorReference &operator = (const SlicedVectorReference &a)
+		{ return assign ((uint8) a); }
+
+	template <class Iterator>
+	SlicedVectorReference &operator = (const SlicedVectorReference<Iterator, Endianness, Planes> &a)
+		{ return assign ((uint8) a); }
+
+	template <class T>
+	SlicedVectorReference &operator = (T v)
+		{ return assign (SlicedRawEntry<T>::rep (v)); }
+
+	operator uint8 () const
+	{
+		word_type e = Endianness::e_j (_pos);
+		uint8 v = 0;
+
+		for (size_t k = Planes; k-- > 0;)
+			v = (v << 1) | ((_block[k] & e) ? 1 : 0);
+
+		return v;
+	}
+
+    private:
+	template <class Iterator, class E, size_t P>
+	friend class SlicedVectorReference;
+
+	SlicedVectorReference &assign (uint8 v)
+	{
+		word_type e = Endianness::e_j (_pos);
+
+		for (size_t k = 0; k < Planes; ++k, v >>= 1)
+			_block[k] = (v & 1) ? (_block[k] | e) : (_block[k] & ~e);
+
+		return *this;
+	}
+
+	word_iterator _block;
+	uint8         _pos;
+};
+
+template <class word_iterator, class Endianness, size_t Planes>
+inline std::ostream &operator << (std::ostream &os, const SlicedVectorReference<word_iterator, Endianness, Planes> &a)
+	{ return os << (unsigned int) (uint8) a; }
+
+/** Iterator over the entries of a @ref SlicedVector */
+template <class word_iterator, class _Endianness, size_t Planes>
+class SlicedVectorIterator
+{
+    public:
+	typedef _Endianness Endianness;
+	typedef typename std::iterator_traits<word_iterator>::value_type word_type;
+
+	typedef std::random_access_iterator_tag iterator_category;
+	typedef uint8 value_type;
+	typedef long difference_type;
+	typedef SlicedVectorReference<word_iterator, Endianness, Planes> reference;
+	typedef void pointer;
+
+	SlicedVectorIterator () : _pos (0) {}
+
+	SlicedVectorIterator (word_iterator block, uint8 position)
+		: _block (block), _pos (position) {}
+
+	template <class Iterator>
+	SlicedVectorIterator (const SlicedVectorIterator<Iterator, Endianness, Planes> &i)
+		: _block (i._block), _pos (i._pos) {}
+
+	reference operator * () const
+		{ return reference (_block, _pos); }
+
+	reference operator [] (difference_type n) const
+		{ return *(*this + n); }
+
+	SlicedVectorIterator &operator ++ ()
+	{
+		if (++_pos == WordTraits<word_type>::bits) {
+			_pos = 0;
+			_block += Planes;
+		}
+
+		return *this;
+	}
+
+	SlicedVectorIterator operator ++ (int)
+		{ SlicedVectorIterator tmp (*this); ++*this; return tmp; }
+
+	SlicedVectorIterator &operator -- ()
+	{
+		if (_pos == 0) {
+			_pos = WordTraits<word_type>::bits;
+			_block -= Planes;
+		}
+
+		--_pos;
+
+		return *this;
+	}
+
+	SlicedVectorIterator operator -- (int)
+		{ SlicedVectorIterator tmp (*this); --*this; return tmp; }
+
+	SlicedVectorIterator &operator += (difference_type n)
+	{
+		difference_type index = (difference_type) _pos + n;
+		difference_type blocks = (index >= 0) ? index >> WordTraits<word_type>::logof_size
+			: -((-index + WordTraits<word_type>::pos_mask) >> WordTraits<word_type>::logof_size);
+
+		_block += blocks * (difference_type) Planes;
+		_pos = index - (blocks << WordTraits<word_type>::logof_size);
+
+		return *this;
+	}
+
+	SlicedVectorIterator &operator -= (difference_type n)
+		{ return *this += -n; }
+
+	SlicedVectorIterator operator + (difference_type n) const
+		{ SlicedVectorIterator tmp (*this); return tmp += n; }
+
+	SlicedVectorIterator operator - (difference_type n) const
+		{ SlicedVectorIterator tmp (*this); return tmp += -n; }
+
+	template <class Iterator>
+	difference_type operator - (const SlicedVectorIterator<Iterator, Endianness, Planes> &i) const
+		{ return ((_block - i._block) / (difference_type) Planes << WordTraits<word_type>::logof_size) + _pos - i._pos; }
+
+	template <class Iterator>
+	bool operator == (const SlicedVectorIterator<Iterator, Endianness, Planes> &i) const
+		{ return _block == i._block && _pos == i._pos; }
+
+	template <class Iterator>
+	bool operator != (const SlicedVectorIterator<Iterator, Endianness, Planes> &i) const
+		{ return _block != i._block || _pos != i._pos; }
+
+	template <class Iterator>
+	bool operator < (const SlicedVectorIterator<Iterator, Endianness, Planes> &i) const
+		{ return _block < i._block || (_block == i._block && _pos < i._pos); }
+
+    private:
+	template <class Iterator, class E, size_t P>
+	friend class SlicedVectorIterator;
+
+	word_iterator _block;
+	uint8         _pos;
+};
+
+/** Dense vector over a small prime field, stored bit-sliced
+ *
+ * The entries are divided into blocks of as many entries as a word
+ * has bits. Each block is stored in Planes consecutive words, the
+ * k-th of which holds bit k of each entry, at the position which
+ * Endianness gives as for @ref BitVector. The vector can then hold
+ * the elements of any prime field of characteristic less than
+ * 2^Planes: over GF(3) with Planes = 2 it holds 32 entries in each
+ * 64-bit word, and over GF(5) and GF(7) with Planes = 3 it holds 21.
+ *
+ * The word-iterators give all words of the vector, block after
+ * block. Entries of the last block beyond the size of the vector are
+ * always zero, so that operations may work on whole blocks.
+ *
+ * The entries themselves are given by proxy-references which convert
+ * to and from uint8, the representative in 0, ..., p - 1 of the
+ * entry; entries of Modular<float> and Modular<double> must be
+ * translated with sliced_rep and sliced_element. The vector is thus
+ * not a dense vector in the sense
+ * of @ref VectorRepresentationTypes::Dense. @ref SlicedModule, which is
+ * part of AllModules<Modular<Element> >, implements the level 1 BLAS
+ * on it and copies to and from ordinary dense vectors.
+ *
+ * @param Planes Number of bits of each entry
+ * @param Endianness Order of the entries in a word
+ *
+ * \ingroup vector
+ */
+template <size_t _Planes, class _Endianness = DefaultEndianness<uint64> >
+class SlicedVector
+{
+    public:
+	typedef uint8       value_type;
+	typedef size_t      size_type;
+	typedef long        difference_type;
+	typedef typename _Endianness::word word_type;
+	typedef typename std::vector<word_type>::iterator       word_iterator;
+	typedef typename std::vector<word_type>::const_iterator const_word_iterator;
+
+	typedef _Endianness Endianness;
+
+	static const size_t planes = _Planes;
+
+	typedef SlicedVectorReference<word_iterator, Endianness, _Planes> reference;
+	typedef SlicedVectorReference<const_word_iterator, Endianness, _Planes> const_reference;
+
+	typedef SlicedVectorIterator<word_iterator, Endianness, _Planes> iterator;
+	typedef SlicedVectorIterator<const_word_iterator, Endianness, _Planes> const_iterator;
+
+	typedef VectorRepresentationTypes::DenseSliced RepresentationType;
+	typedef VectorStorageTypes::Real StorageType;
+	typedef SlicedVector ContainerType;
+
+	SlicedVector () : _size (0) {}
+
+	SlicedVector (size_t n) : _size (0)
+		{ resize (n); }
+
+	iterator       begin ()       { return iterator (_v.begin (), 0); }
+	const_iterator begin () const { return const_iterator (_v.begin (), 0); }
+	iterator       end ()         { return begin () + _size; }
+	const_iterator end () const   { return begin () + _size; }
+
+	word_iterator       word_begin ()       { return _v.begin (); }
+	const_word_iterator word_begin () const { return _v.begin (); }
+	word_iterator       word_end ()         { return _v.end (); }
+	const_word_iterator word_end () const   { return _v.end (); }
+
+	reference       operator [] (size_type n)
+		{ return reference (_v.begin () + (n >> WordTraits<word_type>::logof_size) * _Planes, n & WordTraits<word_type>::pos_mask); }
+	const_reference operator [] (size_type n) const
+		{ return const_reference (_v.begin () + (n >> WordTraits<word_type>::logof_size) * _Planes, n & WordTraits<word_type>::pos_mask); }
+
+	/** Resize the vector
+	 *
+	 * New entries are zero. When the vector shrinks, the entries
+	 * beyond the new size are cleared so that the last block is
+	 * again zero beyond the size.
+	 */
+	void resize (size_type n)
+	{
+		size_t blocks = (n + WordTraits<word_type>::bits - 1) >> WordTraits<word_type>::logof_size;
+
+		_v.resize (blocks * _Planes, 0);
+		_size = n;
+
+		if (n & WordTraits<word_type>::pos_mask) {
+			word_type mask = Endianness::mask_left (n & WordTraits<word_type>::pos_mask);
+
+			for (word_iterator i = _v.end () - _Planes; i != _v.end (); ++i)
+				*i &= mask;
+		}
+	}
+
+	void clear () { _v.clear (); _size = 0; }
+
+	size_type size () const { return _size; }
+	bool empty () const { return _size == 0; }
+
+	/// Number of words, including all planes of all blocks
+	size_type word_size () const { return _v.size (); }
+
+	bool operator == (const SlicedVector &v) const
+		{ return _size == v._size && _v == v._v; }
+
+    protected:
+
+	std::vector<word_type> _v;
+	size_t                 _size;
+};
+
+} // namespace LELA
+
+#endif // __LELA_VECTOR_SLICED_VECTOR_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
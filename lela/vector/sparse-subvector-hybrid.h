@@ -56,23 +56,63 @@ class SparseSubvector<Vector, VectorRepresentationTypes::Hybrid01>
 	~SparseSubvector () {}
 
 	inline const_iterator begin () const
-		{ return const_iterator (*this, _begin); }
+		{ return const_iterator (*this, _begin, true); }
 	inline const_iterator end   () const
-		{ return const_iterator (*this, _end_marker); }
+		{ return const_iterator (*this, _end, false); }
 
 	inline size_t         size  () const { return _end_marker - _begin; }
 	inline bool           empty () const { return _end_marker == _begin; }
 
 	inline value_type     front () const { return *(begin ()); }
 
+	/** @name Word-level access
+	 *
+	 * These give the words of the underlying vector which the
+	 * subvector covers, so that an operation may combine them
+	 * with the words of another vector itself rather than going
+	 * through const_iterator. Word i of the subvector is made of
+	 * the words parent_offset () + i and parent_offset () + i + 1
+	 * of the underlying vector, shifted by shift ().
+	 */
+	//@{
+
+	/// First entry of the underlying vector covered by the subvector
+	inline typename Vector::const_iterator parent_begin () const { return _begin; }
+
+	/// Entry of the underlying vector after the last one covered by the subvector
+	inline typename Vector::const_iterator parent_end () const { return _end; }
+
+	/// Index of the word of the underlying vector in which the subvector starts
+	inline size_t parent_offset () const { return _start >> WordTraits<word_type>::logof_size; }
+
+	/// Position of the start of the subvector in its first word
+	inline size_t shift () const { return _shift; }
+
+	//@}
+
     private:
 	size_t _start, _finish;
 	typename Vector::const_iterator _begin, _end, _end_marker;
 	bool _end_is_end;
 
+	// Computed once for all iterators: the shift of the words, the
+	// number of words of the subvector, and the mask for its last word
+	size_t _shift, _words;
+	word_type _tail_mask;
+
 	void set_start_end (typename Vector::const_iterator begin, typename Vector::const_iterator end);
 
     public:
+	/** Iterator over the words of the subvector
+	 *
+	 * Each stored word of the underlying vector contributes to at
+	 * most two words of the subvector: the one it starts, together
+	 * with the following stored word if that is adjacent, and the
+	 * one before, if the word before it was not stored. The
+	 * iterator steps through these in order and computes each
+	 * shifted word once when it moves there, so that dereferencing
+	 * it is free.
+	 */
 	class const_iterator
 	{
 	public:
@@ -102,25 +142,9 @@ class SparseSubvector<Vector, VectorRepresentationTypes::Hybrid01>
 		typedef const_reference reference;
 
 		const_iterator () {}
-		const_iterator (const container_type &v, const typename Vector::const_iterator &pos)
-			: _v (&v), _pos (pos), _ref_first_valid (false), _ref_second_valid (false), _start (true)
-			{}
-
-		const_iterator (const const_iterator &i)
-			: _v (i._v), _pos (i._pos),
-			  _ref (i._ref), _ref_first_valid (i._ref_first_valid), _ref_second_valid (i._ref_second_valid), _start (i._start) {}
-
-		const_iterator &operator = (const const_iterator &i)
-		{
-			_v = reinterpret_cast<const container_type *> (i._v);
-			_pos = i._pos;
-			_ref.first = i._ref.first;
-			_ref.second = i._ref.second;
-			_ref_first_valid = i._ref_first_valid;
-			_ref_second_valid = i._ref_second_valid;
-			_start = i._start;
-			return *this;
-		}
+		const_iterator (const container_type &v, const typename Vector::const_iterator &pos, bool high)
+			: _v (&v), _pos (pos), _high (high)
+			{ settle (); }
 
 		const_iterator &operator ++ ();
 
@@ -131,29 +155,35 @@ class SparseSubvector<Vector, VectorRepresentationTypes::Hybrid01>
 			return tmp;
 		}
 
-		difference_type operator - (const_iterator &i) const 
+		difference_type operator - (const const_iterator &i) const 
 			{ return _pos - i._pos; }
 
-		const const_reference &operator * ()
-			{ update_ref (); return _ref; }
+		const const_reference &operator * () const
+			{ return _ref; }
 
-		const const_reference *operator -> ()
-			{ update_ref (); return &_ref; }
+		const const_reference *operator -> () const
+			{ return &_ref; }
 
 		bool operator == (const const_iterator &c) const 
-			{ return (_pos == c._pos); }
+			{ return _pos == c._pos && _high == c._high; }
 
-		bool operator != (const const_iterator &c);
+		bool operator != (const const_iterator &c) const
+			{ return _pos != c._pos || _high != c._high; }
 
 	private:
 		const container_type *_v;
+
+		// Stored word of the underlying vector from which the
+		// current word comes, and whether the current word is
+		// the one before the word which it starts
 		typename Vector::const_iterator _pos;
+		bool _high;
+
 		const_reference _ref;
-		bool _ref_first_valid;
-		bool _ref_second_valid;
-		bool _start;
 
-		void update_ref ();
+		// Move forward to the next position which yields a
+		// word, or to the end, and compute that word
+		void settle ();
 	};
 }; // template <class Vector> class SparseSubvector<Vector, Hybrid01>
 
@@ -29,97 +29,85 @@ void SparseSubvector<Vector, VectorRepresentationTypes::Hybrid01>::set_start_end
 		_end_marker = _end - 1;
 	else
 		_end_marker = _end;
+
+	_shift = _start & WordTraits<word_type>::pos_mask;
+	_words = (_finish - _start + WordTraits<word_type>::bits - 1) >> WordTraits<word_type>::logof_size;
+
+	if ((_finish - _start) & WordTraits<word_type>::pos_mask)
+		_tail_mask = Endianness::mask_left ((_finish - _start) & WordTraits<word_type>::pos_mask);
+	else
+		_tail_mask = ~word_type (0);
 }
 
 template <class Vector>
 typename SparseSubvector<Vector, VectorRepresentationTypes::Hybrid01>::const_iterator &SparseSubvector<Vector, VectorRepresentationTypes::Hybrid01>::const_iterator::operator ++ ()
 {
-	size_t virtual_index = (static_cast<size_t> (_ref.first) << WordTraits<word_type>::logof_size) + _v->_start;
-	size_t col_index = static_cast<size_t> (_pos->first) << WordTraits<word_type>::logof_size;
-
-	if (virtual_index < col_index) {
-		++_ref.first;
-		_ref_second_valid = false;
-	} else {
+	if (_high)
+		_high = false;
+	else {
+		index_type c = _pos->first;
 		++_pos;
-		_ref_first_valid = false;
-		_ref_second_valid = false;
+
+		// The next stored word also contributes to the word before
+		// it unless that was already yielded together with this one
+		_high = !(_pos != _v->_end && _pos->first == c + 1);
 	}
 
+	settle ();
+
 	return *this;
 }
 
 template <class Vector>
-bool SparseSubvector<Vector, VectorRepresentationTypes::Hybrid01>::const_iterator::operator != (const const_iterator &c)
+void SparseSubvector<Vector, VectorRepresentationTypes::Hybrid01>::const_iterator::settle ()
 {
-	if (c._pos == _v->_end_marker) {
-		if (_pos == _v->_end)
-			return false;
-		else {
-			update_ref ();
-			size_t virtual_index = (static_cast<size_t> (_ref.first) << WordTraits<word_type>::logof_size) + _v->_start;
-			return virtual_index < _v->_finish;
-		}
+	if (_pos == _v->_end) {
+		_high = false;
+		return;
 	}
-	else
-		return _pos != c._pos;
-}
 
-template <class Vector>
-void SparseSubvector<Vector, VectorRepresentationTypes::Hybrid01>::const_iterator::update_ref ()
-{
-	size_t shift, virtual_index, col_index;
+	const size_t c = _pos->first, s0 = _v->parent_offset ();
+	typename Endianness::word_pair w;
 
-	if (!_ref_first_valid || !_ref_second_valid) {
-		shift = _v->_start & WordTraits<word_type>::pos_mask;
+	if (_high) {
+		if (_v->_shift != 0 && c > s0) {
+			_ref.first = c - s0 - 1;
 
-		virtual_index = (static_cast<size_t> (_ref.first) << WordTraits<word_type>::logof_size) + _v->_start;
-		col_index = static_cast<size_t> (_pos->first) << WordTraits<word_type>::logof_size;
-	}
+			w.parts.low = 0;
+			w.parts.high = _pos->second;
+			w.full = Endianness::shift_left (w.full, _v->_shift);
+			_ref.second = w.parts.low;
+
+			if (static_cast<size_t> (_ref.first) + 1 == _v->_words)
+				_ref.second &= _v->_tail_mask;
 
-	if (!_ref_first_valid) {
-		if (_start) {
-			if (col_index < _v->_start)
-				_ref.first = 0;
-			else
-				_ref.first = (col_index - _v->_start) >> WordTraits<word_type>::logof_size;
-			
-			_start = false;
+			return;
 		}
-		else if (virtual_index + WordTraits<word_type>::bits < col_index)
-			_ref.first = (col_index - _v->_start) >> WordTraits<word_type>::logof_size;
-		else
-			++_ref.first;
 
-		virtual_index = (static_cast<size_t> (_ref.first) << WordTraits<word_type>::logof_size) + _v->_start;
+		_high = false;
+	}
 
-		_ref_first_valid = true;
+	// No later stored word can contribute to the subvector
+	if (c - s0 >= _v->_words) {
+		_pos = _v->_end;
+		return;
 	}
 
-	if (!_ref_second_valid) {
-		typename Endianness::word_pair w;
+	_ref.first = c - s0;
 
-		if (virtual_index < col_index) {
-			w.parts.low = 0ULL;
-			w.parts.high = _pos->second;
-		}
-		else if ((_pos + 1)->first > _pos->first + 1) {
-			w.parts.low = _pos->second;
-			w.parts.high = 0ULL;
-		}
-		else {
-			w.parts.low = _pos->second;
-			w.parts.high = (_pos + 1)->second;
-		}
+	if (_v->_shift == 0)
+		_ref.second = _pos->second;
+	else {
+		typename Vector::const_iterator next = _pos + 1;
 
-		w.full = Endianness::shift_left (w.full, shift);
+		w.parts.low = _pos->second;
+		w.parts.high = (next != _v->_end && static_cast<size_t> (next->first) == c + 1) ? next->second : word_type (0);
+		w.full = Endianness::shift_left (w.full, _v->_shift);
 		_ref.second = w.parts.low;
-
-		if ((static_cast<size_t> (_ref.first) + 1) << WordTraits<word_type>::logof_size > _v->_finish - _v->_start)
-			_ref.second &= Endianness::mask_left ((_v->_finish - _v->_start) & WordTraits<word_type>::pos_mask);
-
-		_ref_second_valid = true;
 	}
+
+	if (static_cast<size_t> (_ref.first) + 1 == _v->_words)
+		_ref.second &= _v->_tail_mask;
 }
 
 } // namespace LELA
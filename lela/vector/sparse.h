@@ -16,6 +16,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <iterator>
 #include <cstddef>
 
 #include "lela/util/property.h"
@@ -69,7 +70,7 @@ class SparseVectorIterator
 public:
 	typedef std::random_access_iterator_tag iterator_category;
 	typedef SparseVectorReference<IndexIterator, ElementIterator> reference;
-	typedef std::pair<typename IndexIterator::value_type, typename ElementIterator::value_type> value_type;
+	typedef std::pair<typename std::iterator_traits<IndexIterator>::value_type, typename std::iterator_traits<ElementIterator>::value_type> value_type;
 	typedef const SparseVectorReference<ConstIndexIterator, ConstElementIterator> const_reference;
 	typedef reference *pointer;
 	typedef const_reference *const_pointer;
@@ -205,9 +206,12 @@ class ConstSparseVector
 public:
 	typedef VectorRepresentationTypes::Sparse RepresentationType; 
 	typedef VectorStorageTypes::Transformed StorageType;
-	typedef ConstSparseVector ContainerType;
-	typedef SparseSubvector<ConstSparseVector, VectorRepresentationTypes::Sparse> ConstSubvectorType;
-	typedef SparseSubvector<ConstSparseVector, VectorRepresentationTypes::Sparse> ConstAlignedSubvectorType;
+	typedef SparseVector<typename std::iterator_traits<ElementIterator>::value_type,
+			     std::vector<typename std::iterator_traits<IndexIterator>::value_type> > ContainerType;
+	typedef SparseSubvector<const ConstSparseVector, VectorRepresentationTypes::Sparse> SubvectorType;
+	typedef SparseSubvector<const ConstSparseVector, VectorRepresentationTypes::Sparse> ConstSubvectorType;
+	typedef SparseSubvector<const ConstSparseVector, VectorRepresentationTypes::Sparse> AlignedSubvectorType;
+	typedef SparseSubvector<const ConstSparseVector, VectorRepresentationTypes::Sparse> ConstAlignedSubvectorType;
 	static const int align = 1;
 
 	typedef SparseVectorIterator<IndexIterator, ElementIterator, ConstIndexIterator, ConstElementIterator> iterator;
@@ -339,6 +343,15 @@ public:
 	typedef size_t size_type;
 
 	SparseVector () {}
+
+	/** Construct an empty vector whose storage comes from the given allocator
+	 *
+	 * The allocator is converted to those of both the index- and
+	 * the element-vector, so this works with any allocator which
+	 * converts between value-types, such as @ref PoolAllocator.
+	 */
+	explicit SparseVector (const typename ElementVector::allocator_type &a)
+		: _idx (a), _elt (a) {}
 		
 	template <class IV, class EV>
 	SparseVector (IV &iv, EV &ev)
@@ -33,7 +33,7 @@ namespace LELA
 /** \brief Vector-representation-types.
  *
  * The structures in this namespace identify the interface a vector
- * provides to LELA. There are in total five supported types.
+ * provides to LELA. There are in total six supported types.
  *
  * Over general rings there are two of vector-representations: dense
  * and sparse.
@@ -41,6 +41,9 @@ namespace LELA
  * Over GF2 there are three representation-types: dense, sparse, and
  * hybrid.
  *
+ * Over prime fields of characteristic less than 16 there is in
+ * addition a dense bit-sliced representation.
+ *
  * \ingroup vector
  */
 namespace VectorRepresentationTypes
@@ -134,6 +137,23 @@ namespace VectorRepresentationTypes
 	 * and that the vector e_i corresponds to the word with value 2^i.
 	 */
 	struct Hybrid01 : public Generic {};
+
+	/** Dense bit-sliced vector over a small prime field
+	 *
+	 * A dense bit-sliced vector stores the entries, which must be
+	 * less than 2^planes, in blocks of as many entries as a word
+	 * (of type word_type) has bits. Each block occupies planes
+	 * consecutive words, the k-th of which holds bit k of each entry
+	 * of the block, so that the entries are added and multiplied
+	 * with bitwise operations on whole words. The vector must define
+	 * the constant planes, the type Endianness, which gives the
+	 * position of an entry in its words as for dense 0-1 vectors, and
+	 * the methods word_begin and word_end, which iterate over all
+	 * words, including the last block. Entries in the last block
+	 * beyond the size of the vector must be zero. The class @ref
+	 * SlicedVector implements this interface.
+	 */
+	struct DenseSliced : public Generic {};
 };
 
 /** Vector storage-types
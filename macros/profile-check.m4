@@ -0,0 +1,23 @@
+# Check whether to build with profiling of activities
+
+dnl LB_CHECK_PROFILE
+dnl
+dnl Define ENABLE_PROFILE if profiling was requested
+
+AC_DEFUN([LB_CHECK_PROFILE],
+[
+AC_ARG_ENABLE(profile,[
+   --enable-profile       Count calls, time and memory allocated in the
+			  activities marked with LELA_PROFILE, see
+			  lela/util/profile.h. Default is no.
+],[],[enable_profile=no])
+
+AC_MSG_CHECKING([whether to enable profiling of activities])
+
+if test "$enable_profile" != no ; then
+    AC_MSG_RESULT([yes])
+    AC_DEFINE(ENABLE_PROFILE,1,[Define if activities marked with LELA_PROFILE should be profiled])
+else
+    AC_MSG_RESULT([no])
+fi
+])
@@ -0,0 +1,29 @@
+# Check for POSIX-threads
+
+dnl LB_CHECK_PTHREAD
+dnl
+dnl Test for POSIX-threads and define PTHREAD_LIBS and HAVE_PTHREAD
+
+AC_DEFUN([LB_CHECK_PTHREAD],
+[
+PTHREAD_LIBS=
+
+AC_ARG_WITH(pthread,[
+   --with-pthread=yes|no  Use POSIX-threads. This enables the parallel
+			  modules, which spread calculations over several
+			  processors. Default is yes when available.
+],[],[with_pthread=yes])
+
+if test "$with_pthread" != no ; then
+    AC_LANG_PUSH([C])
+    AC_CHECK_HEADER([pthread.h], [
+        AC_CHECK_LIB([pthread], [pthread_create], [
+            AC_DEFINE(HAVE_PTHREAD,1,[Define if POSIX-threads are available])
+            PTHREAD_LIBS="-lpthread"
+        ])
+    ])
+    AC_LANG_POP([C])
+fi
+
+AC_SUBST(PTHREAD_LIBS)
+])
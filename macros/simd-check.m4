@@ -0,0 +1,47 @@
+# Check for x86 vector-instructions
+
+dnl LB_CHECK_SIMD
+dnl
+dnl Test whether the compiler can build SSE4.1- and AVX2-kernels in
+dnl functions with a target-attribute and select between them at
+dnl runtime, and define HAVE_X86_SIMD if so
+
+AC_DEFUN([LB_CHECK_SIMD],
+[
+AC_ARG_WITH(simd,[
+   --with-simd=yes|no     Build the SSE4.1- and AVX2-kernels for
+			  arithmetic in Z/p, which are selected at runtime
+			  according to the processor. Default is yes when
+			  the compiler supports them.
+],[],[with_simd=yes])
+
+if test "$with_simd" != no ; then
+    AC_MSG_CHECKING([for SSE4.1- and AVX2-intrinsics with runtime dispatch])
+
+    AC_LINK_IFELSE([AC_LANG_PROGRAM([[
+#include <immintrin.h>
+
+__attribute__ ((target ("avx2"))) static int f_avx2 (int a)
+{
+	__m256i x = _mm256_set1_epi32 (a);
+	x = _mm256_min_epu32 (_mm256_mullo_epi32 (x, x), _mm256_mul_epu32 (x, x));
+	return _mm_cvtsi128_si32 (_mm256_castsi256_si128 (x));
+}
+
+__attribute__ ((target ("sse4.1"))) static int f_sse41 (int a)
+{
+	__m128i x = _mm_set1_epi32 (a);
+	x = _mm_min_epu32 (_mm_mullo_epi32 (x, x), _mm_mul_epu32 (x, x));
+	return _mm_cvtsi128_si32 (x);
+}
+]], [[
+	__builtin_cpu_init ();
+	return __builtin_cpu_supports ("avx2") ? f_avx2 (3) : f_sse41 (3);
+]])], [
+        AC_MSG_RESULT([yes])
+        AC_DEFINE(HAVE_X86_SIMD,1,[Define if SSE4.1- and AVX2-kernels can be built and selected at runtime])
+    ], [
+        AC_MSG_RESULT([no])
+    ])
+fi
+])